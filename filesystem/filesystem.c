@@ -71,12 +71,16 @@ const struct lfs_config watch_lfs_cfg = {
     .read_size = 16,
     .prog_size = NVMCTRL_PAGE_SIZE,
     .block_size = NVMCTRL_ROW_SIZE,
-    .block_count = NVMCTRL_RWWEE_PAGES / 4,
+    // the rows above these belong to watch_storage_region
+    .block_count = WATCH_STORAGE_REGION_FIRST_ROW,
     .cache_size = NVMCTRL_PAGE_SIZE,
     .lookahead_size = 16,
     .block_cycles = 100,
 };
 
+// free blocks the migrated filesystem needs beyond what the old one used, for copy-on-write
+#define FILESYSTEM_MIGRATION_SPARE_BLOCKS 2
+
 lfs_t eeprom_filesystem;
 static lfs_file_t file;
 static struct lfs_info info;
@@ -139,9 +143,106 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
     return 0;
 }
 
+// Firmware before the storage region gave littlefs every RWWEE row. A filesystem made then won't
+// mount with the smaller block count, so copy its files out, reformat, and put them back, rather
+// than lose everyone's settings. Files are kept in one buffer as: name (NUL-terminated), size, data.
+// Nothing on the watch makes directories, so a filesystem with one isn't ours to rearrange, and
+// one that wouldn't fit can't be. Returns true only once every file is back; on false the caller
+// formats, as it would on a first boot.
+static bool _filesystem_migrate_from_full_eeprom(void) {
+    struct lfs_config legacy_cfg = watch_lfs_cfg;
+    legacy_cfg.block_count = NVMCTRL_RWWEE_PAGES / 4;
+
+    if (lfs_mount(&eeprom_filesystem, &legacy_cfg) < 0) return false;
+
+    lfs_dir_t dir;
+    struct lfs_info entry;
+    uint32_t needed = 0;
+    uint16_t count = 0;
+    if (lfs_dir_open(&eeprom_filesystem, &dir, "/") < 0) goto fail_unmount;
+    while (lfs_dir_read(&eeprom_filesystem, &dir, &entry) > 0) {
+        if (entry.type == LFS_TYPE_DIR && strcmp(entry.name, ".") != 0 && strcmp(entry.name, "..") != 0) {
+            lfs_dir_close(&eeprom_filesystem, &dir);
+            goto fail_unmount;
+        }
+        if (entry.type != LFS_TYPE_REG) continue;
+        needed += strlen(entry.name) + 1 + sizeof(int32_t) + entry.size;
+        count++;
+    }
+    lfs_dir_close(&eeprom_filesystem, &dir);
+
+    // Everything has to fit the smaller filesystem, or there is nothing to gain by trying. Count
+    // blocks, not bytes: each file rounds up to whole blocks and the metadata pairs take their own.
+    // Traversal may visit a block twice, which only errs towards not migrating.
+    uint32_t used_blocks = 0;
+    if (lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &used_blocks) < 0) goto fail_unmount;
+    if (used_blocks + FILESYSTEM_MIGRATION_SPARE_BLOCKS > WATCH_STORAGE_REGION_FIRST_ROW) goto fail_unmount;
+    char *buf = malloc(needed ? needed : 1);
+    if (buf == NULL) goto fail_unmount;
+
+    char *pos = buf;
+    if (lfs_dir_open(&eeprom_filesystem, &dir, "/") < 0) goto fail_free;
+    while (lfs_dir_read(&eeprom_filesystem, &dir, &entry) > 0) {
+        if (entry.type != LFS_TYPE_REG) continue;
+        char *name = pos;
+        int32_t size = (int32_t)entry.size;
+        strcpy(name, entry.name);
+        pos += strlen(name) + 1;
+        memcpy(pos, &size, sizeof(size));
+        pos += sizeof(size);
+        if (size > 0 && !filesystem_read_file(name, pos, size)) {
+            lfs_dir_close(&eeprom_filesystem, &dir);
+            goto fail_free;
+        }
+        pos += size;
+    }
+    lfs_dir_close(&eeprom_filesystem, &dir);
+    lfs_unmount(&eeprom_filesystem);
+
+    printf("Moving %u files to the new filesystem layout...\r\n", count);
+    if (lfs_format(&eeprom_filesystem, &watch_lfs_cfg) < 0 ||
+        lfs_mount(&eeprom_filesystem, &watch_lfs_cfg) < 0) {
+        free(buf);
+        return false;
+    }
+
+    pos = buf;
+    for (uint16_t i = 0; i < count; i++) {
+        char *name = pos;
+        int32_t size;
+        pos += strlen(name) + 1;
+        memcpy(&size, pos, sizeof(size));
+        pos += sizeof(size);
+        if (lfs_file_open(&eeprom_filesystem, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) < 0) {
+            printf("Couldn't move %s\r\n", name);
+            goto fail_free;
+        }
+        bool written = lfs_file_write(&eeprom_filesystem, &file, pos, size) == size;
+        if (lfs_file_close(&eeprom_filesystem, &file) < 0 || !written) {
+            printf("Couldn't move %s\r\n", name);
+            goto fail_free;
+        }
+        pos += size;
+    }
+    free(buf);
+
+    return true;
+
+fail_free:
+    free(buf);
+fail_unmount:
+    lfs_unmount(&eeprom_filesystem);
+    return false;
+}
+
 bool filesystem_init(void) {
     int err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
 
+    if (err < 0 && _filesystem_migrate_from_full_eeprom()) {
+        printf("Filesystem mounted with %ld bytes free.\r\n", filesystem_get_free_space());
+        return true;
+    }
+
     // reformat if we can't mount the filesystem
     // this should only happen on the first boot
     if (err < 0) {
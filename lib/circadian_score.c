@@ -19,7 +19,6 @@
 #include <string.h>
 #include <stdlib.h>
 
-#define FLASH_ROW_CIRCADIAN 30
 #define MINUTES_PER_DAY 1440
 
 // Component weights (scaled to 100)
@@ -35,6 +34,18 @@
 #define DURATION_SHORT_PENALTY 360  // <6h = full penalty
 #define DURATION_LONG_PENALTY 540   // >9h = full penalty
 
+static watch_storage_log_t circadian_log;
+static bool circadian_log_open = false;
+
+// Opening scans the whole log, so saves reuse the last open; loads rescan.
+static bool circadian_log_ready(bool rescan) {
+    if (rescan || !circadian_log_open) {
+        circadian_log_open = watch_storage_log_open(&circadian_log, STORAGE_LOG_CIRCADIAN,
+                                                    sizeof(circadian_data_t), STORAGE_LOG_CIRCADIAN_ROWS);
+    }
+    return circadian_log_open;
+}
+
 uint8_t circadian_score_calculate(const circadian_data_t *data) {
     circadian_score_components_t components;
     circadian_score_calculate_components(data, &components);
@@ -216,9 +227,7 @@ void circadian_data_add_night(circadian_data_t *data,
 }
 
 bool circadian_data_load_from_flash(circadian_data_t *data) {
-    // Read from flash row 30
-    bool ok = watch_storage_read(FLASH_ROW_CIRCADIAN, 0,
-                                 (uint8_t*)data, sizeof(circadian_data_t));
+    bool ok = circadian_log_ready(true) && watch_storage_log_read(&circadian_log, 0, data);
 
     // Validate: check return value and write_index range
     if (!ok || data->write_index >= 7) {
@@ -273,8 +282,8 @@ bool circadian_data_load_from_flash(circadian_data_t *data) {
 }
 
 bool circadian_data_save_to_flash(const circadian_data_t *data) {
-    return watch_storage_write(FLASH_ROW_CIRCADIAN, 0, 
-                                (const uint8_t*)data, sizeof(circadian_data_t));
+    if (!circadian_log_ready(false)) return false;
+    return watch_storage_log_append(&circadian_log, data);
 }
 
 uint16_t circadian_data_export_binary(const circadian_data_t *data, uint8_t *buffer, uint16_t buffer_size) {
@@ -90,7 +90,11 @@ uint8_t circadian_score_calculate_duration(uint16_t duration_min);
 // Used by sleep_score_face for quick feedback
 uint8_t circadian_score_calculate_sleep_score(const circadian_sleep_night_t *night);
 
-// Load/save from flash (row 30)
+#define STORAGE_LOG_CIRCADIAN "circadian"
+#define STORAGE_LOG_CIRCADIAN_ROWS 3        // one snapshot per row
+
+// Load/save the newest snapshot in the "circadian" flash log (see watch_storage_log.h).
+// Loading rescans the log, so call it at boot or face setup rather than every minute.
 bool circadian_data_load_from_flash(circadian_data_t *data);
 bool circadian_data_save_to_flash(const circadian_data_t *data);
 
@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Lunar phase service. See lunar.h.
+ */
+
+#include "lunar.h"
+#include "watch_utility.h"
+
+// (1 - cos θ) / 2 in per mille, for θ = 0°, 11.25°, ..., 180°. Interpolated
+// linearly; worst-case error ~0.3%.
+static const uint16_t illumination_half[17] = {
+    0, 10, 38, 84, 146, 222, 309, 402, 500, 598, 691, 778, 854, 916, 962, 990, 1000
+};
+
+// Where each phase name ends, in seconds since new moon (1, 6.38, 8.38, 13.77,
+// 15.77, 21.15, 23.15 and 28.53 days). Past the last one it is new again.
+static const uint32_t phase_ends[LUNAR_WANING_CRESCENT + 1] = {
+    86400, 551461, 724261, 1189321, 1362121, 1827182, 1999982, 2465043
+};
+
+static lunar_phase_t today;
+static bool today_valid;
+static uint16_t today_year;
+static uint8_t today_month;
+static uint8_t today_day;
+static int32_t today_utc_offset;
+
+void lunar_compute(uint32_t unix_time, lunar_phase_t *out) {
+    uint32_t cycle;
+    if (unix_time >= LUNAR_NEW_MOON_EPOCH) {
+        cycle = (unix_time - LUNAR_NEW_MOON_EPOCH) % LUNAR_SYNODIC_SECONDS;
+    } else {
+        cycle = LUNAR_SYNODIC_SECONDS - 1 - (LUNAR_NEW_MOON_EPOCH - 1 - unix_time) % LUNAR_SYNODIC_SECONDS;
+    }
+
+    // cycle < 2^22, so cycle * 2^16 / synodic is done as (cycle << 9) / (synodic >> 7).
+    uint32_t fraction = (cycle << 9) / (LUNAR_SYNODIC_SECONDS >> 7);
+    if (fraction > 0xffff) fraction = 0xffff;
+
+    // Lit fraction is symmetric about full moon: fold the waning half onto the waxing one.
+    uint16_t half = (fraction < 32768) ? fraction : 65535 - fraction;  // 0-32767
+    uint8_t segment = half >> 11;                                     // 0-15
+    uint16_t within = half & 0x7ff;
+    uint16_t per_mille = illumination_half[segment] +
+                         (((uint32_t)(illumination_half[segment + 1] - illumination_half[segment]) * within) >> 11);
+
+    uint8_t name = 0;
+    while (name <= LUNAR_WANING_CRESCENT && cycle >= phase_ends[name]) name++;
+    if (name > LUNAR_WANING_CRESCENT) name = LUNAR_NEW;
+
+    out->cycle_seconds = cycle;
+    out->fraction = (uint16_t)fraction;
+    out->age_days = cycle / 86400;
+    out->illumination = (per_mille + 5) / 10;
+    out->name = (lunar_phase_name_t)name;
+}
+
+void lunar_update_today(uint16_t year, uint8_t month, uint8_t day, int32_t utc_offset) {
+    if (today_valid && year == today_year && month == today_month && day == today_day &&
+        utc_offset == today_utc_offset) {
+        return;
+    }
+
+    lunar_compute(watch_utility_convert_to_unix_time(year, month, day, 12, 0, 0, utc_offset), &today);
+    today_year = year;
+    today_month = month;
+    today_day = day;
+    today_utc_offset = utc_offset;
+    today_valid = true;
+}
+
+const lunar_phase_t* lunar_get_today(void) {
+    return today_valid ? &today : NULL;
+}
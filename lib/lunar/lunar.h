@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Lunar phase service
+ *
+ * Moon age, position in the synodic month and illuminated fraction, in
+ * integer math: seconds since a known new moon (2000-01-06 18:14 UTC)
+ * modulo the mean synodic month, and a half-cycle table for the lit
+ * fraction. Good to within a few hours of the true phase, which is all
+ * the moon phase face and the metrics need, without double-precision
+ * fmod pulling in libm.
+ *
+ * Two ways in, as with lib/solar:
+ * - lunar_compute() is a pure function of a unix time (the moon phase face
+ *   uses it to step through days).
+ * - lunar_update_today() / lunar_get_today() keep one result per local
+ *   date, worked out at local noon. The calendar context refreshes it when
+ *   the date changes; the comfort and EM metrics read it from there.
+ */
+
+#ifndef LUNAR_H_
+#define LUNAR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LUNAR_SYNODIC_SECONDS 2551443UL    // 29.530588 days
+#define LUNAR_NEW_MOON_EPOCH 947182440UL   // 2000-01-06 18:14:00 UTC
+
+// Phase names, as the moon phase face shows them. New, quarter and full
+// each get two days centred on the event; the crescents and gibbous
+// phases take the rest.
+typedef enum {
+    LUNAR_NEW = 0,
+    LUNAR_WAXING_CRESCENT,
+    LUNAR_FIRST_QUARTER,
+    LUNAR_WAXING_GIBBOUS,
+    LUNAR_FULL,
+    LUNAR_WANING_GIBBOUS,
+    LUNAR_LAST_QUARTER,
+    LUNAR_WANING_CRESCENT,
+} lunar_phase_name_t;
+
+typedef struct {
+    uint32_t cycle_seconds;     // Seconds since the last new moon (0 to LUNAR_SYNODIC_SECONDS - 1)
+    uint16_t fraction;          // Position in the synodic month, 65536 per cycle (32768 = full)
+    uint8_t age_days;           // Whole days since the last new moon (0-29)
+    uint8_t illumination;       // Illuminated fraction of the disc, percent (0-100)
+    lunar_phase_name_t name;
+} lunar_phase_t;
+
+/**
+ * Compute the moon's phase at a moment.
+ *
+ * @param unix_time Seconds since 1970-01-01 00:00 UTC
+ * @param out Result
+ */
+void lunar_compute(uint32_t unix_time, lunar_phase_t *out);
+
+/**
+ * Refresh the cached result for a local date. Cheap when nothing changed.
+ *
+ * @param year Full year (e.g. 2026)
+ * @param month 1-12
+ * @param day 1-31
+ * @param utc_offset Seconds to add to UTC for local time
+ */
+void lunar_update_today(uint16_t year, uint8_t month, uint8_t day, int32_t utc_offset);
+
+/**
+ * @return The phase at local noon of the date last passed to
+ *         lunar_update_today(), or NULL before the first update.
+ */
+const lunar_phase_t* lunar_get_today(void);
+
+#endif // LUNAR_H_
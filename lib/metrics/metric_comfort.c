@@ -26,50 +26,7 @@
 
 #include "metric_comfort.h"
 #include "phase_engine.h"
-
-// Conway's lunar approximation (±1 day accuracy)
-// Returns moon age in days (0-29)
-static uint8_t lunar_age_conway(uint16_t year, uint8_t month, uint8_t day) {
-    // Conway's formula for moon age
-    // r = year % 100
-    // r = r % 19
-    // if (month < 3) { month += 12; year -= 1; }
-    // age = ((r * 11) % 30 + month * 2 + day) % 30
-    
-    uint16_t r = year % 100;
-    r = r % 19;
-    
-    // Adjust for Jan/Feb (treat as months 13/14 of previous year)
-    uint8_t adj_month = month;
-    if (month < 3) {
-        adj_month += 12;
-        // Don't modify year for calculation - only affects r
-    }
-    
-    // Conway's magic formula
-    uint8_t age = ((r * 11) % 30 + adj_month * 2 + day) % 30;
-    
-    return age;
-}
-
-// Map lunar phase (0-29 days) to comfort modifier (0-100)
-// Full moon (day 15) = 100 (peak comfort)
-// New moon (day 0/29) = 0 (lowest comfort)
-// Linear interpolation between
-static uint8_t lunar_comfort_score(uint8_t lunar_age) {
-    // Map 0-29 to comfort score
-    // Full moon at day 15 → 100
-    // New moon at day 0/29 → 0
-    
-    if (lunar_age <= 15) {
-        // Waxing: 0→15 maps to 0→100
-        return (lunar_age * 100) / 15;
-    } else {
-        // Waning: 16→29 maps to 93→0
-        uint8_t days_past_full = lunar_age - 15;  // 1-14
-        return 100 - ((days_past_full * 100) / 15);
-    }
-}
+#include "calendar_context.h"
 
 // Safe absolute value wrapper to handle INT16_MIN edge case
 static inline int16_t safe_abs16(int16_t x) {
@@ -83,15 +40,13 @@ static inline uint16_t min16(uint16_t a, uint16_t b) {
 
 uint8_t metric_comfort_compute(int16_t temp_c10,
                                 uint16_t light_lux,
-                                uint8_t hour,
-                                const homebase_entry_t *baseline,
-                                uint16_t year,
-                                uint8_t month,
-                                uint8_t day) {
-    if (!baseline) {
-        // No baseline data - return neutral score
+                                const calendar_context_t *cal) {
+    if (!cal) {
+        // No calendar (and so no baseline) - return neutral score
         return 50;
     }
+    const homebase_entry_t *baseline = &cal->homebase;
+    uint8_t hour = cal->hour;
     
     // Temp comfort (48%): deviation from seasonal baseline
     // Use int32_t to prevent overflow in subtraction
@@ -108,15 +63,22 @@ uint8_t metric_comfort_compute(int16_t temp_c10,
     }
     
     // Light comfort (32%): expected vs actual for hour
-    // Use homebase daylight data to determine sunrise/sunset
-    // Approximate sunrise: 12:00 - (daylight_min / 120) hours
-    // Approximate sunset: 12:00 + (daylight_min / 120) hours
-    uint16_t daylight_min = baseline->expected_daylight_min;
-    uint8_t sunrise_hour = 12 - (daylight_min / 120);
-    uint8_t sunset_hour = 12 + (daylight_min / 120);
+    // Day/night from today's sunrise and sunset (checked at half past the
+    // hour) once the wearer's location is known. Until then, use homebase
+    // daylight data: sunrise 12:00 - (daylight_min / 120) hours, sunset
+    // 12:00 + (daylight_min / 120) hours, sunset hour included.
+    bool is_daytime;
+    if (cal->solar != NULL) {
+        is_daytime = solar_is_daylight(cal->solar, hour * 60 + 30);
+    } else {
+        uint16_t daylight_min = baseline->expected_daylight_min;
+        uint8_t sunrise_hour = 12 - (daylight_min / 120);
+        uint8_t sunset_hour = 12 + (daylight_min / 120);
+        is_daytime = (hour >= sunrise_hour && hour <= sunset_hour);
+    }
     
     uint8_t light_comfort;
-    if (hour >= sunrise_hour && hour <= sunset_hour) {
+    if (is_daytime) {
         // Daytime: expect bright light (>= 200 lux)
         if (light_lux >= 200) {
             light_comfort = 100;
@@ -137,9 +99,8 @@ uint8_t metric_comfort_compute(int16_t temp_c10,
         }
     }
     
-    // Lunar comfort (20%): Conway approximation
-    uint8_t lunar_age = lunar_age_conway(year, month, day);
-    uint8_t lunar_comfort = lunar_comfort_score(lunar_age);
+    // Lunar comfort (20%): illuminated fraction, 0 at new moon to 100 at full
+    uint8_t lunar_comfort = cal->lunar.illumination;
     
     // Blend: 48% temp + 32% light + 20% lunar
     // Scale to avoid overflow: use (a*48 + b*32 + c*20) / 100
@@ -25,7 +25,6 @@
 #ifdef PHASE_ENGINE_ENABLED
 
 #include "metric_em.h"
-#include <stdlib.h>  // for abs()
 
 /*
  * Integer cosine lookup table (24 entries, one per hour)
@@ -60,7 +59,7 @@ static const int16_t cosine_lut_24[24] = {
     966    // 23:00
 };
 
-uint8_t metric_em_compute(uint8_t hour, uint16_t day_of_year, uint16_t activity_variance) {
+uint8_t metric_em_compute(uint8_t hour, uint8_t lunar_illumination, uint16_t activity_variance) {
     // Clamp hour to valid range (0-23)
     if (hour >= 24) hour = 23;
     
@@ -71,12 +70,8 @@ uint8_t metric_em_compute(uint8_t hour, uint16_t day_of_year, uint16_t activity_
     uint8_t circ_score = (uint8_t)((circ_raw + 1000) / 20);  // Map [-1000, +1000] → [0, 100]
     
     // Lunar component (20%)
-    // 29-day cycle approximation, peaks at half-cycle (day 14.5)
-    // Formula: ((day_of_year * 1000) / 29) % 1000
-    // This gives a sawtooth 0-999, we want it to peak at 500
-    uint32_t lunar_phase = ((uint32_t)day_of_year * 1000UL / 29) % 1000;
-    int16_t lunar_deviation = abs((int16_t)lunar_phase - 500);  // Distance from peak
-    uint8_t lunar_score = (uint8_t)(100 - (lunar_deviation / 5));  // Peak at 500 → 100, edges → 0
+    // Illuminated fraction from the lunar service: new moon → 0, full moon → 100
+    uint8_t lunar_score = (lunar_illumination > 100) ? 100 : lunar_illumination;
     
     // Variance component (40%)
     // Map activity variance (0-1000) to score (0-100)
@@ -34,7 +34,7 @@
  * 
  * Algorithm: Three-component blend
  * - Circadian (40%): Daily cycle using cosine curve, peak at hour 14 (2 PM)
- * - Lunar (20%): 29-day cycle approximation, peaks at day 14.5
+ * - Lunar (20%): Illuminated fraction of the moon, peaks at full moon
  * - Variance (40%): Activity variance vs zone expectation (placeholder in Phase 3)
  * 
  * Output: 0 (low mood) to 100 (elevated mood)
@@ -46,11 +46,11 @@
  * Compute Emotional/Mood score.
  * 
  * @param hour Current hour (0-23)
- * @param day_of_year Current day (1-365)
- * @param activity_variance Activity variance over 15 min (0-1000, placeholder)
+ * @param lunar_illumination Moon's illuminated fraction, percent (0-100, lunar_phase_t)
+ * @param activity_variance Motion variance over about 5 min, mg² (sensors, SENSOR_MOTION_SHORT; full scale 1000)
  * @return EM score (0-100)
  */
-uint8_t metric_em_compute(uint8_t hour, uint16_t day_of_year, uint16_t activity_variance);
+uint8_t metric_em_compute(uint8_t hour, uint8_t lunar_illumination, uint16_t activity_variance);
 
 #endif // PHASE_ENGINE_ENABLED
 
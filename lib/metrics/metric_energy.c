@@ -63,10 +63,12 @@ static const int16_t cosine_lut_24[24] = {
 #define ENERGY_ACTIVITY_DIVISOR 50
 #define ENERGY_MAX_BONUS 20
 
-uint8_t metric_energy_compute(uint16_t phase_score, uint8_t sd_score, uint16_t recent_activity,
+uint8_t metric_energy_compute(uint16_t phase_score, uint8_t sd_score, uint8_t jl_score, uint16_t recent_activity,
                               uint8_t hour, bool has_accelerometer) {
-    // Base formula: phase_score - (sd_score / 3)
-    int16_t energy = (int16_t)phase_score - (sd_score / 3);
+    // Base formula: phase_score - (sd_score / 3) - jet lag penalty
+    // Jet lag costs up to 20 points while the body clock catches up
+    if (jl_score > 100) jl_score = 100;
+    int16_t energy = (int16_t)phase_score - (sd_score / 3) - ((100 - jl_score) / 5);
     
     if (has_accelerometer) {
         // Normal mode: Add activity bonus
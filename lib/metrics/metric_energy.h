@@ -33,10 +33,10 @@
 /**
  * Energy Metric (Derived)
  * 
- * Algorithm: Computed from phase score, sleep debt, and activity
+ * Algorithm: Computed from phase score, sleep debt, jet lag, and activity
  * 
  * Base formula:
- *   energy = phase_score - (sd_score / 3)
+ *   energy = phase_score - (sd_score / 3) - ((100 - jl_score) / 5)
  * 
  * Normal mode (accelerometer available):
  *   + Activity bonus: min(20, recent_activity / 50)
@@ -54,12 +54,13 @@
  * 
  * @param phase_score Current phase score from phase_engine (0-100)
  * @param sd_score Current Sleep Debt score (0-100)
+ * @param jl_score Current Jet Lag score (0-100, 100 = aligned)
  * @param recent_activity Recent activity level (0-1000+)
  * @param hour Current hour (0-23, used for fallback mode)
  * @param has_accelerometer True if LIS2DW accelerometer is available
  * @return Energy score (0-100)
  */
-uint8_t metric_energy_compute(uint16_t phase_score, uint8_t sd_score, uint16_t recent_activity,
+uint8_t metric_energy_compute(uint16_t phase_score, uint8_t sd_score, uint8_t jl_score, uint16_t recent_activity,
                               uint8_t hour, bool has_accelerometer);
 
 #endif // PHASE_ENGINE_ENABLED
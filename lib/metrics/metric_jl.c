@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef PHASE_ENGINE_ENABLED
+
+#include "metric_jl.h"
+
+// Past a month every shift is long made up; keeps the products below in range.
+#define JL_MAX_ELAPSED_MIN (30UL * 1440)
+
+int16_t metric_jl_shift_minutes(int32_t shift_seconds) {
+    // Whole days don't shift the body clock; take the shorter way round.
+    int32_t seconds = shift_seconds % 86400;
+    if (seconds > JL_MAX_SHIFT_MIN * 60L) seconds -= 86400;
+    if (seconds < -JL_MAX_SHIFT_MIN * 60L) seconds += 86400;
+    
+    // Round to the quarter hour: clock corrections of a few minutes are not travel.
+    int32_t quarters = (seconds >= 0) ? (seconds + 450) / 900 : -((-seconds + 450) / 900);
+    return (int16_t)(quarters * 15);
+}
+
+int16_t metric_jl_remaining(int16_t shift_min, uint32_t elapsed_min) {
+    if (shift_min == 0) return 0;
+    if (elapsed_min > JL_MAX_ELAPSED_MIN) return 0;
+    
+    uint16_t rate = (shift_min > 0) ? JL_ADVANCE_MIN_PER_DAY : JL_DELAY_MIN_PER_DAY;
+    uint32_t recovered = elapsed_min * rate / 1440;
+    uint16_t magnitude = (shift_min > 0) ? shift_min : -shift_min;
+    if (recovered >= magnitude) return 0;
+    
+    int16_t remaining = magnitude - (int16_t)recovered;
+    return (shift_min > 0) ? remaining : -remaining;
+}
+
+uint8_t metric_jl_compute(int16_t remaining_min) {
+    uint16_t magnitude = (remaining_min < 0) ? -remaining_min : remaining_min;
+    if (magnitude >= 300) return 0;
+    return (uint8_t)(100 - magnitude / 3);
+}
+
+#endif // PHASE_ENGINE_ENABLED
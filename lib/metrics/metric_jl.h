@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef METRIC_JL_H_
+#define METRIC_JL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PHASE_ENGINE_ENABLED
+
+/**
+ * JL (Jet Lag) Metric
+ * 
+ * Algorithm: Re-entrainment after a time zone (or clock) shift
+ * 
+ * - A shift is the change of the local clock, in minutes, wrapped to ±12 h
+ *   and rounded to the quarter hour (+ = forward, i.e. flying east)
+ * - The body clock makes it up at a fixed rate per day, and which rate
+ *   depends on the direction. The light phase-response curve's delay lobe
+ *   outweighs its advance lobe for a free-running period a little over
+ *   24 h, so a delay (westward) comes back ~90 min/day and an advance
+ *   (eastward) ~60 min/day
+ * - A second shift before the first is made up adds to what is left
+ * - JL = 100 - remaining / 3, i.e. 20 points per hour left, 0 from 5 h
+ * 
+ * Closed form in the minutes since the shift, so each metric tick is O(1)
+ * and nothing is stored until the next shift.
+ * 
+ * Output: 0 (severe) to 100 (aligned)
+ * 
+ * Storage: 4 bytes in BKUP (shift in quarter hours, minute of the shift)
+ */
+
+#define JL_ADVANCE_MIN_PER_DAY 60
+#define JL_DELAY_MIN_PER_DAY 90
+#define JL_MAX_SHIFT_MIN 720
+
+/**
+ * Turn a change of the local clock into a shift.
+ * 
+ * @param shift_seconds New local time minus old local time
+ * @return Minutes, rounded to the quarter hour and wrapped to ±JL_MAX_SHIFT_MIN
+ */
+int16_t metric_jl_shift_minutes(int32_t shift_seconds);
+
+/**
+ * How much of a shift the body clock still has to make up.
+ * 
+ * @param shift_min Shift from metric_jl_shift_minutes()
+ * @param elapsed_min Minutes since the shift
+ * @return Remaining minutes, with the shift's sign; 0 once re-entrained
+ */
+int16_t metric_jl_remaining(int16_t shift_min, uint32_t elapsed_min);
+
+/**
+ * Compute the Jet Lag score.
+ * 
+ * @param remaining_min From metric_jl_remaining()
+ * @return JL score (0-100)
+ */
+uint8_t metric_jl_compute(int16_t remaining_min);
+
+#endif // PHASE_ENGINE_ENABLED
+
+#endif // METRIC_JL_H_
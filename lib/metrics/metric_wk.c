@@ -29,6 +29,9 @@
 // Activity threshold for full bonus (arbitrary units)
 #define WK_ACTIVITY_THRESHOLD 1000
 
+// Hour-horizon motion variance (mg²) that also earns the bonus
+#define WK_MOTION_VARIANCE_THRESHOLD 500
+
 // Ramp durations (minutes)
 #define WK_RAMP_NORMAL 120   // 2 hours
 #define WK_RAMP_FALLBACK 180 // 3 hours
@@ -36,7 +39,8 @@
 // Activity bonus (percentage points)
 #define WK_ACTIVITY_BONUS 30
 
-uint8_t metric_wk_compute(uint16_t minutes_awake, uint16_t cumulative_activity, bool has_accelerometer) {
+uint8_t metric_wk_compute(uint16_t minutes_awake, uint16_t cumulative_activity, uint16_t motion_variance,
+                          bool has_accelerometer) {
     uint8_t wk;
     
     if (has_accelerometer) {
@@ -45,8 +49,11 @@ uint8_t metric_wk_compute(uint16_t minutes_awake, uint16_t cumulative_activity,
         uint16_t base = (minutes_awake * 100) / WK_RAMP_NORMAL;
         if (base > 100) base = 100;
         
-        // Activity bonus: +30% if cumulative activity exceeds threshold
-        uint8_t bonus = (cumulative_activity >= WK_ACTIVITY_THRESHOLD) ? WK_ACTIVITY_BONUS : 0;
+        // Activity bonus: +30% if cumulative activity exceeds threshold, or the
+        // wearer has kept moving over the last hour
+        bool active = cumulative_activity >= WK_ACTIVITY_THRESHOLD ||
+                      motion_variance >= WK_MOTION_VARIANCE_THRESHOLD;
+        uint8_t bonus = active ? WK_ACTIVITY_BONUS : 0;
         
         // Combine base + bonus, capped at 100
         wk = (uint8_t)base + bonus;
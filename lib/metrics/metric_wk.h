@@ -37,7 +37,8 @@
  * 
  * Normal mode (accelerometer available):
  * - Base: 2-hour linear ramp (0-100 over 120 minutes)
- * - Bonus: +30% for high cumulative activity (>1000 units)
+ * - Bonus: +30% for high cumulative activity (>1000 units), or for motion
+ *   variance over the last hour at or above 500 mg² (moving about since waking)
  * - Max score: 100 (capped after bonus)
  * 
  * Fallback mode (no accelerometer, e.g., Green board):
@@ -53,10 +54,12 @@
  * 
  * @param minutes_awake Minutes since wake onset (0-1440)
  * @param cumulative_activity Cumulative activity since wake (0-65535)
+ * @param motion_variance Motion variance over about an hour, mg² (sensors, SENSOR_MOTION_LONG)
  * @param has_accelerometer True if LIS2DW accelerometer is available
  * @return WK score (0-100)
  */
-uint8_t metric_wk_compute(uint16_t minutes_awake, uint16_t cumulative_activity, bool has_accelerometer);
+uint8_t metric_wk_compute(uint16_t minutes_awake, uint16_t cumulative_activity, uint16_t motion_variance,
+                          bool has_accelerometer);
 
 #endif // PHASE_ENGINE_ENABLED
 
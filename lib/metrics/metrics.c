@@ -30,9 +30,11 @@
 #include "metric_wk.h"
 #include "metric_energy.h"
 #include "metric_comfort.h"
+#include "metric_jl.h"
 #include "circadian_score.h"
 #include "phase_engine.h"
 #include "sensors.h"
+#include "tick_profile.h"
 #include "watch.h"
 
 // Safe absolute value wrapper to handle INT16_MIN edge case
@@ -46,13 +48,59 @@ extern uint8_t movement_claim_backup_register(void);
 // Current metric values (computed on each update)
 static metrics_snapshot_t _current_metrics;
 
+// Nights are only ever appended, so the newest night's onset and the write
+// index identify a sleep history; 0 means none.
+static uint32_t _sleep_version(const circadian_data_t *sleep_data) {
+    if (!sleep_data) return 0;
+    const circadian_sleep_night_t *newest = &sleep_data->nights[(sleep_data->write_index + 6) % 7];
+    return (newest->onset_timestamp ^ ((uint32_t)sleep_data->write_index << 29)) | 1;
+}
+
+// Write a BKUP register unless it already holds the value.
+static void _store_backup(uint32_t data, uint8_t reg) {
+    if (watch_get_backup_data(reg) == data) {
+        TICK_PROFILE_COUNT(TICK_COUNT_BKUP_SKIPPED, 1);
+        return;
+    }
+    watch_store_backup_data(data, reg);
+    TICK_PROFILE_COUNT(TICK_COUNT_BKUP_WRITES, 1);
+}
+
+// The JL shift's minute is kept to 24 bits (~32 years), so it fits in a
+// register beside the shift; elapsed time is taken modulo that.
+#define JL_UTC_MINUTE_MASK 0xFFFFFFUL
+
+// Pack JL state into its BKUP register
+// Format: [shift in quarter hours (int8), minute of the shift (24 bits)]
+static void _save_jl(const metrics_engine_t *engine) {
+    if (engine->bkup_reg_jl == 0) return;
+    uint32_t jl_data = (uint8_t)(int8_t)(engine->jl_shift_min / 15);
+    jl_data |= (engine->jl_shift_utc_minute & JL_UTC_MINUTE_MASK) << 8;
+    _store_backup(jl_data, engine->bkup_reg_jl);
+}
+
+static int16_t _jl_remaining(const metrics_engine_t *engine, uint32_t utc_minute) {
+    if (engine->jl_shift_min == 0) return 0;
+    uint32_t elapsed = (utc_minute - engine->jl_shift_utc_minute) & JL_UTC_MINUTE_MASK;
+    return metric_jl_remaining(engine->jl_shift_min, elapsed);
+}
+
+#ifdef PHASE_TICK_PROFILE
+static uint8_t _count_bits(uint8_t bits) {
+    uint8_t count = 0;
+    for (; bits; bits &= bits - 1) count++;
+    return count;
+}
+#endif
+
 void metrics_init(metrics_engine_t *engine) {
     if (!engine) return;
     
     // Claim BKUP registers for persistent storage
-    // Need 2 registers total: one for SD (3 bytes), one for WK (2 bytes)
+    // Need 3 registers total: SD (3 bytes), WK (2 bytes) and JL (4 bytes)
     engine->bkup_reg_sd = movement_claim_backup_register();
     engine->bkup_reg_wk = movement_claim_backup_register();
+    engine->bkup_reg_jl = movement_claim_backup_register();
     
     // Initialize state
     engine->sd_deficits[0] = 0;
@@ -60,7 +108,13 @@ void metrics_init(metrics_engine_t *engine) {
     engine->sd_deficits[2] = 0;
     engine->wake_onset_hour = 0;
     engine->wake_onset_minute = 0;
+    engine->jl_shift_min = 0;
+    engine->jl_shift_utc_minute = 0;
+    engine->jl_held_seconds = 0;
+    engine->jl_held = false;
     engine->last_update_hour = 0;
+    engine->valid = 0;
+    engine->last_recomputed = 0;
     engine->initialized = true;
     
     // Initialize current metrics to neutral
@@ -69,6 +123,7 @@ void metrics_init(metrics_engine_t *engine) {
     _current_metrics.wk = 50;
     _current_metrics.energy = 50;
     _current_metrics.comfort = 50;
+    _current_metrics.jl = 100;
     
     // Try to load from BKUP if registers were claimed successfully
     if (engine->bkup_reg_sd != 0 && engine->bkup_reg_wk != 0) {
@@ -78,50 +133,66 @@ void metrics_init(metrics_engine_t *engine) {
 
 void metrics_update(metrics_engine_t *engine,
                     const struct sensor_state_t *sensors,
-                    uint8_t hour,
-                    uint8_t minute,
-                    uint16_t day_of_year,
+                    const calendar_context_t *cal,
                     uint8_t phase_score,
                     uint16_t cumulative_activity,
                     const circadian_data_t *sleep_data,
-                    const homebase_entry_t *homebase,
                     bool has_accelerometer) {
     
-    if (!engine || !engine->initialized) return;
+    if (!engine || !engine->initialized || !cal) return;
+    uint8_t hour = cal->hour;
     
     // Extract sensor values (with fallback defaults if sensors is NULL)
     int16_t temp_c10 = sensors ? (int16_t)sensors_get_temperature_c10(sensors) : 200;
     uint16_t light_lux = sensors ? sensors_get_lux_avg(sensors) : 0;
     uint16_t activity_variance = sensors ? sensors_get_motion_variance(sensors) : 50;
+    uint16_t motion_variance = sensors ? sensors_get_motion_variance_over(sensors, SENSOR_MOTION_LONG) : 0;
     uint16_t activity_level = sensors ? sensors_get_motion_intensity(sensors) : 0;
     
     // Update cadence tracking
     engine->last_update_hour = hour;
     
-    // Get current date for lunar calculation
-    watch_date_time_t now = watch_rtc_get_date_time();
-    uint16_t year = 2020 + now.unit.year;  // Convert from offset to absolute year
-    uint8_t month = now.unit.month;
-    uint8_t day = now.unit.day;
+    metrics_inputs_t *last = &engine->inputs;
+    uint8_t stale = METRIC_BITS_ALL & ~engine->valid;
+    
+    uint32_t sleep_version = _sleep_version(sleep_data);
+    if (sleep_version != last->sleep_version) stale |= METRIC_BIT_SD;
+    if (temp_c10 != last->temp_c10 || light_lux != last->light_lux ||
+        hour != last->hour || cal->day_version != last->day_version) {
+        stale |= METRIC_BIT_COMFORT;
+    }
+    if (activity_variance != last->activity_variance ||
+        hour != last->hour || cal->day_version != last->day_version) {
+        stale |= METRIC_BIT_EM;
+    }
     
     // --- Sleep Debt (SD) ---
     // Compute from sleep history and store deficits
-    _current_metrics.sd = metric_sd_compute(sleep_data, engine->sd_deficits);
+    if (stale & METRIC_BIT_SD) {
+        _current_metrics.sd = metric_sd_compute(sleep_data, engine->sd_deficits);
+        last->sleep_version = sleep_version;
+    }
     
     // --- Comfort ---
     // Phase 4D: Now includes lunar component (20% weight)
-    _current_metrics.comfort = metric_comfort_compute(temp_c10, light_lux, hour, homebase,
-                                                     year, month, day);
+    if (stale & METRIC_BIT_COMFORT) {
+        _current_metrics.comfort = metric_comfort_compute(temp_c10, light_lux, cal);
+        last->temp_c10 = temp_c10;
+        last->light_lux = light_lux;
+    }
     
     // --- Emotional (EM) ---
     // Compute from circadian cycle, lunar cycle, and activity variance
-    _current_metrics.em = metric_em_compute(hour, day_of_year, activity_variance);
+    if (stale & METRIC_BIT_EM) {
+        _current_metrics.em = metric_em_compute(hour, cal->lunar.illumination, activity_variance);
+        last->activity_variance = activity_variance;
+    }
     
     // --- Wake Momentum (WK) ---
     // Calculate minutes awake from wake onset time
     // Use total minutes from midnight to handle wraparound correctly
     uint16_t wake_minutes = engine->wake_onset_hour * 60 + engine->wake_onset_minute;
-    uint16_t current_minutes = hour * 60 + minute;
+    uint16_t current_minutes = cal->minute_of_day;
     
     // Handle midnight wraparound
     if (current_minutes < wake_minutes) {
@@ -129,16 +200,60 @@ void metrics_update(metrics_engine_t *engine,
     }
     
     uint16_t minutes_awake = current_minutes - wake_minutes;
-    _current_metrics.wk = metric_wk_compute(minutes_awake, cumulative_activity, has_accelerometer);
+    if (minutes_awake != last->minutes_awake || cumulative_activity != last->cumulative_activity ||
+        motion_variance != last->motion_variance || has_accelerometer != last->has_accelerometer) {
+        stale |= METRIC_BIT_WK;
+    }
+    if (stale & METRIC_BIT_WK) {
+        _current_metrics.wk = metric_wk_compute(minutes_awake, cumulative_activity, motion_variance, has_accelerometer);
+        last->minutes_awake = minutes_awake;
+        last->cumulative_activity = cumulative_activity;
+        last->motion_variance = motion_variance;
+    }
+    
+    // --- Jet Lag (JL) ---
+    // What is left of the last clock shift; nothing to work out without one
+    int16_t jl_remaining = _jl_remaining(engine, cal->utc_minute);
+    if (jl_remaining == 0 && engine->jl_shift_min != 0) {
+        // Re-entrained: forget the shift so later ticks skip straight past
+        engine->jl_shift_min = 0;
+        _save_jl(engine);
+    }
+    if (jl_remaining != last->jl_remaining_min) stale |= METRIC_BIT_JL;
+    if (stale & METRIC_BIT_JL) {
+        _current_metrics.jl = metric_jl_compute(jl_remaining);
+        last->jl_remaining_min = jl_remaining;
+    }
     
     // --- Energy ---
-    // Derived from phase score, sleep debt, and activity/circadian bonus
-    _current_metrics.energy = metric_energy_compute(phase_score, _current_metrics.sd, 
-                                                     activity_level, hour, has_accelerometer);
+    // Derived from phase score, sleep debt, jet lag, and activity/circadian bonus
+    if (phase_score != last->phase_score || _current_metrics.sd != last->sd ||
+        _current_metrics.jl != last->jl ||
+        activity_level != last->activity_level || hour != last->hour ||
+        has_accelerometer != last->has_accelerometer) {
+        stale |= METRIC_BIT_ENERGY;
+    }
+    if (stale & METRIC_BIT_ENERGY) {
+        _current_metrics.energy = metric_energy_compute(phase_score, _current_metrics.sd, _current_metrics.jl,
+                                                         activity_level, hour, has_accelerometer);
+        last->phase_score = phase_score;
+        last->sd = _current_metrics.sd;
+        last->jl = _current_metrics.jl;
+        last->activity_level = activity_level;
+    }
     
-    // Auto-save to BKUP on hourly boundary
-    // (Only save SD and WK state, other metrics are derived)
-    if (engine->bkup_reg_sd != 0 && engine->bkup_reg_wk != 0) {
+    // Keys shared by several metrics are updated once all of them have been checked.
+    last->hour = hour;
+    last->day_version = cal->day_version;
+    last->has_accelerometer = has_accelerometer;
+    engine->valid = METRIC_BITS_ALL;
+    engine->last_recomputed = stale;
+    TICK_PROFILE_COUNT(TICK_COUNT_METRICS_RECOMPUTED, _count_bits(stale));
+    TICK_PROFILE_COUNT(TICK_COUNT_METRICS_SKIPPED, _count_bits(METRIC_BITS_ALL & ~stale));
+    
+    // Persist the SD deficits when they may have moved (WK's onset is saved
+    // as soon as it is set; other metrics are derived)
+    if ((stale & METRIC_BIT_SD) && engine->bkup_reg_sd != 0 && engine->bkup_reg_wk != 0) {
         metrics_save_bkup(engine);
     }
 }
@@ -159,14 +274,16 @@ void metrics_save_bkup(const metrics_engine_t *engine) {
     sd_data |= (uint32_t)engine->sd_deficits[0];
     sd_data |= ((uint32_t)engine->sd_deficits[1]) << 8;
     sd_data |= ((uint32_t)engine->sd_deficits[2]) << 16;
-    watch_store_backup_data(sd_data, engine->bkup_reg_sd);
+    _store_backup(sd_data, engine->bkup_reg_sd);
     
     // Pack WK state into BKUP[bkup_reg_wk] (2 bytes)
     // Format: [wake_onset_hour, wake_onset_minute, unused, unused]
     uint32_t wk_data = 0;
     wk_data |= (uint32_t)engine->wake_onset_hour;
     wk_data |= ((uint32_t)engine->wake_onset_minute) << 8;
-    watch_store_backup_data(wk_data, engine->bkup_reg_wk);
+    _store_backup(wk_data, engine->bkup_reg_wk);
+    
+    _save_jl(engine);
 }
 
 void metrics_load_bkup(metrics_engine_t *engine) {
@@ -191,6 +308,15 @@ void metrics_load_bkup(metrics_engine_t *engine) {
     // Validate and clamp loaded time values
     if (engine->wake_onset_hour >= 24) engine->wake_onset_hour = 0;
     if (engine->wake_onset_minute >= 60) engine->wake_onset_minute = 0;
+    
+    // Load JL state from BKUP
+    if (engine->bkup_reg_jl != 0) {
+        uint32_t jl_data = watch_get_backup_data(engine->bkup_reg_jl);
+        int16_t shift = (int8_t)(jl_data & 0xFF) * 15;
+        if (shift > JL_MAX_SHIFT_MIN || shift < -JL_MAX_SHIFT_MIN) shift = 0;
+        engine->jl_shift_min = shift;
+        engine->jl_shift_utc_minute = jl_data >> 8;
+    }
 }
 
 void metrics_set_wake_onset(metrics_engine_t *engine, uint8_t hour, uint8_t minute) {
@@ -209,7 +335,39 @@ void metrics_set_wake_onset(metrics_engine_t *engine, uint8_t hour, uint8_t minu
         uint32_t wk_data = 0;
         wk_data |= (uint32_t)engine->wake_onset_hour;
         wk_data |= ((uint32_t)engine->wake_onset_minute) << 8;
-        watch_store_backup_data(wk_data, engine->bkup_reg_wk);
+        _store_backup(wk_data, engine->bkup_reg_wk);
+    }
+}
+
+void metrics_note_time_shift(metrics_engine_t *engine, int32_t shift_seconds, uint32_t utc_minute) {
+    if (!engine) return;
+    
+    int16_t shift = metric_jl_shift_minutes(shift_seconds);
+    if (shift == 0) return;
+    
+    // Still making up an earlier shift: the new one starts from what is left of it.
+    int32_t total = (int32_t)_jl_remaining(engine, utc_minute) + shift;
+    engine->jl_shift_min = metric_jl_shift_minutes(total * 60);
+    engine->jl_shift_utc_minute = utc_minute & JL_UTC_MINUTE_MASK;
+    _save_jl(engine);
+}
+
+void metrics_hold_time_shift(metrics_engine_t *engine, int32_t shift_seconds) {
+    if (!engine) return;
+    
+    // Unsigned, so stepping the year round and back wraps instead of overflowing.
+    engine->jl_held_seconds += (uint32_t)shift_seconds;
+    engine->jl_held = true;
+}
+
+void metrics_flush_time_shift(metrics_engine_t *engine, uint32_t utc_minute) {
+    if (!engine || !engine->jl_held) return;
+    
+    int32_t net = (int32_t)engine->jl_held_seconds;
+    engine->jl_held_seconds = 0;
+    engine->jl_held = false;
+    if (net > -2 * 86400 && net < 2 * 86400) {
+        metrics_note_time_shift(engine, net, utc_minute);
     }
 }
 
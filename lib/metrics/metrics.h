@@ -32,6 +32,7 @@
 
 #include "circadian_score.h"
 #include "phase_engine.h"
+#include "calendar_context.h"
 
 // Forward declaration for sensor state
 struct sensor_state_t;
@@ -44,7 +45,7 @@ struct sensor_state_t;
  * - EM (Emotional): Circadian + lunar + activity variance
  * - WK (Wake Momentum): Ramp from sleep onset to full alertness
  * - Energy: Phase-aligned capacity (derived from phase + SD + activity)
- * - JL (Jet Lag): Timezone shift disruption (Phase 4 - stubbed in Phase 3)
+ * - JL (Jet Lag): Re-entrainment after a time zone or clock shift
  * - Comfort: Environmental alignment (temp + light vs homebase)
  */
 
@@ -55,9 +56,39 @@ typedef struct {
     uint8_t wk;       // Wake Momentum (0=just woke, 100=fully alert)
     uint8_t energy;   // Energy capacity (0=depleted, 100=peak)
     uint8_t comfort;  // Environmental comfort (0=deviation, 100=aligned)
+    uint8_t jl;       // Jet Lag (0=severe, 100=aligned)
 } metrics_snapshot_t;
 
-// Internal metric engine state (~32 bytes)
+// Metric bits, for metrics_engine_t.valid and .last_recomputed
+#define METRIC_BIT_SD      (1 << 0)
+#define METRIC_BIT_EM      (1 << 1)
+#define METRIC_BIT_WK      (1 << 2)
+#define METRIC_BIT_ENERGY  (1 << 3)
+#define METRIC_BIT_COMFORT (1 << 4)
+#define METRIC_BIT_JL      (1 << 5)
+#define METRIC_BITS_ALL    0x3F
+
+// The inputs each metric was last computed from. A metric whose inputs are
+// unchanged keeps its value; SD, for one, only moves once a night.
+typedef struct {
+    uint32_t sleep_version;         // SD: newest night's onset and the write index (see metrics.c)
+    int16_t temp_c10;               // Comfort
+    uint16_t light_lux;             // Comfort
+    uint16_t activity_variance;     // EM: the short motion horizon
+    uint16_t minutes_awake;         // WK
+    uint16_t cumulative_activity;   // WK
+    uint16_t motion_variance;       // WK: the long horizon
+    uint16_t activity_level;        // Energy
+    uint8_t phase_score;            // Energy
+    uint8_t sd;                     // Energy (the SD value, not its inputs)
+    int16_t jl_remaining_min;       // JL
+    uint8_t jl;                     // Energy (the JL value)
+    uint8_t hour;                   // Comfort, EM, Energy
+    uint8_t day_version;            // Comfort, EM: homebase day, moon, sun (calendar_context_t)
+    bool has_accelerometer;         // WK, Energy
+} metrics_inputs_t;
+
+// Internal metric engine state (~64 bytes)
 typedef struct {
     // Sleep Debt state (3 bytes in BKUP)
     uint8_t sd_deficits[3];  // 3-night rolling deficit (0-100 each), packed as deficit/4
@@ -66,13 +97,23 @@ typedef struct {
     uint8_t wake_onset_hour;
     uint8_t wake_onset_minute;
     
+    // Jet Lag state (4 bytes in BKUP): the shift being made up, and when it happened
+    int16_t jl_shift_min;           // 0 when there is none
+    uint32_t jl_shift_utc_minute;   // Low 24 bits of calendar_context_t.utc_minute
+    
     // Runtime state (not persisted)
+    uint32_t jl_held_seconds;       // Net of the clock jumps held back, modulo 2^32
+    bool jl_held;
     uint8_t last_update_hour;
     bool initialized;
+    metrics_inputs_t inputs;        // What each metric was last computed from
+    uint8_t valid;                  // METRIC_BIT_* computed at least once since init
+    uint8_t last_recomputed;        // METRIC_BIT_* recomputed by the last update
     
     // BKUP register indices (claimed at init)
     uint8_t bkup_reg_sd;      // BKUP register for SD state (3 bytes)
     uint8_t bkup_reg_wk;      // BKUP register for WK state (2 bytes)
+    uint8_t bkup_reg_jl;      // BKUP register for JL state (4 bytes)
 } metrics_engine_t;
 
 /**
@@ -84,28 +125,25 @@ typedef struct {
 void metrics_init(metrics_engine_t *engine);
 
 /**
- * Update all metrics based on current sensor data and time.
+ * Update the metrics based on current sensor data and time. Only metrics
+ * whose inputs changed since they were last computed are recomputed (see
+ * metrics_inputs_t), and the SD register is only written when SD was.
  * 
  * @param engine Engine state
  * @param sensors Sensor state (motion, temp, light data)
- * @param hour Current hour (0-23)
- * @param minute Current minute (0-59)
- * @param day_of_year Current day (1-365)
+ * @param cal Calendar context for this minute (local time, day of year,
+ *            moon age, today's homebase entry, sunrise/sunset)
  * @param phase_score Current phase score from phase_engine (0-100)
  * @param cumulative_activity Cumulative activity since wake (0-65535, for WK bonus)
  * @param sleep_data Circadian sleep history (7-night buffer)
- * @param homebase Homebase entry for current day (seasonal baseline)
  * @param has_accelerometer True if LIS2DW accelerometer is available
  */
 void metrics_update(metrics_engine_t *engine,
                     const struct sensor_state_t *sensors,
-                    uint8_t hour,
-                    uint8_t minute,
-                    uint16_t day_of_year,
+                    const calendar_context_t *cal,
                     uint8_t phase_score,
                     uint16_t cumulative_activity,
                     const circadian_data_t *sleep_data,
-                    const homebase_entry_t *homebase,
                     bool has_accelerometer);
 
 /**
@@ -118,7 +156,8 @@ void metrics_get(const metrics_engine_t *engine, metrics_snapshot_t *out);
 
 /**
  * Save metric state to BKUP registers.
- * Call before entering low-power mode.
+ * Call before entering low-power mode. Registers already holding the value
+ * are not rewritten.
  * 
  * @param engine Engine state
  */
@@ -142,6 +181,37 @@ void metrics_load_bkup(metrics_engine_t *engine);
  */
 void metrics_set_wake_onset(metrics_engine_t *engine, uint8_t hour, uint8_t minute);
 
+/**
+ * Record a jump of the local clock, for the JL metric: a new time zone,
+ * or the time set by hand. Adds to whatever is left of an earlier shift,
+ * and is saved to BKUP straight away.
+ * 
+ * @param engine Engine state
+ * @param shift_seconds New local time minus old local time
+ * @param utc_minute Minutes since 1970-01-01 00:00 UTC, now
+ */
+void metrics_note_time_shift(metrics_engine_t *engine, int32_t shift_seconds, uint32_t utc_minute);
+
+/**
+ * Hold back a jump of the local clock instead of recording it, so that a
+ * clock set one press at a time (each hour, each zone) is one shift rather
+ * than a dozen. metrics_flush_time_shift() records the net of them.
+ * 
+ * @param engine Engine state
+ * @param shift_seconds New local time minus old local time
+ */
+void metrics_hold_time_shift(metrics_engine_t *engine, int32_t shift_seconds);
+
+/**
+ * Record the net of the jumps held since the last flush, if any, with
+ * metrics_note_time_shift(). A net of two days or more is setting the date,
+ * not travel, and is dropped.
+ * 
+ * @param engine Engine state
+ * @param utc_minute Minutes since 1970-01-01 00:00 UTC, now
+ */
+void metrics_flush_time_shift(metrics_engine_t *engine, uint32_t utc_minute);
+
 /**
  * Get dominant metric ID for current zone.
  * Determines which metric (SD/EM/WK/Comfort) has highest deviation from neutral (50).
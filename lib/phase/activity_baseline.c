@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Personal activity baseline. See activity_baseline.h.
+ */
+
+#include "activity_baseline.h"
+
+#ifdef PHASE_ENGINE_ENABLED
+
+#include "watch.h"
+#include <string.h>
+
+// What activity_baseline_save() keeps.
+typedef struct {
+    uint16_t mean[24];
+    uint16_t variance[24];
+    uint8_t days[24];
+} activity_baseline_record_t;
+
+static watch_storage_log_t baseline_log;
+static bool baseline_log_open = false;
+
+// Opening scans the whole log, so saves reuse the last open; loads rescan.
+static bool baseline_log_ready(bool rescan) {
+    if (rescan || !baseline_log_open) {
+        baseline_log_open = watch_storage_log_open(&baseline_log, BASELINE_STORAGE_LOG,
+                                                   sizeof(activity_baseline_record_t), BASELINE_STORAGE_LOG_ROWS);
+    }
+    return baseline_log_open;
+}
+
+static uint16_t _isqrt32(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)root;
+}
+
+// Fold the finished hour's mean into its baseline (the first day seeds it).
+static void _fold_hour(activity_baseline_t *baseline) {
+    uint8_t hour = baseline->hour;
+    int32_t value = (((uint32_t)baseline->hour_sum << 8) + baseline->hour_samples / 2) / baseline->hour_samples;
+
+    if (baseline->days[hour] == 0) {
+        baseline->mean[hour] = (uint16_t)value;
+        baseline->variance[hour] = 0;
+    } else {
+        // Exponentially weighted mean and variance (West, 1979):
+        // mean += a·d; var = (1 - a)·(var + d·a·d), with d against the old mean.
+        int32_t diff = value - baseline->mean[hour];
+        int32_t step = diff / (1 << ACTIVITY_BASELINE_WEIGHT_SHIFT);
+        baseline->mean[hour] = (uint16_t)(baseline->mean[hour] + step);
+
+        // diff·step is activity² x 65536; the variance is kept x 16.
+        uint32_t variance = baseline->variance[hour] + (uint32_t)((diff * step) >> 12);
+        variance -= variance >> ACTIVITY_BASELINE_WEIGHT_SHIFT;
+        baseline->variance[hour] = (variance > UINT16_MAX) ? UINT16_MAX : (uint16_t)variance;
+    }
+    if (baseline->days[hour] < UINT8_MAX) baseline->days[hour]++;
+}
+
+// 100 / standard deviation, for z-scores without a divide. The variance is
+// x 16, so shifting it up 12 more before the root gives the deviation x 256.
+static uint16_t _z_scale(const activity_baseline_t *baseline, uint8_t hour) {
+    if (!activity_baseline_ready(baseline, hour)) return 0;
+
+    uint32_t sd = _isqrt32((uint32_t)baseline->variance[hour] << 12);
+    if (sd < (ACTIVITY_BASELINE_MIN_SD << 8)) sd = ACTIVITY_BASELINE_MIN_SD << 8;
+    return (uint16_t)((100UL << 16) / sd);
+}
+
+void activity_baseline_add(activity_baseline_t *baseline, uint8_t hour, uint8_t activity) {
+    if (hour > 23) return;
+    if (activity > 100) activity = 100;
+
+    if (baseline->hour_samples == 0 || hour != baseline->hour) {
+        if (baseline->hour_samples > 0) _fold_hour(baseline);
+        baseline->hour_sum = 0;
+        baseline->hour_samples = 0;
+        baseline->z_scale = _z_scale(baseline, hour);
+    }
+    if (baseline->hour_samples == UINT8_MAX) {
+        // Keep the mean, halve the weight.
+        baseline->hour_sum /= 2;
+        baseline->hour_samples /= 2;
+    }
+    baseline->hour = hour;
+    baseline->hour_sum += activity;
+    baseline->hour_samples++;
+}
+
+bool activity_baseline_ready(const activity_baseline_t *baseline, uint8_t hour) {
+    return hour < 24 && baseline->days[hour] >= ACTIVITY_BASELINE_MIN_DAYS;
+}
+
+int16_t activity_baseline_zscore(const activity_baseline_t *baseline, uint8_t hour, uint8_t activity) {
+    if (activity > 100) activity = 100;
+    uint16_t scale = (baseline->hour_samples > 0 && hour == baseline->hour)
+                     ? baseline->z_scale
+                     : _z_scale(baseline, hour);
+    if (scale == 0) return 0;
+
+    // |diff| <= 25600 and scale <= 5120, so the product fits.
+    int32_t diff = ((int32_t)activity << 8) - baseline->mean[hour];
+    int32_t z = diff * scale / 65536;
+    if (z > ACTIVITY_BASELINE_MAX_Z) z = ACTIVITY_BASELINE_MAX_Z;
+    if (z < -ACTIVITY_BASELINE_MAX_Z) z = -ACTIVITY_BASELINE_MAX_Z;
+    return (int16_t)z;
+}
+
+bool activity_baseline_save(const activity_baseline_t *baseline) {
+    activity_baseline_record_t record;
+
+    if (!baseline_log_ready(false)) return false;
+
+    memcpy(record.mean, baseline->mean, sizeof(record.mean));
+    memcpy(record.variance, baseline->variance, sizeof(record.variance));
+    memcpy(record.days, baseline->days, sizeof(record.days));
+
+    return watch_storage_log_append_async(&baseline_log, &record, NULL, NULL);
+}
+
+bool activity_baseline_load(activity_baseline_t *baseline) {
+    activity_baseline_record_t record;
+
+    if (!baseline_log_ready(true) || !watch_storage_log_read(&baseline_log, 0, &record)) return false;
+
+    for (uint8_t hour = 0; hour < 24; hour++) {
+        if (record.mean[hour] > (100 << 8)) return false;
+    }
+
+    memcpy(baseline->mean, record.mean, sizeof(baseline->mean));
+    memcpy(baseline->variance, record.variance, sizeof(baseline->variance));
+    memcpy(baseline->days, record.days, sizeof(baseline->days));
+    baseline->hour_sum = 0;
+    baseline->hour_samples = 0;
+    baseline->z_scale = 0;
+
+    return true;
+}
+
+#endif // PHASE_ENGINE_ENABLED
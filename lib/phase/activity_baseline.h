@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Personal activity baseline
+ *
+ * What this wearer's activity usually is at each hour of the day, learned
+ * on the watch: an exponentially weighted mean and variance per local hour,
+ * with each day's hourly mean folded in as the hour ends (weight 1/8, so
+ * about the last week and a half counts). Phase scoring compares the current
+ * activity against it as a z-score instead of against the population curve,
+ * so a night-shift schedule that repeats stops reading as misaligned.
+ *
+ * O(1) per sample, 126 bytes of state, fixed point throughout. The square
+ * root and divide behind a z-score happen once an hour, not per sample. Kept in the
+ * "baseline" flash log so it survives resets.
+ */
+
+#ifndef ACTIVITY_BASELINE_H_
+#define ACTIVITY_BASELINE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PHASE_ENGINE_ENABLED
+
+#define ACTIVITY_BASELINE_WEIGHT_SHIFT 3    // A new day weighs 1/8
+#define ACTIVITY_BASELINE_MIN_DAYS 3        // Days an hour needs before it is used
+#define ACTIVITY_BASELINE_MIN_SD 5          // Floor on the spread (activity units), so z stays sane
+#define ACTIVITY_BASELINE_MAX_Z 1000        // |z| clamp, x 100
+#define BASELINE_STORAGE_LOG "baseline"     // Flash storage log for the baseline
+#define BASELINE_STORAGE_LOG_ROWS 2         // Rows in its ring
+
+typedef struct {
+    uint16_t mean[24];          // Mean activity per local hour (0-100), x 256
+    uint16_t variance[24];      // Variance per local hour (activity²), x 16
+    uint8_t days[24];           // Days folded into each hour (saturates at 255)
+    uint16_t hour_sum;          // Samples of the hour in progress
+    uint8_t hour_samples;
+    uint8_t hour;               // Hour in progress (0-23), if hour_samples > 0
+    uint16_t z_scale;           // 100 / standard deviation of that hour, Q16 of x 256; 0 if not ready
+} activity_baseline_t;
+
+/**
+ * Add an activity sample. When the hour changes, the previous hour's mean
+ * is folded into that hour's baseline.
+ *
+ * @param hour Local hour (0-23)
+ * @param activity Activity level (0-100)
+ */
+void activity_baseline_add(activity_baseline_t *baseline, uint8_t hour, uint8_t activity);
+
+/**
+ * @return true once the hour has ACTIVITY_BASELINE_MIN_DAYS days behind it
+ */
+bool activity_baseline_ready(const activity_baseline_t *baseline, uint8_t hour);
+
+/**
+ * How unusual an activity level is for this wearer at this hour.
+ *
+ * @param hour Local hour (0-23)
+ * @param activity Activity level (0-100)
+ * @return (activity - mean) / standard deviation, x 100, clamped to
+ *         ±ACTIVITY_BASELINE_MAX_Z; 0 if the hour isn't ready. Cheapest
+ *         for the hour last passed to activity_baseline_add().
+ */
+int16_t activity_baseline_zscore(const activity_baseline_t *baseline, uint8_t hour, uint8_t activity);
+
+/**
+ * Save the learned hours to the "baseline" flash log (see watch_storage_log.h).
+ * Queued, so it returns at once. The hour in progress isn't kept.
+ *
+ * @return false if the write couldn't be queued
+ */
+bool activity_baseline_save(const activity_baseline_t *baseline);
+
+/**
+ * Restore what activity_baseline_save() kept. Call once at boot, on a
+ * zeroed baseline.
+ *
+ * @return true if a baseline was restored
+ */
+bool activity_baseline_load(activity_baseline_t *baseline);
+
+#endif // PHASE_ENGINE_ENABLED
+
+#endif // ACTIVITY_BASELINE_H_
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Per-minute calendar context. See calendar_context.h.
+ */
+
+#include "calendar_context.h"
+
+#ifdef PHASE_ENGINE_ENABLED
+
+#include "watch_utility.h"
+
+void calendar_context_update(calendar_context_t *ctx,
+                             watch_date_time_t local,
+                             int32_t utc_offset,
+                             int16_t latitude,
+                             int16_t longitude,
+                             bool active_hours_enabled,
+                             uint8_t active_start_qh,
+                             uint8_t active_end_qh) {
+    uint16_t year = local.unit.year + WATCH_RTC_REFERENCE_YEAR;
+    uint8_t month = local.unit.month;
+    uint8_t day = local.unit.day;
+    uint8_t preset = homebase_get_preset();
+
+    bool same_day = ctx->valid &&
+                    ctx->year == year &&
+                    ctx->local.unit.month == month &&
+                    ctx->local.unit.day == day &&
+                    ctx->utc_offset == utc_offset &&
+                    ctx->latitude == latitude &&
+                    ctx->longitude == longitude &&
+                    ctx->homebase_preset == preset;
+
+    ctx->local = local;
+    ctx->hour = local.unit.hour;
+    ctx->minute = local.unit.minute;
+    ctx->minute_of_day = ctx->hour * 60 + ctx->minute;
+
+    if (!same_day) {
+        ctx->year = year;
+        ctx->day_start_utc_minute = watch_utility_convert_to_unix_time(year, month, day, 0, 0, 0, utc_offset) / 60;
+        ctx->day_of_year = watch_utility_days_since_new_year(year, month, day);
+        lunar_update_today(year, month, day, utc_offset);
+        ctx->lunar = *lunar_get_today();
+        // The homebase tables are 365 days long; Dec 31 of a leap year reuses Dec 30.
+        ctx->homebase = *homebase_get_entry(ctx->day_of_year > 365 ? 365 : ctx->day_of_year);
+
+        solar_update_today(year, month, day, latitude, longitude, utc_offset);
+        ctx->solar = solar_get_today();
+
+        ctx->utc_offset = utc_offset;
+        ctx->latitude = latitude;
+        ctx->longitude = longitude;
+        ctx->homebase_preset = preset;
+        ctx->valid = true;
+        ctx->day_version++;
+    }
+    ctx->utc_minute = ctx->day_start_utc_minute + ctx->minute_of_day;
+
+    // Clamp to valid range before division (96 quarter-hours = 24 hours)
+    if (active_start_qh > 95) active_start_qh = 95;
+    if (active_end_qh > 95) active_end_qh = 95;
+    ctx->active_hours_enabled = active_hours_enabled;
+    ctx->active_start_hour = active_start_qh / 4;
+    ctx->active_end_hour = active_end_qh / 4;
+}
+
+#endif // PHASE_ENGINE_ENABLED
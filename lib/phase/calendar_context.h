@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Per-minute calendar context
+ *
+ * Everything the phase engine and the metrics need to know about "now",
+ * worked out once per minute in local time: the date and time, day of
+ * year, moon age, today's homebase entry, sunrise/sunset and the active
+ * hours window. Movement builds one at the top of each minute and hands
+ * it by reference to phase, metrics and telemetry, so none of them read
+ * the RTC or redo date math themselves.
+ *
+ * The per-day fields are only recomputed when the date (or location,
+ * UTC offset or homebase preset) changes, so an update is a handful of
+ * compares on all but one minute a day.
+ */
+
+#ifndef CALENDAR_CONTEXT_H_
+#define CALENDAR_CONTEXT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch.h"
+#include "phase_engine.h"
+
+#ifdef PHASE_ENGINE_ENABLED
+
+#include "homebase.h"
+#include "solar.h"
+#include "lunar.h"
+
+typedef struct {
+    // Per-minute
+    watch_date_time_t local;        // Local date and time
+    uint8_t hour;                   // 0-23, local
+    uint8_t minute;                 // 0-59
+    uint16_t minute_of_day;         // 0-1439, local
+    uint32_t utc_minute;            // Minutes since 1970-01-01 00:00 UTC
+
+    // Per-day
+    uint16_t year;                  // Full year (e.g. 2026)
+    uint16_t day_of_year;           // 1-366
+    lunar_phase_t lunar;            // Moon at local noon: age, illumination, phase name
+    homebase_entry_t homebase;      // Today's seasonal baseline (a copy, not the shared buffer)
+    const solar_times_t *solar;     // Today's sunrise/sunset, or NULL if no location is set
+
+    // Active hours (BKUP[2]), in whole hours
+    bool active_hours_enabled;
+    uint8_t active_start_hour;      // 0-23
+    uint8_t active_end_hour;        // 0-23
+
+    // Cache keys for the per-day fields
+    uint32_t day_start_utc_minute;  // utc_minute at local midnight
+    bool valid;
+    uint8_t day_version;            // Bumped whenever the per-day fields are recomputed
+    int32_t utc_offset;
+    int16_t latitude;
+    int16_t longitude;
+    uint8_t homebase_preset;
+} calendar_context_t;
+
+/**
+ * Refresh the context for the current minute.
+ *
+ * @param ctx Context, zeroed before the first call
+ * @param local Local date and time (movement_get_local_date_time())
+ * @param utc_offset Seconds to add to UTC for local time
+ * @param latitude Hundredths of a degree (movement_location_t); 0,0 means not set
+ * @param longitude Hundredths of a degree
+ * @param active_hours_enabled Active hours switch from BKUP[2]
+ * @param active_start_qh Active hours start, in quarter hours (0-95)
+ * @param active_end_qh Active hours end, in quarter hours (0-95)
+ */
+void calendar_context_update(calendar_context_t *ctx,
+                             watch_date_time_t local,
+                             int32_t utc_offset,
+                             int16_t latitude,
+                             int16_t longitude,
+                             bool active_hours_enabled,
+                             uint8_t active_start_qh,
+                             uint8_t active_end_qh);
+
+#endif // PHASE_ENGINE_ENABLED
+
+#endif // CALENDAR_CONTEXT_H_
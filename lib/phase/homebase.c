@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Homebase table decoder. See homebase.h for the encoding.
+ */
+
+#include "homebase.h"
+
+#ifdef PHASE_ENGINE_ENABLED
+
+// Generated data; only this file includes it, so there is one copy in flash.
+#include "homebase_table.h"
+
+#define HOMEBASE_PRESET_COUNT (sizeof(homebase_presets) / sizeof(homebase_presets[0]))
+
+static uint8_t current_preset;
+static homebase_entry_t decoded_entry;
+static uint16_t decoded_day;  // 0: nothing decoded yet
+
+int16_t homebase_field_decode(const homebase_field_t *field, uint16_t day_index) {
+    uint8_t knot = day_index / HOMEBASE_KNOT_SPACING;
+    if (knot > HOMEBASE_KNOT_COUNT - 2) knot = HOMEBASE_KNOT_COUNT - 2;
+    uint16_t knot_day = knot * HOMEBASE_KNOT_SPACING;
+    // The last knot sits on day 365, so the final segment is shorter.
+    uint16_t span = (knot == HOMEBASE_KNOT_COUNT - 2) ?
+                    (HOMEBASE_DAYS - 1 - knot_day) : HOMEBASE_KNOT_SPACING;
+
+    int16_t from = field->knots[knot];
+    int16_t to = field->knots[knot + 1];
+    int16_t value = from + (int16_t)(((int32_t)(to - from) * (day_index - knot_day)) / span);
+
+    uint8_t bits = field->residual_bits;
+    if (bits) {
+        uint16_t bit = day_index * bits;
+        const uint8_t *at = field->residuals + (bit >> 3);
+        uint16_t raw = ((at[0] | (at[1] << 8)) >> (bit & 7)) & ((1u << bits) - 1);
+        // sign-extend from `bits` wide
+        int16_t residual = (raw & (1u << (bits - 1))) ? (int16_t)raw - (int16_t)(1u << bits) : (int16_t)raw;
+        value += residual;
+    }
+
+    return value;
+}
+
+const homebase_entry_t* homebase_get_entry(uint16_t day_of_year) {
+    if (day_of_year < 1 || day_of_year > HOMEBASE_DAYS) {
+        day_of_year = 1;  // Safe fallback
+    }
+    if (day_of_year == decoded_day) return &decoded_entry;
+
+    const homebase_preset_t *preset = &homebase_presets[current_preset];
+    uint16_t index = day_of_year - 1;
+    decoded_entry.expected_daylight_min = homebase_field_decode(&preset->daylight, index);
+    decoded_entry.avg_temp_c10 = homebase_field_decode(&preset->temp, index);
+    decoded_entry.seasonal_baseline = homebase_field_decode(&preset->baseline, index);
+    decoded_day = day_of_year;
+
+    return &decoded_entry;
+}
+
+const homebase_metadata_t* homebase_get_metadata(void) {
+    return &homebase_presets[current_preset].metadata;
+}
+
+uint8_t homebase_preset_count(void) {
+    return HOMEBASE_PRESET_COUNT;
+}
+
+const char* homebase_preset_name(uint8_t index) {
+    if (index >= HOMEBASE_PRESET_COUNT) return NULL;
+    return homebase_presets[index].name;
+}
+
+uint8_t homebase_get_preset(void) {
+    return current_preset;
+}
+
+bool homebase_select_preset(uint8_t index) {
+    if (index >= HOMEBASE_PRESET_COUNT) return false;
+    if (index != current_preset) {
+        current_preset = index;
+        decoded_day = 0;
+    }
+    return true;
+}
+
+#endif
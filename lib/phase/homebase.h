@@ -4,18 +4,22 @@
  * Copyright (c) 2026 Diego Perez
  *
  * Homebase Table Interface
- * 
+ *
  * Provides access to location-specific seasonal data (daylight,
  * temperature, energy baseline) for phase computation.
- * 
- * The homebase table is generated at build time by
- * utils/generate_homebase.py and compiled into the firmware.
+ *
+ * The homebase tables are generated at build time by
+ * utils/generate_homebase.py and compiled into the firmware. Each
+ * location is stored compactly and decoded one day at a time, so
+ * several can be built in and switched between at runtime.
  */
 
 #ifndef HOMEBASE_H_
 #define HOMEBASE_H_
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "phase_engine.h"
 
 #ifdef PHASE_ENGINE_ENABLED
@@ -32,8 +36,59 @@ typedef struct {
     uint16_t entry_count;   // Number of entries (should be 365)
 } homebase_metadata_t;
 
-// Include the generated table with static inline accessor functions
-#include "homebase_table.h"
+/*
+ * Compact encoding: each field keeps its exact value every
+ * HOMEBASE_KNOT_SPACING days (plus day 365), and a small signed
+ * residual per day against the straight line between those knots.
+ * Seasonal curves bend slowly, so the residuals fit in a few bits.
+ */
+#define HOMEBASE_DAYS 365
+#define HOMEBASE_KNOT_SPACING 16
+#define HOMEBASE_KNOT_COUNT ((HOMEBASE_DAYS - 1) / HOMEBASE_KNOT_SPACING + 2)  // 24
+
+typedef struct {
+    int16_t knots[HOMEBASE_KNOT_COUNT];  // Values on days 1, 17, ..., 353, and 365
+    uint8_t residual_bits;               // 0-8; 0 means the line is exact
+    const uint8_t *residuals;            // Packed LSB first, one per day, plus a pad byte
+} homebase_field_t;
+
+typedef struct {
+    const char *name;
+    homebase_metadata_t metadata;
+    homebase_field_t daylight;           // expected_daylight_min
+    homebase_field_t temp;               // avg_temp_c10
+    homebase_field_t baseline;           // seasonal_baseline
+} homebase_preset_t;
+
+/**
+ * Look up the seasonal data for a day.
+ *
+ * @param day_of_year Day of year (1-365); anything else reads day 1
+ * @return Entry for the selected preset. Decoded into a shared buffer,
+ *         so it is only valid until the next call.
+ */
+const homebase_entry_t* homebase_get_entry(uint16_t day_of_year);
+
+/**
+ * Decode one day of a field. homebase_get_entry() is built on this.
+ */
+int16_t homebase_field_decode(const homebase_field_t *field, uint16_t day_index);
+
+const homebase_metadata_t* homebase_get_metadata(void);
+
+/**
+ * Presets built into this firmware. Preset 0 is selected at boot.
+ */
+uint8_t homebase_preset_count(void);
+const char* homebase_preset_name(uint8_t index);
+uint8_t homebase_get_preset(void);
+
+/**
+ * Switch location without reflashing.
+ *
+ * @return false (and no change) if there is no such preset
+ */
+bool homebase_select_preset(uint8_t index);
 
 #endif // PHASE_ENGINE_ENABLED
 
@@ -0,0 +1,40 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Adaptive metric cadence. See metric_cadence.h.
+ */
+
+#include "metric_cadence.h"
+
+#ifdef PHASE_ENGINE_ENABLED
+
+typedef struct {
+    uint8_t conditions;     // all of these must hold (0 always matches)
+    uint8_t interval;       // minutes
+} metric_cadence_rule_t;
+
+// First match wins, so the faster rules come first: a zone face checked in
+// the middle of the night still gets fresh values.
+static const metric_cadence_rule_t metric_cadence_policy[] = {
+    { METRIC_CADENCE_ZONE_FACE, 1 },        // the wearer is looking at the metrics
+    { METRIC_CADENCE_HIGH_MOTION, 1 },      // inputs are moving quickly
+    { METRIC_CADENCE_ASLEEP, 60 },          // nothing changes overnight
+    { 0, 15 },
+};
+
+uint8_t metric_cadence_interval(uint8_t conditions) {
+    for (uint8_t i = 0; i < sizeof(metric_cadence_policy) / sizeof(metric_cadence_policy[0]); i++) {
+        const metric_cadence_rule_t *rule = &metric_cadence_policy[i];
+        if ((conditions & rule->conditions) == rule->conditions) return rule->interval;
+    }
+    return 15;
+}
+
+bool metric_cadence_due(uint8_t interval, uint16_t minute_of_day, uint16_t minutes_since_run) {
+    if (interval <= 1 || minutes_since_run >= interval) return true;
+    return (minute_of_day % interval) == 0;
+}
+
+#endif // PHASE_ENGINE_ENABLED
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Adaptive metric cadence
+ *
+ * How often Movement runs sensors, phase and metrics. Every minute while a
+ * zone face is showing them or the wearer is moving a lot, hourly while
+ * they are confirmed asleep, and every quarter hour otherwise. The choice
+ * is a small policy table in metric_cadence.c: the first rule whose
+ * conditions all hold sets the interval.
+ *
+ * Runs land on clock multiples of the interval (:00, :15, ... or every
+ * minute), so the top of each hour always gets one.
+ */
+
+#ifndef METRIC_CADENCE_H_
+#define METRIC_CADENCE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PHASE_ENGINE_ENABLED
+
+// Motion variance (sensors_get_motion_variance(), mg²) at which metrics go
+// per-minute; EM reads 0-1000 as its full scale.
+#define METRIC_CADENCE_HIGH_MOTION_VARIANCE 500
+
+// Conditions the policy table keys on (bitmask)
+typedef enum {
+    METRIC_CADENCE_ZONE_FACE = (1 << 0),    // a zone face is in the foreground
+    METRIC_CADENCE_HIGH_MOTION = (1 << 1),  // motion variance at or above the threshold
+    METRIC_CADENCE_ASLEEP = (1 << 2),       // in the sleep window and confirmed still
+} metric_cadence_condition_t;
+
+/**
+ * @param conditions METRIC_CADENCE_* that hold right now
+ * @return Minutes between metric runs (1, 15 or 60; always divides 60)
+ */
+uint8_t metric_cadence_interval(uint8_t conditions);
+
+/**
+ * Whether metrics should run this minute.
+ * 
+ * @param interval From metric_cadence_interval()
+ * @param minute_of_day Local minute (0-1439)
+ * @param minutes_since_run Minutes since metrics last ran, counting this one
+ * @return true on a clock multiple of the interval, or if one was missed
+ */
+bool metric_cadence_due(uint8_t interval, uint16_t minute_of_day, uint16_t minutes_since_run);
+
+#endif // PHASE_ENGINE_ENABLED
+
+#endif // METRIC_CADENCE_H_
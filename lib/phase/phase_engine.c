@@ -15,50 +15,210 @@
 #ifdef PHASE_ENGINE_ENABLED
 
 #include "homebase.h"
+#include "solar.h"
+#include "circadian_score.h"
 #include "watch.h"
 #include <string.h>
 
 /*
- * Integer cosine lookup table (24 entries, one per hour)
+ * Integer cosine lookup table (96 entries, one per quarter hour)
  * Values scaled to ±1000 to preserve precision
- * cos(2π * (hour - 14) / 24) * 1000
- * Peak at hour 14 (2 PM), trough at hour 2 (2 AM)
+ * cos(2π * (minute - 20:00) / 24h) * 1000: high at 20:00, low at 08:00.
+ * phase_circadian_curve() interpolates between entries to the minute.
  */
-static const int16_t cosine_lut_24[24] = {
-    500,   // 00:00
-    259,   // 01:00
-    0,     // 02:00 (TROUGH)
-    -259,  // 03:00
-    -500,  // 04:00
-    -707,  // 05:00
-    -866,  // 06:00
-    -966,  // 07:00
-    -1000, // 08:00
-    -966,  // 09:00
-    -866,  // 10:00
-    -707,  // 11:00
-    -500,  // 12:00
-    -259,  // 13:00
-    0,     // 14:00 (PEAK)
-    259,   // 15:00
-    500,   // 16:00
-    707,   // 17:00
-    866,   // 18:00
-    966,   // 19:00
-    1000,  // 20:00
-    966,   // 21:00
-    866,   // 22:00
-    707    // 23:00
+static const int16_t cosine_lut_96[96] = {
+      500,   442,   383,   321,   259,   195,   131,    65,   // 00:00-01:45
+        0,   -65,  -131,  -195,  -259,  -321,  -383,  -442,   // 02:00-03:45
+     -500,  -556,  -609,  -659,  -707,  -752,  -793,  -831,   // 04:00-05:45
+     -866,  -897,  -924,  -947,  -966,  -981,  -991,  -998,   // 06:00-07:45
+    -1000,  -998,  -991,  -981,  -966,  -947,  -924,  -897,   // 08:00-09:45
+     -866,  -831,  -793,  -752,  -707,  -659,  -609,  -556,   // 10:00-11:45
+     -500,  -442,  -383,  -321,  -259,  -195,  -131,   -65,   // 12:00-13:45
+        0,    65,   131,   195,   259,   321,   383,   442,   // 14:00-15:45
+      500,   556,   609,   659,   707,   752,   793,   831,   // 16:00-17:45
+      866,   897,   924,   947,   966,   981,   991,   998,   // 18:00-19:45
+     1000,   998,   991,   981,   966,   947,   924,   897,   // 20:00-21:45
+      866,   831,   793,   752,   707,   659,   609,   556    // 22:00-23:45
 };
 
+// i / 15 in Q16, for interpolating within a quarter hour.
+static const uint16_t quarter_weights[15] = {
+    0, 4369, 8738, 13107, 17476, 21845, 26214, 30583, 34953, 39322, 43691, 48060, 52429, 56798, 61167
+};
+
+// What phase_history_save() keeps; the running sums are rebuilt on load.
+typedef struct {
+    uint32_t hour_stamp;            // Unix time / 3600 when saved
+    uint8_t history[PHASE_HISTORY_HOURS];
+    uint8_t history_index;
+    uint8_t history_count;
+    uint16_t ewma[PHASE_WINDOW_COUNT];
+} phase_history_record_t;
+
+static const uint8_t phase_windows[PHASE_WINDOW_COUNT] = PHASE_WINDOWS;
+static const uint8_t phase_spans[PHASE_SPAN_COUNT] = PHASE_SPANS;
+
+static watch_storage_log_t phase_log;
+static bool phase_log_open = false;
+
+// Opening scans the whole log, so saves reuse the last open; loads rescan.
+static bool phase_log_ready(bool rescan) {
+    if (rescan || !phase_log_open) {
+        phase_log_open = watch_storage_log_open(&phase_log, PHASE_STORAGE_LOG,
+                                                sizeof(phase_history_record_t), PHASE_STORAGE_LOG_ROWS);
+    }
+    return phase_log_open;
+}
+
+static int8_t _span_index(uint8_t hours) {
+    for (uint8_t i = 0; i < PHASE_SPAN_COUNT; i++) {
+        if (phase_spans[i] == hours) return i;
+    }
+    return -1;
+}
+
+static int8_t _window_index(uint8_t hours) {
+    for (uint8_t i = 0; i < PHASE_WINDOW_COUNT; i++) {
+        if (phase_windows[i] == hours) return i;
+    }
+    return -1;
+}
+
+// Ring slot of the hour `age` hours before the newest.
+static inline uint8_t _history_slot(const phase_state_t *state, uint8_t age) {
+    return (state->history_index + PHASE_HISTORY_HOURS - age) % PHASE_HISTORY_HOURS;
+}
+
+// Close the hour in progress and open a fresh, empty slot for the next one.
+static void _history_advance(phase_state_t *state) {
+    if (state->history_count > 0) {
+        // Fold the finished hour into the EWMAs (the first one seeds them).
+        int32_t finished = (int32_t)state->phase_history[state->history_index] << 8;
+        for (uint8_t i = 0; i < PHASE_WINDOW_COUNT; i++) {
+            int32_t ewma = (state->history_count > 1) ? state->ewma[i] : finished;
+            state->ewma[i] = (uint16_t)(ewma + (finished - ewma) * 2 / (phase_windows[i] + 1));
+        }
+        state->history_index = (state->history_index + 1) % PHASE_HISTORY_HOURS;
+    }
+    if (state->history_count < PHASE_HISTORY_HOURS) state->history_count++;
+    
+    // Each span loses the hour that just aged out of it (zero while the ring fills).
+    for (uint8_t i = 0; i < PHASE_SPAN_COUNT; i++) {
+        state->span_sum[i] -= state->phase_history[_history_slot(state, phase_spans[i])];
+    }
+    for (uint8_t i = 0; i < PHASE_WINDOW_COUNT; i++) {
+        uint8_t leaving = state->phase_history[_history_slot(state, phase_windows[i])];
+        state->window_sum_sq[i] -= (uint16_t)leaving * leaving;
+    }
+    
+    state->phase_history[state->history_index] = 0;
+    state->hour_sum = 0;
+    state->hour_samples = 0;
+}
+
+// Close the hour in progress and open `hours` new slots; the hours skipped on
+// the way had no scores and read as zero. A day or more leaves nothing worth
+// keeping, so the ring starts over.
+static void _history_skip(phase_state_t *state, uint16_t hours) {
+    if (hours >= PHASE_HISTORY_HOURS) {
+        memset(state->phase_history, 0, sizeof(state->phase_history));
+        memset(state->span_sum, 0, sizeof(state->span_sum));
+        memset(state->window_sum_sq, 0, sizeof(state->window_sum_sq));
+        memset(state->ewma, 0, sizeof(state->ewma));
+        state->history_index = 0;
+        state->history_count = 0;
+        hours = 1;
+    }
+    while (hours-- > 0) _history_advance(state);
+}
+
+// Whole hours since the last score, at least one (the clock may have gone back).
+static uint16_t _hours_since_last(const phase_state_t *state, uint8_t hour, uint16_t day_of_year) {
+    int32_t hours = ((int32_t)day_of_year - state->last_day_of_year) * 24 + hour - state->last_hour;
+    if (hours < 0) hours += 365 * 24;   // across New Year
+    if (hours < 1) return 1;
+    return (hours > PHASE_HISTORY_HOURS) ? PHASE_HISTORY_HOURS : (uint16_t)hours;
+}
+
+// Average a score into the hour in progress, adjusting every sum by the change.
+static void _history_add_score(phase_state_t *state, uint8_t score) {
+    if (state->hour_samples == UINT8_MAX) {
+        // Called far more often than every 15 minutes; keep the mean, halve the weight.
+        state->hour_sum /= 2;
+        state->hour_samples /= 2;
+    }
+    state->hour_sum += score;
+    state->hour_samples++;
+    
+    uint8_t old_mean = state->phase_history[state->history_index];
+    uint8_t new_mean = (state->hour_sum + state->hour_samples / 2) / state->hour_samples;
+    
+    for (uint8_t i = 0; i < PHASE_SPAN_COUNT; i++) {
+        state->span_sum[i] += new_mean - old_mean;
+    }
+    for (uint8_t i = 0; i < PHASE_WINDOW_COUNT; i++) {
+        state->window_sum_sq[i] += (uint16_t)new_mean * new_mean;
+        state->window_sum_sq[i] -= (uint16_t)old_mean * old_mean;
+    }
+    state->phase_history[state->history_index] = new_mean;
+}
+
 void phase_engine_init(phase_state_t *state) {
     // Clear all state
     memset(state, 0, sizeof(phase_state_t));
     state->initialized = true;
 }
 
+int16_t phase_circadian_curve(uint16_t minute_of_day) {
+    if (minute_of_day >= 1440) minute_of_day -= 1440;
+    // minute_of_day / 15 and % 15, without a divide: 4370 / 65536 is a hair
+    // over 1/15, exact for 0-1439.
+    uint8_t quarter = ((uint32_t)minute_of_day * 4370) >> 16;
+    uint8_t within = minute_of_day - quarter * 15;
+    int16_t from = cosine_lut_96[quarter];
+    if (within == 0) return from;
+    
+    int16_t to = cosine_lut_96[quarter < 95 ? quarter + 1 : 0];
+    return from + (int16_t)(((int32_t)(to - from) * quarter_weights[within] + 32768) >> 16);
+}
+
+int16_t phase_learn_acrophase(phase_state_t *state, const circadian_data_t *sleep_data, int32_t utc_offset) {
+    int32_t shift_sum = 0;
+    uint8_t nights = 0;
+    
+    for (uint8_t i = 0; i < 7; i++) {
+        const circadian_sleep_night_t *night = &sleep_data->nights[i];
+        if (!night->valid || night->offset_timestamp <= night->onset_timestamp ||
+            night->offset_timestamp - night->onset_timestamp > 16 * 3600) {
+            continue;
+        }
+        
+        // Local minute of the sleep midpoint, relative to the reference one,
+        // wrapped to within ±12 hours.
+        uint32_t midpoint = night->onset_timestamp + (night->offset_timestamp - night->onset_timestamp) / 2;
+        int32_t local_min = ((midpoint + (uint32_t)(utc_offset + 86400)) % 86400) / 60;
+        int32_t shift = local_min - PHASE_REFERENCE_SLEEP_MIDPOINT_MIN;
+        if (shift >= 720) shift -= 1440;
+        if (shift < -720) shift += 1440;
+        
+        shift_sum += shift;
+        nights++;
+    }
+    
+    int32_t offset = 0;
+    if (nights >= PHASE_ACROPHASE_MIN_NIGHTS) {
+        offset = shift_sum / nights;
+        if (offset > PHASE_ACROPHASE_MAX_SHIFT_MIN) offset = PHASE_ACROPHASE_MAX_SHIFT_MIN;
+        if (offset < -PHASE_ACROPHASE_MAX_SHIFT_MIN) offset = -PHASE_ACROPHASE_MAX_SHIFT_MIN;
+    }
+    state->acrophase_offset_min = (int16_t)offset;
+    
+    return state->acrophase_offset_min;
+}
+
 uint16_t phase_compute(phase_state_t *state,
                        uint8_t hour,
+                       uint8_t minute,
                        uint16_t day_of_year,
                        uint16_t activity_level,
                        int16_t temp_c10,
@@ -69,11 +229,14 @@ uint16_t phase_compute(phase_state_t *state,
     }
     
     // Input validation (from PR #56)
-    if (hour > 23 || day_of_year < 1 || day_of_year > 366) {
+    if (hour > 23 || minute > 59 || day_of_year < 1 || day_of_year > 366) {
         return 0;  // Invalid input
     }
     
-    if (activity_level > 1000) {
+    bool activity_sensed = (activity_level != PHASE_ACTIVITY_NONE);
+    if (!activity_sensed) {
+        activity_level = 0;
+    } else if (activity_level > 1000) {
         return 0;  // Invalid input
     }
     
@@ -83,16 +246,20 @@ uint16_t phase_compute(phase_state_t *state,
         return 0;  // Error - no baseline data
     }
     
-    // Calculate circadian curve (expected activity level at this hour)
-    // Peak at 14:00 (afternoon), trough at 02:00 (night)
-    int16_t circadian_curve = cosine_lut_24[hour];
+    // Calculate circadian curve (expected activity level at this minute),
+    // shifted by the wearer's own rhythm
+    int16_t minute_of_day = hour * 60 + minute - state->acrophase_offset_min;
+    if (minute_of_day < 0) minute_of_day += 1440;
+    int16_t circadian_curve = phase_circadian_curve((uint16_t)minute_of_day);
     
     // Expected activity: baseline * circadian_curve
     // baseline.seasonal_baseline is 0-100
     // circadian_curve is -1000 to +1000
     // Result scaled to 0-100 range
-    int16_t expected_activity = ((int32_t)baseline->seasonal_baseline * 
-                                 (1000 + circadian_curve)) / 2000;
+    // The product is 0-200000; / 2000 is done as (/ 16) * 8389 >> 20, which
+    // is exact over that range and needs no divide on the Cortex-M0+.
+    uint32_t weighted = (uint32_t)baseline->seasonal_baseline * (uint32_t)(1000 + circadian_curve);
+    int16_t expected_activity = ((weighted >> 4) * 8389) >> 20;
     
     // Activity deviation (scaled to 0-100 range)
     // activity_level is 0-1000, scale to 0-100
@@ -100,6 +267,22 @@ uint16_t phase_compute(phase_state_t *state,
     int16_t activity_dev = (actual_activity > expected_activity) 
                           ? (actual_activity - expected_activity)
                           : (expected_activity - actual_activity);
+    int16_t activity_penalty = activity_dev / 2;
+    
+    // Once this hour has a personal baseline, score how unusual the activity
+    // is for this wearer instead: 3 standard deviations out costs the same
+    // as the worst miss against the population curve.
+    // (Added first: that only touches the hour in progress, and keeps the
+    // z-score on its cached fast path.)
+    // Without a motion sensor there is nothing to learn from.
+    if (activity_sensed) {
+        activity_baseline_add(&state->baseline, hour, (uint8_t)actual_activity);
+        if (activity_baseline_ready(&state->baseline, hour)) {
+            int16_t z = activity_baseline_zscore(&state->baseline, hour, (uint8_t)actual_activity);
+            if (z < 0) z = -z;
+            activity_penalty = (z >= 300) ? 50 : z / 6;
+        }
+    }
     
     // Temperature deviation (scaled to 0-30 range)
     // Both are in celsius * 10
@@ -110,14 +293,22 @@ uint16_t phase_compute(phase_state_t *state,
     temp_dev = (temp_dev > 300) ? 30 : (temp_dev / 10);
     
     // Light deviation (simplified scoring)
-    // Use homebase daylight data to determine day/night
-    // Approximate sunrise: 12:00 - (daylight_min / 120) hours
-    // Approximate sunset: 12:00 + (daylight_min / 120) hours
-    uint16_t daylight_min = baseline->expected_daylight_min;
-    uint8_t sunrise_hour = 12 - (daylight_min / 120);
-    uint8_t sunset_hour = 12 + (daylight_min / 120);
-    
-    uint16_t expected_light = (hour >= sunrise_hour && hour < sunset_hour) ? 500 : 50;
+    // Day/night from today's sunrise and sunset (checked at half past the
+    // hour) once the wearer's location is known. Until then, approximate
+    // them from homebase daylight data:
+    // sunrise 12:00 - (daylight_min / 120) hours, sunset 12:00 + (daylight_min / 120) hours
+    bool is_daytime;
+    const solar_times_t *solar = solar_get_today();
+    if (solar != NULL) {
+        is_daytime = solar_is_daylight(solar, hour * 60 + 30);
+    } else {
+        uint16_t daylight_min = baseline->expected_daylight_min;
+        uint8_t sunrise_hour = 12 - (daylight_min / 120);
+        uint8_t sunset_hour = 12 + (daylight_min / 120);
+        is_daytime = (hour >= sunrise_hour && hour < sunset_hour);
+    }
+    
+    uint16_t expected_light = is_daytime ? 500 : 50;
     int32_t light_dev = (light_lux > expected_light)
                        ? ((int32_t)light_lux - (int32_t)expected_light)
                        : ((int32_t)expected_light - (int32_t)light_lux);
@@ -126,80 +317,61 @@ uint16_t phase_compute(phase_state_t *state,
     
     // Compute final phase score
     // Start at 100, subtract deviations
-    int16_t score = 100 - (activity_dev / 2) - temp_dev - light_dev;
+    int16_t score = 100 - activity_penalty - temp_dev - light_dev;
     
     // Clamp to valid range
     if (score < 0) score = 0;
     if (score > 100) score = 100;
     
+    // A new hour (or the first score since boot) opens a new history slot;
+    // until then the newest slot holds the running mean of this hour's scores.
+    bool new_hour = (state->hour_samples == 0 ||
+                     hour != state->last_hour ||
+                     day_of_year != state->last_day_of_year);
+    if (new_hour) {
+        _history_skip(state, (state->hour_samples == 0) ? 1 : _hours_since_last(state, hour, day_of_year));
+    }
+    _history_add_score(state, (uint8_t)score);
+    
     state->last_phase_score = (uint16_t)score;
     state->last_hour = hour;
     state->last_day_of_year = day_of_year;
     
-    // Update circular buffer
-    uint8_t old_score = state->phase_history[state->history_index];
-    state->phase_history[state->history_index] = (uint8_t)score;
-    
-    // Update cumulative sum with proper saturating arithmetic
-    // Saturating subtract
-    if (state->cumulative_phase >= old_score) {
-        state->cumulative_phase -= old_score;
-    } else {
-        state->cumulative_phase = 0;
-    }
-    
-    // Saturating add
-    uint32_t temp = (uint32_t)state->cumulative_phase + score;
-    if (temp > UINT16_MAX) {
-        state->cumulative_phase = UINT16_MAX;
-    } else {
-        state->cumulative_phase = (uint16_t)temp;
-    }
-    
-    // THEN increment index
-    state->history_index = (state->history_index + 1) % 24;
-    
     return (uint16_t)score;
 }
 
+// Sum of the newest `hours` hourly scores: a kept sum when there is one,
+// otherwise a walk back through the ring.
+static uint16_t _history_sum(const phase_state_t *state, uint8_t hours) {
+    int8_t span = _span_index(hours);
+    if (span >= 0) return state->span_sum[span];
+
+    uint16_t sum = 0;
+    for (uint8_t age = 0; age < hours; age++) {
+        sum += state->phase_history[_history_slot(state, age)];
+    }
+    return sum;
+}
+
 int16_t phase_get_trend(const phase_state_t *state, uint8_t hours) {
-    if (hours == 0 || hours > 24) {
+    if (hours == 0 || hours > PHASE_HISTORY_HOURS) {
         return 0;
     }
     
-    // Calculate average of first half vs second half
+    // Calculate average of newer half vs older half
     uint8_t half = hours / 2;
     if (half == 0) half = 1;
     
-    // Sum recent half (more recent)
-    int32_t recent_sum = 0;
-    uint8_t recent_count = 0;
-    
-    // Sum older half (earlier)
-    int32_t older_sum = 0;
-    uint8_t older_count = 0;
-    
-    // Work backwards from current position
-    int8_t idx = state->history_index - 1;
-    if (idx < 0) idx = 23;
-    
-    for (uint8_t i = 0; i < hours; i++) {
-        if (i < half) {
-            recent_sum += state->phase_history[idx];
-            recent_count++;
-        } else {
-            older_sum += state->phase_history[idx];
-            older_count++;
-        }
-        
-        idx--;
-        if (idx < 0) idx = 23;
-    }
-    
+    uint8_t recent_count = (state->history_count < half) ? state->history_count : half;
+    uint8_t total_count = (state->history_count < hours) ? state->history_count : hours;
+    uint8_t older_count = total_count - recent_count;
     if (recent_count == 0 || older_count == 0) {
         return 0;
     }
     
+    uint16_t recent_sum = _history_sum(state, half);
+    uint16_t older_sum = _history_sum(state, hours) - recent_sum;
+    
     // Calculate averages
     int16_t recent_avg = recent_sum / recent_count;
     int16_t older_avg = older_sum / older_count;
@@ -217,6 +389,108 @@ int16_t phase_get_trend(const phase_state_t *state, uint8_t hours) {
     return trend;
 }
 
+uint8_t phase_get_mean(const phase_state_t *state, uint8_t hours) {
+    if (hours == 0 || hours > PHASE_HISTORY_HOURS) return 0;
+    uint8_t count = (state->history_count < hours) ? state->history_count : hours;
+    if (count == 0) return 0;
+    
+    return (_history_sum(state, hours) + count / 2) / count;
+}
+
+uint16_t phase_get_variance(const phase_state_t *state, uint8_t hours) {
+    if (hours == 0 || hours > PHASE_HISTORY_HOURS) return 0;
+    uint8_t count = (state->history_count < hours) ? state->history_count : hours;
+    if (count == 0) return 0;
+    
+    uint32_t sum_sq;
+    int8_t window = _window_index(hours);
+    if (window >= 0) {
+        sum_sq = state->window_sum_sq[window];
+    } else {
+        sum_sq = 0;
+        for (uint8_t age = 0; age < hours; age++) {
+            uint8_t value = state->phase_history[_history_slot(state, age)];
+            sum_sq += (uint16_t)value * value;
+        }
+    }
+    
+    // n·Σx² - (Σx)², over n²
+    uint32_t sum = _history_sum(state, hours);
+    return (uint16_t)((sum_sq * count - sum * sum) / ((uint32_t)count * count));
+}
+
+uint8_t phase_get_ewma(const phase_state_t *state, uint8_t hours) {
+    int8_t window = _window_index(hours);
+    if (window < 0 || state->history_count == 0) {
+        return phase_get_mean(state, hours);
+    }
+    
+    // The completed hours' EWMA, plus one more step for the hour in progress.
+    int32_t current = (int32_t)state->phase_history[state->history_index] << 8;
+    int32_t ewma = (state->history_count > 1) ? state->ewma[window] : current;
+    ewma += (current - ewma) * 2 / (hours + 1);
+    
+    return (uint8_t)((ewma + 128) >> 8);
+}
+
+bool phase_history_save(const phase_state_t *state, uint32_t now) {
+    phase_history_record_t record;
+    
+    if (!phase_log_ready(false)) return false;
+    
+    memset(&record, 0, sizeof(record));
+    record.hour_stamp = now / 3600;
+    memcpy(record.history, state->phase_history, sizeof(record.history));
+    record.history_index = state->history_index;
+    record.history_count = state->history_count;
+    memcpy(record.ewma, state->ewma, sizeof(record.ewma));
+    
+    return watch_storage_log_append_async(&phase_log, &record, NULL, NULL);
+}
+
+bool phase_history_load(phase_state_t *state, uint32_t now) {
+    phase_history_record_t record;
+    
+    if (!phase_log_ready(true) || !watch_storage_log_read(&phase_log, 0, &record)) return false;
+    
+    // A day or more without a save means the watch was off; start over.
+    uint32_t hour_stamp = now / 3600;
+    if (record.hour_stamp > hour_stamp || hour_stamp - record.hour_stamp >= PHASE_HISTORY_HOURS) return false;
+    if (record.history_index >= PHASE_HISTORY_HOURS || record.history_count > PHASE_HISTORY_HOURS) return false;
+    
+    memcpy(state->phase_history, record.history, sizeof(state->phase_history));
+    state->history_index = record.history_index;
+    state->history_count = record.history_count;
+    memcpy(state->ewma, record.ewma, sizeof(state->ewma));
+    
+    // Slots never written must read as zero for the running sums.
+    for (uint8_t age = state->history_count; age < PHASE_HISTORY_HOURS; age++) {
+        state->phase_history[_history_slot(state, age)] = 0;
+    }
+    
+    // Rebuild the running sums once; from here on they are kept incrementally.
+    memset(state->span_sum, 0, sizeof(state->span_sum));
+    memset(state->window_sum_sq, 0, sizeof(state->window_sum_sq));
+    for (uint8_t age = 0; age < PHASE_HISTORY_HOURS; age++) {
+        uint8_t value = state->phase_history[_history_slot(state, age)];
+        for (uint8_t i = 0; i < PHASE_SPAN_COUNT; i++) {
+            if (age < phase_spans[i]) state->span_sum[i] += value;
+        }
+        for (uint8_t i = 0; i < PHASE_WINDOW_COUNT; i++) {
+            if (age < phase_windows[i]) state->window_sum_sq[i] += (uint16_t)value * value;
+        }
+    }
+    
+    // The next score starts a new hour rather than averaging into the saved one;
+    // any hours between the save and now are skipped first, so it lands in its own slot.
+    state->hour_sum = 0;
+    state->hour_samples = 0;
+    uint32_t elapsed = hour_stamp - record.hour_stamp;
+    if (elapsed > 1) _history_skip(state, (uint16_t)(elapsed - 1));
+    
+    return true;
+}
+
 uint8_t phase_get_recommendation(uint16_t phase_score, 
                                  uint8_t hour,
                                  bool active_hours_enabled,
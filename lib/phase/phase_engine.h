@@ -22,6 +22,9 @@
 
 #ifdef PHASE_ENGINE_ENABLED
 
+#include "circadian_score.h"
+#include "activity_baseline.h"
+
 // Anomaly flags (bitmask for active anomalies)
 typedef enum {
     ANOMALY_NONE = 0,
@@ -35,14 +38,46 @@ typedef enum {
     ANOMALY_COMFORT_LOW = (1 << 7)   // Comfort ≤ 30
 } anomaly_flags_t;
 
-// Phase engine state (≤64 bytes RAM budget)
+#define PHASE_HISTORY_HOURS 24
+#define PHASE_ACTIVITY_NONE UINT16_MAX      // phase_compute() activity when nothing measures it
+#define PHASE_STORAGE_LOG "phase"           // Flash storage log for the hourly history
+#define PHASE_STORAGE_LOG_ROWS 2            // Rows in its ring
+
+/*
+ * Rolling statistics are kept incrementally for these windows (in hours):
+ * trend, mean, variance and EWMA over them are O(1). Trend compares the
+ * newer half of a window with the older half, so each window's half
+ * (rounded down) must be listed in PHASE_SPANS too. Other lengths still
+ * work, by walking the history.
+ */
+#define PHASE_WINDOWS { 3, 6, 12, 24 }
+#define PHASE_WINDOW_COUNT 4
+#define PHASE_SPANS { 1, 3, 6, 12, 24 }     // Windows and their halves
+#define PHASE_SPAN_COUNT 5
+
+/*
+ * The circadian curve is shifted by the wearer's mean sleep midpoint,
+ * relative to a typical adult's (04:00 local), once a few nights are known.
+ */
+#define PHASE_REFERENCE_SLEEP_MIDPOINT_MIN (4 * 60)
+#define PHASE_ACROPHASE_MIN_NIGHTS 3
+#define PHASE_ACROPHASE_MAX_SHIFT_MIN 180
+
+// Phase engine state (~230 bytes)
 typedef struct {
     uint16_t last_phase_score;      // Most recent phase score (0-100)
     uint8_t last_hour;              // Last computed hour (0-23)
     uint16_t last_day_of_year;      // Last computed day (1-365), requires 9 bits
-    uint16_t cumulative_phase;      // Rolling 24h sum for trends
-    uint8_t phase_history[24];      // Hourly phase scores (circular buffer)
-    uint8_t history_index;          // Current position in circular buffer
+    uint8_t phase_history[PHASE_HISTORY_HOURS]; // Hourly mean phase scores (circular buffer)
+    uint8_t history_index;          // Slot of the newest hour (the one in progress)
+    uint8_t history_count;          // Hours recorded so far (0-24)
+    uint16_t hour_sum;              // Scores computed this hour, for its running mean
+    uint8_t hour_samples;
+    uint16_t span_sum[PHASE_SPAN_COUNT];        // Sum of the newest 1, 3, 6, 12, 24 hours
+    uint32_t window_sum_sq[PHASE_WINDOW_COUNT]; // Sum of squares over each window
+    uint16_t ewma[PHASE_WINDOW_COUNT];          // EWMA of completed hours, score x 256
+    int16_t acrophase_offset_min;   // Personal shift of the circadian curve (minutes, + = later)
+    activity_baseline_t baseline;   // Personal activity per hour of day; scores once learned
     uint8_t anomaly_flags;          // Active anomalies (bitmask)
     bool initialized;               // Has engine been initialized?
     uint16_t zone_check_streak;     // Consecutive days any zone face viewed
@@ -67,28 +102,105 @@ void phase_engine_init(phase_state_t *state);
  * 
  * @param state Engine state (updated in-place)
  * @param hour Current hour (0-23)
+ * @param minute Current minute (0-59); the circadian curve is interpolated to it
  * @param day_of_year Current day (1-365)
- * @param activity_level Recent activity (0-1000, arbitrary units)
+ * @param activity_level Recent activity (0-1000, arbitrary units). Scored
+ *        against the wearer's own baseline for the hour once it has
+ *        ACTIVITY_BASELINE_MIN_DAYS days, and against the circadian curve
+ *        until then. PHASE_ACTIVITY_NONE if there is no motion sensor: it
+ *        scores as 0 against the curve, and the baseline learns nothing.
  * @param temp_c10 Current temperature (celsius * 10)
  * @param light_lux Current light level (lux)
  * @return Phase score (0-100), higher = better alignment
  */
 uint16_t phase_compute(phase_state_t *state,
                        uint8_t hour,
+                       uint8_t minute,
                        uint16_t day_of_year,
                        uint16_t activity_level,
                        int16_t temp_c10,
                        uint16_t light_lux);
 
+/**
+ * Expected-activity curve, interpolated from a quarter-hour table.
+ * Exposed for tests.
+ * 
+ * @param minute_of_day 0-1439 (up to 2879 wraps once)
+ * @return cos(2π * (minute - 20:00) / 24h), scaled to ±1000
+ */
+int16_t phase_circadian_curve(uint16_t minute_of_day);
+
+/**
+ * Learn the wearer's shift of the circadian curve from the sleep midpoints
+ * of the last week's nights, and keep it in the state for phase_compute().
+ * Needs PHASE_ACROPHASE_MIN_NIGHTS valid nights; with fewer, the shift is 0.
+ * Call at boot and whenever a night is added.
+ * 
+ * @param sleep_data Last 7 nights
+ * @param utc_offset Seconds to add to UTC for local time
+ * @return Shift in minutes (±PHASE_ACROPHASE_MAX_SHIFT_MIN, + = later)
+ */
+int16_t phase_learn_acrophase(phase_state_t *state, const circadian_data_t *sleep_data, int32_t utc_offset);
+
 /**
  * Get phase trend over last N hours.
  * 
+ * O(1) for the PHASE_WINDOWS lengths; cheap enough for a face to call
+ * every tick.
+ * 
  * @param state Engine state
  * @param hours Number of hours to analyze (1-24)
  * @return Trend: -100 (declining) to +100 (improving)
  */
 int16_t phase_get_trend(const phase_state_t *state, uint8_t hours);
 
+/**
+ * Mean hourly phase score over the last N hours (fewer if the history is
+ * shorter). O(1) for the PHASE_SPANS lengths.
+ * 
+ * @param hours 1-24
+ * @return Mean score (0-100), or 0 with no history
+ */
+uint8_t phase_get_mean(const phase_state_t *state, uint8_t hours);
+
+/**
+ * Variance of the hourly phase scores over the last N hours.
+ * O(1) for the PHASE_WINDOWS lengths.
+ * 
+ * @param hours 1-24
+ * @return Variance in score² (0-2500)
+ */
+uint16_t phase_get_variance(const phase_state_t *state, uint8_t hours);
+
+/**
+ * Exponentially weighted mean of the hourly scores, with the smoothing of
+ * an N-hour moving average (alpha = 2 / (N + 1)), including the hour in
+ * progress.
+ * 
+ * @param hours One of PHASE_WINDOWS; any other length gets phase_get_mean()
+ * @return Smoothed score (0-100)
+ */
+uint8_t phase_get_ewma(const phase_state_t *state, uint8_t hours);
+
+/**
+ * Save the hourly history to the "phase" flash log (see watch_storage_log.h).
+ * Queued, so it returns at once; call it when a new hour starts.
+ * 
+ * @param now Current unix time
+ * @return false if the write couldn't be queued
+ */
+bool phase_history_save(const phase_state_t *state, uint32_t now);
+
+/**
+ * Restore the hourly history saved by phase_history_save(), if it is less
+ * than a day old; the hours between the save and now are left empty.
+ * Call once at boot, after phase_engine_init().
+ * 
+ * @param now Current unix time
+ * @return true if a history was restored
+ */
+bool phase_history_load(phase_state_t *state, uint32_t now);
+
 /**
  * Get recommended action based on current phase and active hours.
  * 
@@ -18,12 +18,19 @@
 #ifdef PHASE_ENGINE_ENABLED
 
 // Zone weight tables (stored in flash)
-// Columns: SD, EM, WK, Energy, Comfort (5 metrics, JL deferred to Phase 4)
-static const uint8_t zone_weights[4][5] = {
-    {30, 25,  5, 10, 30},  // EMERGENCE: SD + Comfort priority
-    {20, 20, 30, 10, 20},  // MOMENTUM: WK is key
-    {15, 20,  5, 40, 20},  // ACTIVE: Energy dominates
-    {10, 35,  0, 10, 45},  // DESCENT: EM + Comfort for wind-down
+// Columns: SD, EM, WK, Energy, Comfort, JL
+// JL only has relevance while re-entraining (see compute_jl_relevance), so its
+// column sits on top of the others rather than taking a share of each row.
+// PLAYLIST_TUNABLE_WEIGHTS moves them to RAM so the host replay driver can sweep them.
+#ifdef PLAYLIST_TUNABLE_WEIGHTS
+static uint8_t zone_weights[4][PLAYLIST_METRIC_COUNT] = {
+#else
+static const uint8_t zone_weights[4][PLAYLIST_METRIC_COUNT] = {
+#endif
+    {30, 25,  5, 10, 30, 30},  // EMERGENCE: SD + Comfort priority; jet lag shows on waking
+    {20, 20, 30, 10, 20, 20},  // MOMENTUM: WK is key
+    {15, 20,  5, 40, 20, 15},  // ACTIVE: Energy dominates
+    {10, 35,  0, 10, 45, 25},  // DESCENT: EM + Comfort for wind-down; jet lag before bed
 };
 
 // Default auto-advance interval (30 seconds = 30 ticks in 1Hz tick mode)
@@ -71,6 +78,20 @@ static uint8_t compute_relevance(uint8_t weight, uint8_t metric_value) {
     return (uint8_t)((weight * deviation) / 50);
 }
 
+/**
+ * Compute relevance for JL. JL is 100 when aligned, which is nothing to
+ * show, so only the distance below 100 counts: half as strong as the
+ * other metrics' distance from neutral, full weight at JL 0.
+ * 
+ * @param weight Zone weight for JL (0-100)
+ * @param jl JL value (0-100)
+ * @return Relevance score (0-100)
+ */
+static uint8_t compute_jl_relevance(uint8_t weight, uint8_t jl) {
+    if (jl > 100) jl = 100;
+    return compute_relevance(weight, 50 + (100 - jl) / 2);
+}
+
 /**
  * Rebuild face rotation based on current zone and metrics.
  * Computes relevance for each metric, sorts by relevance (descending),
@@ -84,16 +105,17 @@ static void rebuild_rotation(playlist_state_t *state,
     uint8_t zone = state->zone;
     
     // Compute relevance for each metric
-    uint8_t relevances[5];
+    uint8_t relevances[PLAYLIST_METRIC_COUNT];
     relevances[0] = compute_relevance(zone_weights[zone][0], metrics->sd);
     relevances[1] = compute_relevance(zone_weights[zone][1], metrics->em);
     relevances[2] = compute_relevance(zone_weights[zone][2], metrics->wk);
     relevances[3] = compute_relevance(zone_weights[zone][3], metrics->energy);
     relevances[4] = compute_relevance(zone_weights[zone][4], metrics->comfort);
+    relevances[5] = compute_jl_relevance(zone_weights[zone][5], metrics->jl);
     
     // Build list of metrics that meet relevance threshold
     state->face_count = 0;
-    for (uint8_t i = 0; i < 5; i++) {
+    for (uint8_t i = 0; i < PLAYLIST_METRIC_COUNT; i++) {
         if (relevances[i] >= MIN_RELEVANCE) {
             state->face_indices[state->face_count++] = i;
         }
@@ -189,4 +211,11 @@ phase_zone_t playlist_get_zone(const playlist_state_t *state) {
     return (phase_zone_t)state->zone;
 }
 
+#ifdef PLAYLIST_TUNABLE_WEIGHTS
+void playlist_set_zone_weight(phase_zone_t zone, uint8_t metric, uint8_t weight) {
+    if (zone > ZONE_DESCENT || metric >= PLAYLIST_METRIC_COUNT) return;
+    zone_weights[zone][metric] = weight;
+}
+#endif
+
 #endif // PHASE_ENGINE_ENABLED
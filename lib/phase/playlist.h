@@ -47,11 +47,14 @@ typedef enum {
     ZONE_DESCENT = 3     // 76-100: Winding down
 } phase_zone_t;
 
+// Metrics the playlist rotates through: SD, EM, WK, Energy, Comfort, JL
+#define PLAYLIST_METRIC_COUNT 6
+
 // Playlist state (manages face rotation)
 typedef struct {
     uint8_t zone;                    // Current zone (0-3)
     uint8_t face_count;              // Faces in rotation (0-6)
-    uint8_t face_indices[6];         // Sorted by relevance (metric indices)
+    uint8_t face_indices[PLAYLIST_METRIC_COUNT]; // Sorted by relevance (metric indices)
     uint8_t current_face;            // Index into face_indices
     uint16_t dwell_ticks;            // Time on current face
     uint16_t dwell_limit;            // Auto-advance threshold (ticks)
@@ -83,7 +86,7 @@ void playlist_update(playlist_state_t *state, uint16_t phase_score,
  * Get current face index from playlist.
  * 
  * @param state Playlist state
- * @return Metric index for current face (0-4: SD, EM, WK, Energy, Comfort)
+ * @return Metric index for current face (0-5: SD, EM, WK, Energy, Comfort, JL)
  */
 uint8_t playlist_get_current_face(const playlist_state_t *state);
 
@@ -103,6 +106,18 @@ void playlist_advance(playlist_state_t *state);
  */
 phase_zone_t playlist_get_zone(const playlist_state_t *state);
 
+#ifdef PLAYLIST_TUNABLE_WEIGHTS
+/**
+ * Override one zone weight. Only built for tuning runs (the host replay
+ * driver); the firmware keeps the table in flash.
+ *
+ * @param zone Zone whose row to change
+ * @param metric Column (0-5: SD, EM, WK, Energy, Comfort, JL)
+ * @param weight New weight (0-100)
+ */
+void playlist_set_zone_weight(phase_zone_t zone, uint8_t metric, uint8_t weight);
+#endif
+
 #endif // PHASE_ENGINE_ENABLED
 
 #endif // PLAYLIST_H_
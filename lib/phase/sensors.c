@@ -26,20 +26,50 @@
 
 #include "sensors.h"
 #include "lis2dw.h"
+#include "thermistor_driver.h"
 #include "watch.h"
+#include "watch_utility.h"
 #include "movement.h"
 #include <string.h>
 #include <stdlib.h>
 
-static uint16_t _compute_variance(const uint16_t *buffer, uint8_t count);
+#define SENSOR_ADC_BITS (SENSOR_BIT(SENSOR_LUX) | SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_VCC))
+#define SENSOR_TEMPERATURE_BITS (SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_LIS2DW_TEMP))
+
+// Minutes between samples, by context; each divides 60. Awake and in the
+// sleep window, temperature and motion keep the quarter-hour metric cadence
+// and lux the per-minute sample that light exposure counts on. Confirmed
+// asleep, nothing needs more than a check every quarter hour. A zone face
+// shows live numbers, so everything it reads goes per-minute.
+static const uint8_t _sensor_intervals[SENSOR_COUNT][SENSOR_CONTEXT_COUNT] = {
+    //                      awake  window  asleep  zone face
+    [SENSOR_LUX]         = {    1,      5,     15,        1 },
+    [SENSOR_THERMISTOR]  = {   15,     15,     60,        1 },
+    [SENSOR_LIS2DW_TEMP] = {   15,     15,     60,        1 },
+    [SENSOR_VCC]         = {   60,     60,     60,       60 },
+    [SENSOR_MOTION]      = {   15,     15,     60,        1 },
+};
+
+static void _sample(struct sensor_state_t *state, uint8_t sensors, uint8_t motion_elapsed_min);
+static void _sample_motion(struct sensor_state_t *state, uint8_t elapsed_min);
+static void _sample_adc(struct sensor_state_t *state, uint8_t sensors);
+#if HAS_LIGHT_SENSOR
+static void _add_lux(struct sensor_state_t *state, uint16_t raw);
+#endif
+static void _set_temperature(struct sensor_state_t *state, int16_t temp_c100);
+static uint8_t _present(const struct sensor_state_t *state);
+static uint16_t _motion_weight(uint16_t keep_q16, uint8_t minutes);
 static uint16_t _compute_intensity(uint16_t current_mag, uint16_t prev_smoothed);
 static uint16_t _abs16(int16_t val);
+static uint8_t _count_activity(struct sensor_state_t *state, const lis2dw_reading_t *readings, uint8_t count);
 
-void sensors_init(struct sensor_state_t *state, bool has_accel) {
+void sensors_init(struct sensor_state_t *state, bool has_accel, bool has_thermistor) {
     memset(state, 0, sizeof(struct sensor_state_t));
     state->has_accelerometer = has_accel;
     
     // Note: Thermistor initialization is handled by Movement
+    state->has_thermistor = has_thermistor;
+    state->temperature_c10 = 200;  // 20.0°C until a sensor says otherwise
     
     state->initialized = true;
 }
@@ -60,15 +90,142 @@ void sensors_configure_accel(struct sensor_state_t *state) {
     lis2dw_configure_int1(LIS2DW_CTRL4_INT1_WU);
 }
 
-void sensors_update(struct sensor_state_t *state) {
+void sensors_update(struct sensor_state_t *state, uint8_t elapsed_min) {
     if (!state || !state->initialized) {
         return;
     }
     
+    _sample(state, _present(state) & ~SENSOR_BIT(SENSOR_VCC), elapsed_min);
+}
+
+// ============================================================================
+// Sensor Scheduler
+// ============================================================================
+
+uint8_t sensors_schedule_tick(struct sensor_state_t *state, sensor_context_t context, uint16_t minute_of_day) {
+    if (!state || !state->initialized) {
+        return 0;
+    }
+    if (context >= SENSOR_CONTEXT_COUNT) {
+        context = SENSOR_CONTEXT_AWAKE;
+    }
+    
+    uint8_t hour = (uint8_t)(minute_of_day / 60);
+    if (hour != state->stats_hour) {
+        memcpy(state->last_hour_samples, state->hour_samples, sizeof(state->hour_samples));
+        memset(state->hour_samples, 0, sizeof(state->hour_samples));
+        state->stats_hour = hour;
+    }
+    
+    uint8_t present = _present(state);
+    uint8_t due = 0;
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        if (state->minutes_since[i] < UINT8_MAX) {
+            state->minutes_since[i]++;
+        }
+        uint8_t interval = _sensor_intervals[i][context];
+        if (!(present & SENSOR_BIT(i)) || interval == 0) {
+            continue;
+        }
+        // On a clock multiple of the rate, or overdue after a switch to a faster one
+        if (!state->schedule_started || minute_of_day % interval == 0 || state->minutes_since[i] >= interval) {
+            due |= SENSOR_BIT(i);
+        }
+    }
+    
+    uint8_t motion_elapsed = state->schedule_started ? state->minutes_since[SENSOR_MOTION] : 1;
+    state->schedule_started = true;
+    _sample(state, due, motion_elapsed);
+    
+    return due;
+}
+
+uint8_t sensors_schedule_interval(sensor_id_t sensor, sensor_context_t context) {
+    if (sensor >= SENSOR_COUNT || context >= SENSOR_CONTEXT_COUNT) {
+        return 0;
+    }
+    return _sensor_intervals[sensor][context];
+}
+
+uint8_t sensors_get_hourly_samples(const struct sensor_state_t *state, sensor_id_t sensor) {
+    return (state && sensor < SENSOR_COUNT) ? state->last_hour_samples[sensor] : 0;
+}
+
+uint16_t sensors_get_vcc_mv(const struct sensor_state_t *state) {
+    return state ? state->vcc_mv : 0;
+}
+
+static void _sample(struct sensor_state_t *state, uint8_t sensors, uint8_t motion_elapsed_min) {
+    if (sensors & SENSOR_ADC_BITS) {
+        _sample_adc(state, sensors);
+    }
+    if (sensors & SENSOR_BIT(SENSOR_LIS2DW_TEMP)) {
+        _set_temperature(state, watch_utility_lis2dw_temperature_c100(lis2dw_get_temperature()));
+    }
+    if (sensors & SENSOR_BIT(SENSOR_MOTION)) {
+        _sample_motion(state, motion_elapsed_min);
+    }
+    
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        if (sensors & SENSOR_BIT(i)) {
+            state->minutes_since[i] = 0;
+            if (state->hour_samples[i] < UINT8_MAX) {
+                state->hour_samples[i]++;
+            }
+        }
+    }
+}
+
+// One ADC power-up for every ADC reader due. thermistor_driver_enable() starts
+// the ADC along with the divider and thermistor_driver_disable() stops it, so
+// when the thermistor is due they bracket the window.
+static void _sample_adc(struct sensor_state_t *state, uint8_t sensors) {
+    bool thermistor = (sensors & SENSOR_BIT(SENSOR_THERMISTOR)) != 0;
+    
+    if (thermistor) {
+        thermistor_driver_enable();
+    } else {
+        watch_enable_adc();
+    }
+    
+#if HAS_LIGHT_SENSOR
+    if (sensors & SENSOR_BIT(SENSOR_LUX)) {
+        // Read ambient light from A2 pin (light sensor on Pro board)
+        _add_lux(state, watch_get_analog_pin_level(HAL_GPIO_A2_pin()));
+    }
+#endif
+    if (sensors & SENSOR_BIT(SENSOR_VCC)) {
+        state->vcc_mv = watch_get_vcc_voltage();
+    }
+    
+    if (thermistor) {
+        _set_temperature(state, thermistor_driver_get_temperature_c100());
+        thermistor_driver_disable();
+    } else {
+        watch_disable_adc();
+    }
+}
+
+static uint8_t _present(const struct sensor_state_t *state) {
+    uint8_t present = SENSOR_BIT(SENSOR_VCC);
+#if HAS_LIGHT_SENSOR
+    present |= SENSOR_BIT(SENSOR_LUX);
+#endif
+    if (state->has_thermistor) {
+        present |= SENSOR_BIT(SENSOR_THERMISTOR);
+    } else if (state->has_accelerometer) {
+        present |= SENSOR_BIT(SENSOR_LIS2DW_TEMP);
+    }
+    if (state->has_accelerometer) {
+        present |= SENSOR_BIT(SENSOR_MOTION);
+    }
+    return present;
+}
+
+static void _sample_motion(struct sensor_state_t *state, uint8_t elapsed_min) {
     // PR #65: Update motion tracking
     if (!state->has_accelerometer) {
         state->motion_active = false;
-        state->motion_variance = 0;
         state->motion_intensity = 0;
         state->motion_magnitude = 0;
     } else {
@@ -80,68 +237,125 @@ void sensors_update(struct sensor_state_t *state) {
             state->motion_active = true;
             state->inactivity_minutes = 0;
             
-            // Phase 4E: Count movement interrupt for sleep tracking
-            if (state->epoch_movement_count < 255) {
-                state->epoch_movement_count++;
-            }
-            if (state->hourly_movement_count < 255) {
-                state->hourly_movement_count++;
+            // Phase 4E: Count movement interrupt for sleep tracking. While batching,
+            // sensors_drain_fifo() counts moving samples instead.
+            if (!state->batching) {
+                if (state->epoch_movement_count < 255) {
+                    state->epoch_movement_count++;
+                }
+                if (state->hourly_movement_count < 255) {
+                    state->hourly_movement_count++;
+                }
             }
         } else if (is_sleeping) {
-            state->inactivity_minutes += 15;
+            uint16_t inactive = state->inactivity_minutes + elapsed_min;
+            state->inactivity_minutes = (inactive > UINT8_MAX) ? UINT8_MAX : (uint8_t)inactive;
             if (state->inactivity_minutes >= SENSOR_INACTIVITY_MIN) {
                 state->motion_active = false;
             }
         }
         
-        lis2dw_reading_t raw = lis2dw_get_raw_reading();
-        uint16_t mag = _abs16(raw.x) + _abs16(raw.y) + _abs16(raw.z);
-        
-        state->motion_buffer[state->motion_buf_idx] = mag;
-        state->motion_buf_idx = (state->motion_buf_idx + 1) % SENSOR_MOTION_BUFFER_SIZE;
-        if (state->motion_buf_count < SENSOR_MOTION_BUFFER_SIZE) {
-            state->motion_buf_count++;
+        // While batching, the last drained sample is at most 15 s old; no need for another read.
+        lis2dw_reading_t raw;
+        if (state->batching && state->batch_last_valid) {
+            raw = (lis2dw_reading_t){ state->batch_last[0], state->batch_last[1], state->batch_last[2] };
+        } else {
+            raw = lis2dw_get_raw_reading();
         }
+        uint16_t mag = _abs16(raw.x) + _abs16(raw.y) + _abs16(raw.z);
         
         state->motion_magnitude = mag;
-        state->motion_variance = _compute_variance(state->motion_buffer, state->motion_buf_count);
+        sensors_motion_stats_add(&state->motion_stats, mag, elapsed_min);
         state->motion_intensity = _compute_intensity(mag, state->motion_intensity);
     }
     
-    // PR #66: Update lux + temperature
-    sensors_sample_lux(state);
-    sensors_sample_temperature(state);
 }
 
 uint16_t sensors_get_motion_variance(const struct sensor_state_t *state) {
-    return state ? state->motion_variance : 0;
+    return sensors_get_motion_variance_over(state, SENSOR_MOTION_SHORT);
+}
+
+uint16_t sensors_get_motion_variance_over(const struct sensor_state_t *state, sensor_motion_horizon_t horizon) {
+    return state ? sensors_motion_stats_variance(&state->motion_stats, horizon) : 0;
 }
 
 uint16_t sensors_get_motion_intensity(const struct sensor_state_t *state) {
     return state ? state->motion_intensity : 0;
 }
 
+uint16_t sensors_get_activity_level(const struct sensor_state_t *state) {
+    uint16_t variance = sensors_get_motion_variance(state);
+
+    // integer square root: the variance is at most 65535 mg², so 8 bits of result.
+    uint16_t sd_mg = 0;
+    for (uint16_t bit = 0x80; bit; bit >>= 1) {
+        uint16_t trial = sd_mg | bit;
+        if ((uint32_t)trial * trial <= variance) sd_mg = trial;
+    }
+
+    uint32_t level = (uint32_t)sd_mg * 1000 / SENSOR_ACTIVITY_FULL_SCALE_MG;
+    return (level > 1000) ? 1000 : (uint16_t)level;
+}
+
 bool sensors_is_motion_active(const struct sensor_state_t *state) {
     return state ? state->motion_active : false;
 }
 
-static uint16_t _compute_variance(const uint16_t *buffer, uint8_t count) {
-    if (count < 2) return 0;
-    
-    uint32_t sum = 0;
-    for (uint8_t i = 0; i < count; i++) {
-        sum += buffer[i];
+// (1 - 1/tau) per minute in Q16, from the time constants in sensors.h.
+static const uint16_t _motion_keep_q16[SENSOR_MOTION_HORIZON_COUNT] = {
+    65536 - 65536 / SENSOR_MOTION_TAU_SHORT_MIN,
+    65536 - 65536 / SENSOR_MOTION_TAU_LONG_MIN,
+};
+
+// Weight of a sample standing for `minutes` one-minute samples, 1 - keep^minutes,
+// in Q12. Square-and-multiply, so at most eight rounds for any gap.
+static uint16_t _motion_weight(uint16_t keep_q16, uint8_t minutes) {
+    uint32_t keep = 65536;
+    uint32_t base = keep_q16;
+
+    if (minutes == 0) minutes = 1;
+    while (minutes) {
+        if (minutes & 1) keep = (keep * base) >> 16;
+        base = (base * base) >> 16;
+        minutes >>= 1;
     }
-    uint16_t mean = (uint16_t)(sum / count);
-    
-    uint32_t sq_sum = 0;
-    for (uint8_t i = 0; i < count; i++) {
-        int32_t diff = (int32_t)buffer[i] - (int32_t)mean;
-        sq_sum += (uint32_t)(diff * diff);
+
+    uint32_t weight = (65536 - keep + 8) >> 4;
+    return (weight > SENSOR_MOTION_MAX_WEIGHT) ? SENSOR_MOTION_MAX_WEIGHT : (uint16_t)weight;
+}
+
+void sensors_motion_stats_add(sensor_motion_stats_t *stats, uint16_t magnitude, uint8_t elapsed_min) {
+    if (!stats->seeded) {
+        for (uint8_t h = 0; h < SENSOR_MOTION_HORIZON_COUNT; h++) {
+            stats->mean[h] = magnitude;
+            stats->variance[h] = 0;
+        }
+        stats->seeded = true;
+        return;
     }
-    
-    uint32_t var = sq_sum / count;
-    return (var > UINT16_MAX) ? UINT16_MAX : (uint16_t)var;
+
+    for (uint8_t h = 0; h < SENSOR_MOTION_HORIZON_COUNT; h++) {
+        // mean += a·d; var = (1 - a)·(var + d·a·d), with d against the old mean.
+        int32_t weight = _motion_weight(_motion_keep_q16[h], elapsed_min);
+        int32_t diff = (int32_t)magnitude - stats->mean[h];
+        // A swing past 2 g between samples is a knock, not a gesture; clamping it keeps d·a·d in 32 bits.
+        if (diff > INT16_MAX) diff = INT16_MAX;
+        if (diff < -INT16_MAX) diff = -INT16_MAX;
+        int32_t step = diff * weight / 4096;
+        stats->mean[h] = (uint16_t)(stats->mean[h] + step);
+
+        // diff·step is (mg x 16)², so >> 4 leaves mg² x 16. Capping at 0xFFFFF
+        // (65535 mg²) keeps var·a below 2^32.
+        uint32_t variance = stats->variance[h] + ((uint32_t)(diff * step) >> 4);
+        if (variance > 0xFFFFF) variance = 0xFFFFF;
+        variance -= (variance * (uint32_t)weight) >> 12;
+        stats->variance[h] = variance;
+    }
+}
+
+uint16_t sensors_motion_stats_variance(const sensor_motion_stats_t *stats, sensor_motion_horizon_t horizon) {
+    if (horizon >= SENSOR_MOTION_HORIZON_COUNT) return 0;
+    return (uint16_t)(stats->variance[horizon] >> 4);
 }
 
 static uint16_t _compute_intensity(uint16_t current_mag, uint16_t prev_smoothed) {
@@ -167,13 +381,25 @@ void sensors_sample_lux(struct sensor_state_t *state) {
     
 #if HAS_LIGHT_SENSOR
     // Pro board: sample ADC, update rolling average
-    watch_enable_adc();
-    
-    // Read ambient light from A2 pin (light sensor on Pro board)
-    uint16_t raw = watch_get_analog_pin_level(HAL_GPIO_A2_pin());
-    
-    watch_disable_adc();
+    _sample(state, SENSOR_BIT(SENSOR_LUX), 0);
+#else
+    // Non-Pro boards: no light sensor
+    state->lux_avg = 0;
+#endif
+}
+
+void sensors_sample_temperature(struct sensor_state_t *state) {
+    if (!state || !state->initialized) {
+        return;
+    }
     
+    // Thermistor if there is one, else the LIS2DW12's internal sensor, else
+    // the 20.0°C sensors_init() left behind.
+    _sample(state, _present(state) & SENSOR_TEMPERATURE_BITS, 0);
+}
+
+#if HAS_LIGHT_SENSOR
+static void _add_lux(struct sensor_state_t *state, uint16_t raw) {
     // Convert raw ADC to approximate lux
     // Raw 0-65535 → roughly 0-10000 lux (calibration TBD during dogfooding)
     // Simple linear mapping: lux = raw / 6 (gives ~0-10922 range)
@@ -186,43 +412,23 @@ void sensors_sample_lux(struct sensor_state_t *state) {
         state->lux_buf_count++;
     }
     
-    // Compute 5-min rolling average
+    // Compute 5-sample rolling average
     uint32_t sum = 0;
     for (uint8_t i = 0; i < state->lux_buf_count; i++) {
         sum += state->lux_buffer[i];
     }
-    
-    // Guard against division by zero
-    if (state->lux_buf_count == 0) {
-        state->lux_avg = 0;
-        return;
-    }
-    
     state->lux_avg = (uint16_t)(sum / state->lux_buf_count);
-#else
-    // Non-Pro boards: no light sensor
-    state->lux_avg = 0;
-#endif
 }
+#endif
 
-void sensors_sample_temperature(struct sensor_state_t *state) {
-    if (!state || !state->initialized) {
-        return;
-    }
-    
-    // Use existing Movement API (handles thermistor + LIS2DW fallback)
-    // movement_get_temperature() checks movement_state.has_thermistor and
-    // falls back to LIS2DW12 internal temp sensor if no thermistor available
-    float temp_c = movement_get_temperature();
-    
-    // Convert to 0.1°C units (e.g., 20.5°C → 205)
-    if (temp_c == (float)0xFFFFFFFF) {
+static void _set_temperature(struct sensor_state_t *state, int16_t temp_c100) {
+    // Convert to 0.1°C units (e.g., 2050 → 205)
+    if (temp_c100 == THERMISTOR_DRIVER_NO_READING) {
         // No temperature sensor available, use reasonable fallback
         state->temperature_c10 = 200;  // 20.0°C (room temperature)
     } else {
-        // Convert float to 0.1°C units with rounding
-        // Use int16_t to support negative temperatures (e.g., -30°C → -300)
-        state->temperature_c10 = (int16_t)((temp_c * 10.0f) + (temp_c >= 0 ? 0.5f : -0.5f));
+        // Round half away from zero; int16_t keeps negative temperatures (e.g., -3000 → -300)
+        state->temperature_c10 = (int16_t)((temp_c100 + (temp_c100 >= 0 ? 5 : -5)) / 10);
     }
 }
 
@@ -273,4 +479,80 @@ uint8_t sensors_get_hourly_movement_count(const struct sensor_state_t *state) {
     return state ? state->hourly_movement_count : 0;
 }
 
+// ============================================================================
+// Sleep Epoch Batching
+// ============================================================================
+
+void sensors_begin_batching(struct sensor_state_t *state) {
+    if (!state || !state->initialized || !state->has_accelerometer || state->batching) {
+        return;
+    }
+    
+    state->batch_saved_fifo_ctrl = lis2dw_get_fifo_configuration();
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_LOWEST);  // 1.6 Hz in low power mode
+    lis2dw_configure_fifo(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, SENSOR_BATCH_WATERMARK);
+    lis2dw_configure_int1(LIS2DW_CTRL4_INT1_FTH);
+    state->batching = true;
+    state->batch_last_valid = false;
+}
+
+void sensors_end_batching(struct sensor_state_t *state) {
+    if (!state || !state->batching) {
+        return;
+    }
+    
+    // A face may have set a background rate or FIFO of its own; Movement still
+    // caches that rate, so putting anything else here would make it stick.
+    lis2dw_configure_fifo(state->batch_saved_fifo_ctrl >> 5, state->batch_saved_fifo_ctrl & LIS2DW_FIFO_CTRL_FTH);
+    lis2dw_set_data_rate(movement_get_accelerometer_background_rate());
+    lis2dw_configure_int1(LIS2DW_CTRL4_INT1_WU);
+    state->batching = false;
+}
+
+bool sensors_is_batching(const struct sensor_state_t *state) {
+    return state ? state->batching : false;
+}
+
+uint8_t sensors_drain_fifo(struct sensor_state_t *state) {
+    if (!state || !state->batching) {
+        return 0;
+    }
+    
+    lis2dw_fifo_t fifo;
+    lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT);
+    uint8_t active = _count_activity(state, fifo.readings, fifo.count);
+    
+    uint16_t epoch = state->epoch_movement_count + active;
+    state->epoch_movement_count = (epoch > UINT8_MAX) ? UINT8_MAX : (uint8_t)epoch;
+    uint16_t hourly = state->hourly_movement_count + active;
+    state->hourly_movement_count = (hourly > UINT8_MAX) ? UINT8_MAX : (uint8_t)hourly;
+    
+    return active;
+}
+
+// Samples that moved at least SENSOR_ACTIVITY_THRESHOLD_MG (L1, all three axes)
+// since the one before. Readings are 12-bit left-justified at ±2 g, so >> 4 is
+// ~0.98 mg per count. The first sample after batching begins has no reference.
+static uint8_t _count_activity(struct sensor_state_t *state, const lis2dw_reading_t *readings, uint8_t count) {
+    uint8_t active = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        const lis2dw_reading_t *r = &readings[i];
+        if (state->batch_last_valid) {
+            uint32_t delta = (uint32_t)abs(r->x - state->batch_last[0]) +
+                             (uint32_t)abs(r->y - state->batch_last[1]) +
+                             (uint32_t)abs(r->z - state->batch_last[2]);
+            if ((delta >> 4) >= SENSOR_ACTIVITY_THRESHOLD_MG) {
+                active++;
+            }
+        }
+        state->batch_last[0] = r->x;
+        state->batch_last[1] = r->y;
+        state->batch_last[2] = r->z;
+        state->batch_last_valid = true;
+    }
+    
+    return active;
+}
+
 #endif // PHASE_ENGINE_ENABLED
@@ -37,20 +37,72 @@
   #define HAS_LIGHT_SENSOR 0
 #endif
 
-#define SENSOR_MOTION_BUFFER_SIZE 5
 #define SENSOR_INACTIVITY_MIN 15
 #define SENSOR_LUX_BUFFER_SIZE 5    // PR #66: 5 samples = 5-min window at 1/min
 
+// Motion statistics: exponentially weighted mean and variance of the
+// acceleration magnitude over a short and a long horizon, one O(1) update per
+// motion sample (West, 1979, as in activity_baseline). A sample that stands
+// for several minutes (the scheduler reads motion every 15 or 60 minutes
+// outside a zone face) weighs as that many one-minute samples, but never more
+// than SENSOR_MOTION_MAX_WEIGHT: when samples are sparser than a horizon, it
+// follows the last few samples instead of only the latest.
+#define SENSOR_MOTION_TAU_SHORT_MIN 5   // time constants, minutes (1-255)
+#define SENSOR_MOTION_TAU_LONG_MIN 60
+#define SENSOR_MOTION_MAX_WEIGHT 2048   // Q12: one sample is at most half the estimate
+#define SENSOR_ACTIVITY_FULL_SCALE_MG 200  // motion spread that reads as full activity (brisk walking)
+
+typedef enum {
+    SENSOR_MOTION_SHORT = 0,    // metric cadence and EM
+    SENSOR_MOTION_LONG,         // WK
+    SENSOR_MOTION_HORIZON_COUNT
+} sensor_motion_horizon_t;
+
+typedef struct {
+    uint16_t mean[SENSOR_MOTION_HORIZON_COUNT];      // Magnitude, raw units (1/16 mg)
+    uint32_t variance[SENSOR_MOTION_HORIZON_COUNT];  // mg² x 16, at most 0xFFFFF
+    bool     seeded;                                 // The first sample sets the means
+} sensor_motion_stats_t;
+
+// Sleep epoch batching: while the wearer is confirmed asleep the LIS2DW fills
+// its FIFO at 1.6 Hz and INT1 fires on the watermark instead of on each
+// wake-up, so the MCU reads the bus about twice per 30 s epoch. Samples that
+// moved more than the wake-up threshold (1 = 2 g / 64) since the previous one
+// are the epoch's activity count.
+#define SENSOR_BATCH_WATERMARK 24       // 15 s at 1.6 Hz; the 32-sample FIFO holds 20 s
+#define SENSOR_ACTIVITY_THRESHOLD_MG 31 // |dx| + |dy| + |dz| between samples
+
+// Sensor scheduler. Each minute Movement says what the wearer is doing and
+// sensors_schedule_tick() samples whatever is due: every sensor has a rate per
+// context (minutes between samples, a policy table in sensors.c). Samples land
+// on clock multiples of the rate, so the ADC readers due in the same minute
+// share one power-up. A per-hour table counts what each sensor took.
+typedef enum {
+    SENSOR_LUX = 0,         // light sensor on A2 (ADC, Pro board only)
+    SENSOR_THERMISTOR,      // thermistor divider (ADC)
+    SENSOR_LIS2DW_TEMP,     // accelerometer die temperature, when there's no thermistor
+    SENSOR_VCC,             // supply voltage (ADC)
+    SENSOR_MOTION,          // wake-up source and one accelerometer reading
+    SENSOR_COUNT
+} sensor_id_t;
+
+#define SENSOR_BIT(sensor) (1 << (sensor))
+
+typedef enum {
+    SENSOR_CONTEXT_AWAKE = 0,
+    SENSOR_CONTEXT_SLEEP_WINDOW,    // outside active hours, not confirmed asleep
+    SENSOR_CONTEXT_ASLEEP,          // in the sleep window and confirmed still
+    SENSOR_CONTEXT_ZONE_FACE,       // a zone face is showing the metrics (wins over the others)
+    SENSOR_CONTEXT_COUNT
+} sensor_context_t;
+
 // Forward-declared in metrics.h
 struct sensor_state_t {
     // Motion tracking (PR #65)
     bool     motion_active;
     uint8_t  inactivity_minutes;
     uint16_t motion_magnitude;
-    uint16_t motion_buffer[SENSOR_MOTION_BUFFER_SIZE];
-    uint8_t  motion_buf_idx;
-    uint8_t  motion_buf_count;
-    uint16_t motion_variance;
+    sensor_motion_stats_t motion_stats;
     uint16_t motion_intensity;
     bool     has_accelerometer;
     
@@ -69,17 +121,53 @@ struct sensor_state_t {
     uint8_t  hourly_light_minutes;   // Minutes with light exposure this hour
     uint8_t  hourly_movement_count;  // Movement interrupts this hour
     
+    // Sleep epoch batching
+    bool     batching;               // FIFO on, INT1 = watermark
+    bool     batch_last_valid;
+    uint8_t  batch_saved_fifo_ctrl;  // FIFO_CTRL from before batching, put back at the end
+    int16_t  batch_last[3];          // Last drained sample (x, y, z), the reference for the next one
+
+    // Sensor scheduler
+    bool     has_thermistor;
+    bool     schedule_started;                 // Everything is due on the first tick
+    uint16_t vcc_mv;                           // Last supply voltage sample
+    uint8_t  minutes_since[SENSOR_COUNT];      // Since each sensor's last sample (saturating)
+    uint8_t  stats_hour;                       // Local hour hour_samples belongs to
+    uint8_t  hour_samples[SENSOR_COUNT];       // Samples taken this hour
+    uint8_t  last_hour_samples[SENSOR_COUNT];  // ... and in the last complete hour
+
     bool     initialized;
 };
 
 // PR #65: Motion tracking
-void sensors_init(struct sensor_state_t *state, bool has_accel);
+void sensors_init(struct sensor_state_t *state, bool has_accel, bool has_thermistor);
 void sensors_configure_accel(struct sensor_state_t *state);
-void sensors_update(struct sensor_state_t *state);
+// Samples motion, lux and temperature now, whatever the schedule says.
+// elapsed_min: minutes since the last motion sample
+void sensors_update(struct sensor_state_t *state, uint8_t elapsed_min);
+// Motion variance in mg², short horizon; 0 until there are two samples
 uint16_t sensors_get_motion_variance(const struct sensor_state_t *state);
+uint16_t sensors_get_motion_variance_over(const struct sensor_state_t *state, sensor_motion_horizon_t horizon);
 uint16_t sensors_get_motion_intensity(const struct sensor_state_t *state);
+// Activity 0-1000 from the spread of the short-horizon magnitudes, so gravity and
+// the way the wrist is turned don't count: 0 for a watch lying still, 1000 from a
+// SENSOR_ACTIVITY_FULL_SCALE_MG standard deviation up
+uint16_t sensors_get_activity_level(const struct sensor_state_t *state);
 bool sensors_is_motion_active(const struct sensor_state_t *state);
 
+// Fold one magnitude (|x| + |y| + |z|, raw) into every horizon
+void sensors_motion_stats_add(sensor_motion_stats_t *stats, uint16_t magnitude, uint8_t elapsed_min);
+uint16_t sensors_motion_stats_variance(const sensor_motion_stats_t *stats, sensor_motion_horizon_t horizon);
+
+// Sensor scheduler
+// Call once a minute; returns the SENSOR_BIT()s sampled
+uint8_t sensors_schedule_tick(struct sensor_state_t *state, sensor_context_t context, uint16_t minute_of_day);
+// Minutes between samples of a sensor in a context; 0 = never
+uint8_t sensors_schedule_interval(sensor_id_t sensor, sensor_context_t context);
+// Samples a sensor took in the last complete hour
+uint8_t sensors_get_hourly_samples(const struct sensor_state_t *state, sensor_id_t sensor);
+uint16_t sensors_get_vcc_mv(const struct sensor_state_t *state);
+
 // PR #66: Lux + Temperature
 void sensors_sample_lux(struct sensor_state_t *state);
 void sensors_sample_temperature(struct sensor_state_t *state);
@@ -93,5 +181,15 @@ void sensors_reset_hourly_counters(struct sensor_state_t *state);
 uint8_t sensors_get_hourly_light_minutes(const struct sensor_state_t *state);
 uint8_t sensors_get_hourly_movement_count(const struct sensor_state_t *state);
 
+// Sleep epoch batching. Begin puts the accelerometer in continuous FIFO mode at
+// 1.6 Hz with INT1 on the watermark; end puts the FIFO back as it found it, the
+// rate back to Movement's background rate and INT1 back on wake-up. While
+// batching, the epoch and hourly movement counts come from drained samples.
+void sensors_begin_batching(struct sensor_state_t *state);
+void sensors_end_batching(struct sensor_state_t *state);
+bool sensors_is_batching(const struct sensor_state_t *state);
+// Drain the FIFO (on the watermark, and at the end of each epoch); returns the active samples added
+uint8_t sensors_drain_fifo(struct sensor_state_t *state);
+
 #endif // PHASE_ENGINE_ENABLED
 #endif // SENSORS_H_
@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Tick budget profiler
+ * Implementation
+ */
+
+#include "tick_profile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef PHASE_TICK_PROFILE
+
+#if __EMSCRIPTEN__
+#include <emscripten.h>
+#define TICK_PROFILE_COUNTER_MASK 0xFFFFFFFFUL
+#define TICK_PROFILE_UNIT "us"
+#else
+#include "watch.h"
+// SysTick is a 24-bit down counter; at 4 MHz it wraps every ~4 s, far longer than any stage.
+#define TICK_PROFILE_COUNTER_MASK SysTick_LOAD_RELOAD_Msk
+#define TICK_PROFILE_UNIT "cycles"
+#endif
+
+static tick_profile_stat_t _stats[TICK_STAGE_COUNT];
+static uint32_t _counts[TICK_COUNT_COUNT];
+
+static const char *const _stage_names[TICK_STAGE_COUNT] = {
+    "dst",
+    "sleep_save",
+    "advise",
+    "sensors",
+    "phase",
+    "metrics",
+    "playlist",
+    "telemetry",
+    "total",
+};
+
+static const char *const _counter_names[TICK_COUNT_COUNT] = {
+    "metrics_recomputed",
+    "metrics_skipped",
+    "bkup_writes",
+    "bkup_skipped",
+};
+
+void tick_profile_init(void) {
+#if !__EMSCRIPTEN__
+    // free-running off the CPU clock, no interrupt.
+    SysTick->LOAD = TICK_PROFILE_COUNTER_MASK;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+    tick_profile_reset();
+}
+
+void tick_profile_reset(void) {
+    memset(_stats, 0, sizeof(_stats));
+    memset(_counts, 0, sizeof(_counts));
+    for (uint8_t i = 0; i < TICK_STAGE_COUNT; i++) {
+        _stats[i].min = UINT32_MAX;
+    }
+}
+
+uint32_t tick_profile_now(void) {
+#if __EMSCRIPTEN__
+    return (uint32_t)(emscripten_get_now() * 1000.0);
+#else
+    // count up, so the caller can just subtract.
+    return TICK_PROFILE_COUNTER_MASK - SysTick->VAL;
+#endif
+}
+
+void tick_profile_record(tick_profile_stage_t stage, uint32_t start) {
+    if (stage >= TICK_STAGE_COUNT) return;
+
+    uint32_t elapsed = (tick_profile_now() - start) & TICK_PROFILE_COUNTER_MASK;
+    tick_profile_stat_t *stat = &_stats[stage];
+
+    if (elapsed < stat->min) stat->min = elapsed;
+    if (elapsed > stat->max) stat->max = elapsed;
+    stat->count++;
+    stat->total += elapsed;
+}
+
+const tick_profile_stat_t *tick_profile_get(tick_profile_stage_t stage) {
+    if (stage >= TICK_STAGE_COUNT) return NULL;
+    return &_stats[stage];
+}
+
+void tick_profile_count(tick_profile_counter_t counter, uint32_t n) {
+    if (counter >= TICK_COUNT_COUNT) return;
+    _counts[counter] += n;
+}
+
+uint32_t tick_profile_get_count(tick_profile_counter_t counter) {
+    if (counter >= TICK_COUNT_COUNT) return 0;
+    return _counts[counter];
+}
+
+int tick_profile_cmd_perf(int argc, char *argv[]) {
+    if (argc >= 2) {
+        if (strcmp(argv[1], "reset") != 0) return -1;
+        tick_profile_reset();
+        printf("perf: cleared\r\n");
+        return 0;
+    }
+
+    printf("stage\tcount\tmin\tavg\tmax (%s)\r\n", TICK_PROFILE_UNIT);
+    for (uint8_t i = 0; i < TICK_STAGE_COUNT; i++) {
+        const tick_profile_stat_t *stat = &_stats[i];
+        if (stat->count == 0) {
+            printf("%s\t0\t-\t-\t-\r\n", _stage_names[i]);
+            continue;
+        }
+        printf("%s\t%lu\t%lu\t%lu\t%lu\r\n",
+               _stage_names[i],
+               (unsigned long)stat->count,
+               (unsigned long)stat->min,
+               (unsigned long)(stat->total / stat->count),
+               (unsigned long)stat->max);
+    }
+
+    printf("counter\tcount\r\n");
+    for (uint8_t i = 0; i < TICK_COUNT_COUNT; i++) {
+        printf("%s\t%lu\r\n", _counter_names[i], (unsigned long)_counts[i]);
+    }
+
+    return 0;
+}
+
+#else
+
+int tick_profile_cmd_perf(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    printf("perf: profiling not compiled in; rebuild with TICK_PROFILE=1\r\n");
+    return 0;
+}
+
+#endif // PHASE_TICK_PROFILE
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Tick budget profiler
+ *
+ * Times each stage of Movement's top-of-minute handler, so we can see what
+ * keeps the watch awake every minute, and counts how often work was done or
+ * skipped. Compiled in with TICK_PROFILE=1
+ * (PHASE_TICK_PROFILE); otherwise the macros below compile to nothing.
+ *
+ * Hardware: cycles, from SysTick running free off the CPU clock (the
+ *           Cortex-M0+ has no DWT cycle counter).
+ * Simulator: microseconds, from emscripten_get_now().
+ */
+
+#ifndef TICK_PROFILE_H_
+#define TICK_PROFILE_H_
+
+#include <stdint.h>
+
+typedef enum {
+    TICK_STAGE_DST = 0,         // DST offset cache refresh
+    TICK_STAGE_SLEEP_SAVE,      // sleep tracking flash save
+    TICK_STAGE_ADVISORIES,      // background wakes and face advisories
+    TICK_STAGE_SENSORS,         // sensors_schedule_tick
+    TICK_STAGE_PHASE,           // phase_compute
+    TICK_STAGE_METRICS,         // metrics_update
+    TICK_STAGE_PLAYLIST,        // playlist_update
+    TICK_STAGE_TELEMETRY,       // hourly telemetry accumulation
+    TICK_STAGE_TOTAL,           // the whole handler
+    TICK_STAGE_COUNT
+} tick_profile_stage_t;
+
+typedef enum {
+    TICK_COUNT_METRICS_RECOMPUTED = 0,  // metrics whose inputs changed
+    TICK_COUNT_METRICS_SKIPPED,         // metrics whose inputs didn't
+    TICK_COUNT_BKUP_WRITES,             // metric BKUP registers written
+    TICK_COUNT_BKUP_SKIPPED,            // ... or left alone, already holding the value
+    TICK_COUNT_COUNT
+} tick_profile_counter_t;
+
+#ifdef PHASE_TICK_PROFILE
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t count;
+    uint64_t total;             // for the average; can't overflow in any realistic uptime
+} tick_profile_stat_t;
+
+/**
+ * Start the free-running counter and clear the table.
+ */
+void tick_profile_init(void);
+
+/**
+ * Clear the table without touching the counter.
+ */
+void tick_profile_reset(void);
+
+/**
+ * Current counter value, to pass to tick_profile_record when the stage ends.
+ */
+uint32_t tick_profile_now(void);
+
+/**
+ * Add the time since `start` to a stage's stats.
+ */
+void tick_profile_record(tick_profile_stage_t stage, uint32_t start);
+
+/**
+ * Stats for one stage.
+ */
+const tick_profile_stat_t *tick_profile_get(tick_profile_stage_t stage);
+
+/**
+ * Add n to a counter.
+ */
+void tick_profile_count(tick_profile_counter_t counter, uint32_t n);
+
+/**
+ * Value of one counter.
+ */
+uint32_t tick_profile_get_count(tick_profile_counter_t counter);
+
+#define TICK_PROFILE_BEGIN(var) uint32_t var = tick_profile_now()
+#define TICK_PROFILE_END(stage, var) tick_profile_record((stage), (var))
+#define TICK_PROFILE_COUNT(counter, n) tick_profile_count((counter), (n))
+
+#else
+
+#define TICK_PROFILE_BEGIN(var) do { } while (0)
+#define TICK_PROFILE_END(stage, var) do { } while (0)
+#define TICK_PROFILE_COUNT(counter, n) do { } while (0)
+
+#endif // PHASE_TICK_PROFILE
+
+/**
+ * Shell command: print the table, or clear it with `perf reset`.
+ * Available in every build; says how to enable profiling when it's compiled out.
+ */
+int tick_profile_cmd_perf(int argc, char *argv[]);
+
+#endif // TICK_PROFILE_H_
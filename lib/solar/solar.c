@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Fixed-point solar model. See solar.h.
+ *
+ * Angles are binary: 2^32 per turn while accumulating (so the mean anomaly
+ * wraps for free), and the top 16 bits of that for the sine table.
+ */
+
+#include "solar.h"
+
+// sin(i * 90° / 64) in Q15. Interpolated linearly; worst-case error ~1e-4.
+static const int16_t sine_quarter[65] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+    10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846,
+    17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170,
+    23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105,
+    28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852, 31113, 31356,
+    31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728,
+    32757, 32767
+};
+
+#define QUARTER_TURN 16384
+
+// Mean anomaly: 357.5291° at J2000.0, advancing 0.98560028° per day.
+#define MEAN_ANOMALY_J2000 4265488311u
+#define MEAN_ANOMALY_PER_DAY 11758669u
+#define MEAN_ANOMALY_PER_CENTIDEGREE 327     // of longitude, via the local noon it shifts
+// Ecliptic longitude = M + C + 180° + 102.9372° (argument of perihelion).
+#define ECLIPTIC_OFFSET 3375572280u
+// Equation of center, 2^22 per turn: 1.9148° sin M + 0.0200° sin 2M + 0.0003° sin 3M
+#define CENTER_1 22309
+#define CENTER_2 233
+#define CENTER_3 3
+// Equation of time, in seconds: 0.0053 days sin M - 0.0069 days sin 2λ
+#define EOT_ANOMALY_S 458
+#define EOT_OBLIQUITY_S 596
+#define SIN_OBLIQUITY_Q15 13035             // sin 23.44°
+#define SIN_HORIZON_Q15 (-476)              // sin -0.833°: refraction plus the sun's radius
+
+#define DAYS_1970_TO_2000 10957
+
+static solar_times_t today;
+static bool today_valid;
+static uint16_t today_year;
+static uint8_t today_month;
+static uint8_t today_day;
+static int16_t today_latitude;
+static int16_t today_longitude;
+static int32_t today_utc_offset;
+
+int16_t solar_sin(uint16_t angle) {
+    uint16_t index = angle & (QUARTER_TURN - 1);
+    if (angle & QUARTER_TURN) index = QUARTER_TURN - index;
+
+    uint8_t segment = index >> 8;
+    int16_t value = sine_quarter[segment];
+    if (segment < 64) {
+        value += ((int32_t)(sine_quarter[segment + 1] - value) * (index & 0xff)) >> 8;
+    }
+
+    return (angle & (2 * QUARTER_TURN)) ? -value : value;
+}
+
+// Inverse of solar_sin over -90°..90°: find the table segment, then undo its interpolation.
+static int16_t solar_asin(int16_t value) {
+    int16_t magnitude = value < 0 ? -value : value;
+    uint8_t low = 0;
+    uint8_t high = 64;
+
+    while (high - low > 1) {
+        uint8_t mid = (low + high) / 2;
+        if (sine_quarter[mid] <= magnitude) low = mid;
+        else high = mid;
+    }
+
+    int16_t angle = (low << 8) + (((int32_t)(magnitude - sine_quarter[low]) << 8) /
+                                  (sine_quarter[high] - sine_quarter[low]));
+    return value < 0 ? -angle : angle;
+}
+
+static uint16_t isqrt32(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)root;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's days_from_civil).
+static int32_t days_from_civil(int32_t year, uint8_t month, uint8_t day) {
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t year_of_era = (uint32_t)(year - era * 400);
+    uint32_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + (int32_t)day_of_era - 719468;
+}
+
+// To the nearest minute; the floor division keeps times before midnight right.
+static int16_t seconds_to_minutes(int32_t seconds) {
+    seconds += 30;
+    return (int16_t)(seconds >= 0 ? seconds / 60 : -((59 - seconds) / 60));
+}
+
+int8_t solar_compute(uint16_t year, uint8_t month, uint8_t day,
+                     int16_t latitude, int16_t longitude, int32_t utc_offset,
+                     solar_times_t *out) {
+    // Days from J2000.0 (2000-01-01 12:00 UTC) to this date's solar noon, as an angle.
+    int32_t days = days_from_civil(year, month, day) - DAYS_1970_TO_2000;
+    uint32_t mean_anomaly = MEAN_ANOMALY_J2000 + (uint32_t)days * MEAN_ANOMALY_PER_DAY -
+                            (uint32_t)((int32_t)longitude * MEAN_ANOMALY_PER_CENTIDEGREE);
+    uint16_t m = mean_anomaly >> 16;
+
+    int16_t sin_m = solar_sin(m);
+    int32_t center = ((int32_t)sin_m * CENTER_1 +
+                      (int32_t)solar_sin(2 * m) * CENTER_2 +
+                      (int32_t)solar_sin(3 * m) * CENTER_3) >> 15;
+    uint32_t ecliptic = mean_anomaly + (uint32_t)(center * 1024) + ECLIPTIC_OFFSET;
+
+    // Solar noon, in seconds after 00:00 UTC of this date.
+    int32_t noon = 43200 - (int32_t)longitude * 12 / 5 +
+                   (((int32_t)sin_m * EOT_ANOMALY_S -
+                     (int32_t)solar_sin((uint16_t)(ecliptic >> 15)) * EOT_OBLIQUITY_S) >> 15);
+
+    // Declination and latitude, as sines and cosines.
+    int32_t sin_dec = ((int32_t)solar_sin(ecliptic >> 16) * SIN_OBLIQUITY_Q15) >> 15;
+    int32_t cos_dec = isqrt32((1UL << 30) - (uint32_t)(sin_dec * sin_dec));
+    int16_t lat = (int16_t)((int32_t)latitude * 65536 / 36000);
+    int32_t sin_lat = solar_sin((uint16_t)lat);
+    int32_t cos_lat = solar_sin((uint16_t)(QUARTER_TURN - lat));
+
+    // cos(hour angle) = (sin h0 - sin φ sin δ) / (cos φ cos δ)
+    int32_t numerator = ((int32_t)SIN_HORIZON_Q15 * 32768) - sin_lat * sin_dec;
+    int32_t denominator = (cos_lat * cos_dec) >> 15;
+    int8_t result = SOLAR_RISES_AND_SETS;
+    uint16_t hour_angle;    // half the day's arc, 65536 per turn
+
+    if (denominator <= 0 || numerator >= denominator * 32767) {
+        result = (numerator >= 0) ? SOLAR_ALWAYS_DOWN : SOLAR_ALWAYS_UP;
+    } else if (numerator <= -denominator * 32767) {
+        result = SOLAR_ALWAYS_UP;
+    }
+
+    if (result == SOLAR_ALWAYS_UP) hour_angle = 2 * QUARTER_TURN;
+    else if (result == SOLAR_ALWAYS_DOWN) hour_angle = 0;
+    else hour_angle = QUARTER_TURN - solar_asin((int16_t)(numerator / denominator));
+
+    // 65536 per turn is 86400 seconds per turn: 675/512 seconds each.
+    int32_t half_day = (int32_t)hour_angle * 675 / 512;
+
+    noon += utc_offset;
+    out->noon_min = seconds_to_minutes(noon);
+    out->sunrise_min = seconds_to_minutes(noon - half_day);
+    out->sunset_min = seconds_to_minutes(noon + half_day);
+    out->daylight_min = out->sunset_min - out->sunrise_min;
+
+    return result;
+}
+
+void solar_update_today(uint16_t year, uint8_t month, uint8_t day,
+                        int16_t latitude, int16_t longitude, int32_t utc_offset) {
+    if (latitude == 0 && longitude == 0) {
+        today_valid = false;
+        return;
+    }
+    if (today_valid && year == today_year && month == today_month && day == today_day &&
+        latitude == today_latitude && longitude == today_longitude && utc_offset == today_utc_offset) {
+        return;
+    }
+
+    solar_compute(year, month, day, latitude, longitude, utc_offset, &today);
+    today_year = year;
+    today_month = month;
+    today_day = day;
+    today_latitude = latitude;
+    today_longitude = longitude;
+    today_utc_offset = utc_offset;
+    today_valid = true;
+}
+
+const solar_times_t* solar_get_today(void) {
+    return today_valid ? &today : NULL;
+}
+
+bool solar_is_daylight(const solar_times_t *times, int16_t minute_of_day) {
+    // sunrise and sunset can spill into the neighbouring days; so can the window.
+    for (int16_t minute = minute_of_day - 1440; minute <= minute_of_day + 1440; minute += 1440) {
+        if (minute >= times->sunrise_min && minute < times->sunset_min) return true;
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Fixed-point solar model
+ *
+ * Sunrise, sunset and solar noon for a date and location, in integer math:
+ * the NOAA sunrise equation (mean anomaly, equation of center, equation of
+ * time, declination, hour angle) over a quarter-wave sine table. Agrees with
+ * lib/sunriset within 3 minutes (half a minute on average) up to 65° of
+ * latitude, without pulling in soft-float libm. tests/host checks the
+ * agreement and times the two against each other.
+ *
+ * Two ways in:
+ * - solar_compute() is a pure function for any date and place (the sunrise
+ *   face uses it for today and tomorrow).
+ * - solar_update_today() / solar_get_today() keep one cached result for the
+ *   wearer's location. Movement feeds it every tick from BKUP[1]; it only
+ *   recomputes when the date, location or UTC offset changes, so about once
+ *   a day. The phase engine and comfort metric read it back.
+ */
+
+#ifndef SOLAR_H_
+#define SOLAR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Return values of solar_compute(); the same convention as sun_rise_set().
+#define SOLAR_RISES_AND_SETS 0
+#define SOLAR_ALWAYS_UP 1       // midnight sun: rise/set are solar noon -/+ 12 hours
+#define SOLAR_ALWAYS_DOWN (-1)  // polar night: rise and set are both solar noon
+
+typedef struct {
+    // Local minutes after midnight of the requested date. Can fall outside
+    // 0-1439 when the event lands on the day before or after (for example a
+    // location far from its time zone's meridian).
+    int16_t sunrise_min;
+    int16_t sunset_min;
+    int16_t noon_min;
+    uint16_t daylight_min;
+} solar_times_t;
+
+/**
+ * Compute sunrise, sunset and solar noon.
+ *
+ * @param year Full year (e.g. 2026)
+ * @param month 1-12
+ * @param day 1-31
+ * @param latitude Hundredths of a degree, north positive (movement_location_t)
+ * @param longitude Hundredths of a degree, east positive (movement_location_t)
+ * @param utc_offset Seconds to add to UTC for local time
+ * @param out Result
+ * @return SOLAR_RISES_AND_SETS, SOLAR_ALWAYS_UP or SOLAR_ALWAYS_DOWN
+ */
+int8_t solar_compute(uint16_t year, uint8_t month, uint8_t day,
+                     int16_t latitude, int16_t longitude, int32_t utc_offset,
+                     solar_times_t *out);
+
+/**
+ * Refresh the cached result for today. Cheap when nothing changed.
+ * A location of 0,0 means "not set" and clears the cache.
+ */
+void solar_update_today(uint16_t year, uint8_t month, uint8_t day,
+                        int16_t latitude, int16_t longitude, int32_t utc_offset);
+
+/**
+ * @return Today's cached times, or NULL if no location is set yet. On days
+ *         the sun never rises or never sets, sunrise/sunset still bracket the
+ *         right stretch (all day or none of it) for solar_is_daylight().
+ */
+const solar_times_t* solar_get_today(void);
+
+/**
+ * @param minute_of_day Local minutes after midnight (0-1439)
+ * @return true if the sun is up at that minute
+ */
+bool solar_is_daylight(const solar_times_t *times, int16_t minute_of_day);
+
+/**
+ * Integer sine, exposed for tests.
+ *
+ * @param angle Binary angle, 65536 per turn
+ * @return sin(angle) in Q15
+ */
+int16_t solar_sin(uint16_t angle);
+
+#endif // SOLAR_H_
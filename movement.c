@@ -27,6 +27,11 @@
 #define MOVEMENT_REALLY_LONG_PRESS_TICKS 192
 #define MOVEMENT_MAX_LONG_PRESS_TICKS 1280 // get a chance to check if a button held down over 10 seconds is a glitch
 
+// How late the RTC may run these timeouts so they can share a wakeup with another comp callback.
+// Nobody notices the LED going off 1/16 s late, or the watch resigning or going to sleep a second late.
+#define MOVEMENT_LED_TIMEOUT_SLACK_TICKS 8
+#define MOVEMENT_INACTIVITY_TIMEOUT_SLACK_TICKS 128
+
 #include <stdio.h>
 #include <string.h>
 #include <limits.h>
@@ -55,6 +60,7 @@
 #include "movement_custom_signal_tunes.h"
 #include "sleep_data.h"
 #include "smart_alarm_face.h"
+#include "tick_profile.h"
 
 #ifdef PHASE_ENGINE_ENABLED
 // Phase 3B: Playlist controller integration
@@ -62,12 +68,26 @@
 // For now, just verify playlist compiles and links
 #include "playlist.h"
 #include "phase_engine.h"
+#include "calendar_context.h"
+#include "metric_cadence.h"
 #endif
 
 #ifndef MOVEMENT_TERTIARY_FACE_INDEX
 #define MOVEMENT_TERTIARY_FACE_INDEX 0
 #endif
 
+// Every flash log Movement opens at boot has to fit the storage region at once, beside the
+// shared rows faces keep their records in; a claim that doesn't fit fails quietly and that
+// log is simply never saved.
+#define MOVEMENT_LOG_ROWS_AVAILABLE (WATCH_STORAGE_REGION_ROWS - WATCH_STORAGE_REGION_SHARED_ROWS)
+#ifdef PHASE_ENGINE_ENABLED
+_Static_assert(SLEEP_STORAGE_LOG_ROWS + PHASE_STORAGE_LOG_ROWS + BASELINE_STORAGE_LOG_ROWS +
+               STORAGE_LOG_CIRCADIAN_ROWS <= MOVEMENT_LOG_ROWS_AVAILABLE, "boot-time logs overflow the storage region");
+#else
+_Static_assert(SLEEP_STORAGE_LOG_ROWS + STORAGE_LOG_CIRCADIAN_ROWS <= MOVEMENT_LOG_ROWS_AVAILABLE,
+               "boot-time logs overflow the storage region");
+#endif
+
 #if __EMSCRIPTEN__
 #include <emscripten.h>
 void _wake_up_simulator(void);
@@ -77,7 +97,6 @@ void _wake_up_simulator(void);
 
 volatile movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
-watch_date_time_t scheduled_tasks[MOVEMENT_NUM_FACES];
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
 
@@ -115,6 +134,9 @@ typedef struct {
     volatile bool schedule_next_comp;
     volatile bool has_pending_accelerometer;
     volatile bool accelerometer_woke;  // set in ISR; I2C reads deferred to app_loop
+#ifdef PHASE_ENGINE_ENABLED
+    volatile bool has_pending_fifo;    // INT1 watermark while sleep epochs are batched
+#endif
 
     // button tracking for long press
     movement_button_t mode_button;
@@ -155,12 +177,60 @@ int8_t alarm_tune[] = {
     0
 };
 
+// How a face wants to be woken for background tasks. Faces start out in MOVEMENT_WAKE_ADVISE, which
+// keeps the legacy behavior of polling their advise() function every minute.
+typedef enum {
+    MOVEMENT_WAKE_ADVISE = 0,   // poll advise() at the top of every minute
+    MOVEMENT_WAKE_NEVER,        // never wake the face for a background task
+    MOVEMENT_WAKE_AT,           // wake once at a given UTC timestamp
+    MOVEMENT_WAKE_PERIODIC,     // wake every N minutes, aligned to multiples of N since the epoch
+} movement_wake_mode_t;
+
+// Background wake registry. Each face has at most one slot in a min-heap, keyed by the earlier of its
+// one-shot scheduled task and its registered wake time, so we only ever visit faces that are actually due.
+typedef struct {
+    uint32_t task_due;      // one-shot task from movement_schedule_background_task_for_face (UTC timestamp, 0 = none)
+    uint32_t wake_due;      // next wake from the registry (UTC timestamp, 0 = none)
+    uint16_t interval;      // period in minutes, for MOVEMENT_WAKE_PERIODIC
+    uint16_t le_interval;   // how often the face's low energy display changes, in minutes (0 = never)
+    uint8_t mode;           // movement_wake_mode_t
+    uint8_t heap_pos;       // index in _movement_wake_heap, or MOVEMENT_WAKE_NOT_QUEUED
+} movement_wake_entry_t;
+
+#define MOVEMENT_WAKE_NOT_QUEUED 0xFF
+
+static movement_wake_entry_t _movement_wake_entries[MOVEMENT_NUM_FACES];
+static uint8_t _movement_wake_heap[MOVEMENT_NUM_FACES];
+static uint8_t _movement_wake_heap_len = 0;
+static uint8_t _movement_num_scheduled_tasks = 0;
+
+// Faces that still rely on advise() polling; rebuilt lazily whenever a face changes its wake mode.
+static uint8_t _movement_advise_faces[MOVEMENT_NUM_FACES];
+static uint8_t _movement_num_advise_faces = 0;
+static bool _movement_advise_faces_dirty = true;
+
+#ifdef MOVEMENT_TICKLESS_LOW_ENERGY
+// Set while the minute alarm has been pushed out past the next top of the minute in low energy mode.
+static bool _movement_tickless_alarm_deferred = false;
+#endif
+
 int8_t _movement_dst_offset_cache[NUM_ZONE_NAMES] = {0};
 #define TIMEZONE_DOES_NOT_OBSERVE (-127)
 
+// UTC timestamp of each zone's next DST transition, or UINT32_MAX if the zone has no DST rules.
+static uint32_t _movement_dst_next_transition[NUM_ZONE_NAMES];
+// Earliest entry in the table above, so the minute handler only has to do a single comparison.
+static uint32_t _movement_dst_next_check = UINT32_MAX;
+
+// DST transitions are months apart, so stepping 16 days at a time can't skip over a pair of them.
+#define DST_SEARCH_STEP_SECONDS (16UL * 86400UL)
+// If a zone has rules but no transition within this horizon, just check it again once the horizon passes.
+#define DST_SEARCH_HORIZON_SECONDS (368UL * 86400UL)
+
 // Sleep tracking data (70 bytes)
 static sleep_data_t sleep_data;
-static bool sleep_data_dirty = false;  // Tracks if we need to save to flash
+static volatile bool sleep_data_dirty = false;  // Tracks if we need to save to flash (set again from the flash interrupt if a save fails)
+static watch_storage_log_t sleep_log;       // Append-only snapshots of sleep_data (see watch_storage_log.h)
 
 // Circadian Score Data (receives completed sleep sessions)
 static circadian_data_t global_circadian_data = {0};
@@ -228,6 +298,11 @@ static bool is_confirmed_asleep(void);
 
 #ifdef PHASE_ENGINE_ENABLED
 static uint8_t _movement_get_zone_face_index(phase_zone_t zone);
+// Last 30 s epoch's sleep check, so the metric cadence doesn't read the LIS2DW again.
+static bool _movement_confirmed_asleep;
+// Saves that couldn't be queued, to try again on the next phase tick.
+static bool _movement_phase_history_unsaved;
+static bool _movement_activity_baseline_unsaved;
 #endif
 
 
@@ -306,31 +381,103 @@ static void _movement_set_top_of_minute_alarm() {
     movement_volatile_state.schedule_next_comp = true;
 }
 
-static bool _movement_update_dst_offset_cache(void) {
+// Returns the zone's offset from UTC (in 15 minute increments) at the given UTC timestamp.
+static int8_t _movement_get_zone_offset_at(const uzone_t *zone, uint32_t timestamp) {
+    int32_t standard_offset = zone->offset.hours * 3600 + zone->offset.minutes * 60;
+    watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, standard_offset);
+    udatetime_t udate_time = _movement_convert_date_time_to_udate(date_time);
+    uoffset_t offset;
+    get_current_offset(zone, &udate_time, &offset);
+
+    return (offset.hours * 60 + offset.minutes) / 15;
+}
+
+// Finds the first minute after timestamp at which the zone's offset differs from current_offset.
+// A coarse forward scan brackets the transition, then a binary search narrows it down to the minute.
+static uint32_t _movement_find_next_dst_transition(const uzone_t *zone, uint32_t timestamp, int8_t current_offset) {
+    uint32_t low;
+    uint32_t high = timestamp;
+
+    do {
+        low = high;
+        high += DST_SEARCH_STEP_SECONDS;
+        // no transition coming up (the rules may have expired); revisit the zone once the horizon passes.
+        if (high - timestamp > DST_SEARCH_HORIZON_SECONDS) return high;
+    } while (_movement_get_zone_offset_at(zone, high) == current_offset);
+
+    // invariant: the offset at low is current_offset, the offset at high is not.
+    while (high - low > 60) {
+        uint32_t mid = low + (high - low) / 2;
+        if (_movement_get_zone_offset_at(zone, mid) == current_offset) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    // transitions happen on a minute boundary; round down so the top of the minute alarm catches it on time.
+    return high - (high % 60);
+}
+
+// Recomputes one zone's cached offset and its next transition. Returns true if the offset changed.
+static bool _movement_update_dst_offset_cache_for_zone(uint8_t zone_index, uint32_t timestamp) {
     uzone_t local_zone;
-    udatetime_t udate_time;
+    unpack_zone(&zone_defns[zone_index], "", &local_zone);
+
+    if (!local_zone.rules_len) {
+        // if the zone has no DST rules, set the cache to a constant value that indicates no DST check needs to be performed.
+        _movement_dst_offset_cache[zone_index] = TIMEZONE_DOES_NOT_OBSERVE;
+        _movement_dst_next_transition[zone_index] = UINT32_MAX;
+        return false;
+    }
+
+    int8_t new_offset = _movement_get_zone_offset_at(&local_zone, timestamp);
+    bool dst_changed = _movement_dst_offset_cache[zone_index] != new_offset;
+    _movement_dst_offset_cache[zone_index] = new_offset;
+    _movement_dst_next_transition[zone_index] = _movement_find_next_dst_transition(&local_zone, timestamp, new_offset);
+
+    return dst_changed;
+}
+
+static void _movement_update_dst_next_check(void) {
+    _movement_dst_next_check = UINT32_MAX;
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (_movement_dst_next_transition[i] < _movement_dst_next_check) {
+            _movement_dst_next_check = _movement_dst_next_transition[i];
+        }
+    }
+}
+
+// Full sweep of every zone. Only needed at boot and when the time is set; see _movement_update_expired_dst_offsets.
+static bool _movement_update_dst_offset_cache(void) {
+    bool dst_changed = false;
+    uint32_t timestamp = watch_rtc_get_unix_time();
+
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (_movement_update_dst_offset_cache_for_zone(i, timestamp)) {
+            dst_changed = true;
+        }
+    }
+    _movement_update_dst_next_check();
+
+    return dst_changed;
+}
+
+// Incremental update: only touches the zones whose precomputed transition time has passed.
+static bool _movement_update_expired_dst_offsets(void) {
+    uint32_t timestamp = watch_rtc_get_unix_time();
     bool dst_changed = false;
-    watch_date_time_t system_date_time = watch_rtc_get_date_time();
+
+    if (timestamp < _movement_dst_next_check) return false;
 
     for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
-        unpack_zone(&zone_defns[i], "", &local_zone);
-        watch_date_time_t date_time = watch_utility_date_time_convert_zone(system_date_time, 0, local_zone.offset.hours * 3600 + local_zone.offset.minutes * 60);
-
-        if (!!local_zone.rules_len) {
-            // if local zone has DST rules, we need to see if DST applies.
-            udate_time = _movement_convert_date_time_to_udate(date_time);
-            uoffset_t offset;
-            get_current_offset(&local_zone, &udate_time, &offset);
-            int8_t new_offset = (offset.hours * 60 + offset.minutes) / 15;
-            if (_movement_dst_offset_cache[i] != new_offset) {
-                _movement_dst_offset_cache[i] = new_offset;
+        if (_movement_dst_next_transition[i] <= timestamp) {
+            if (_movement_update_dst_offset_cache_for_zone(i, timestamp)) {
                 dst_changed = true;
             }
-        } else {
-            // otherwise set the cache to a constant value that indicates no DST check needs to be performed.
-            _movement_dst_offset_cache[i] = TIMEZONE_DOES_NOT_OBSERVE;
         }
     }
+    _movement_update_dst_next_check();
 
     return dst_changed;
 }
@@ -461,13 +608,145 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
     }
 }
 
+static uint32_t _movement_wake_key(uint8_t face_index) {
+    const movement_wake_entry_t *entry = &_movement_wake_entries[face_index];
+
+    if (!entry->task_due) return entry->wake_due;
+    if (!entry->wake_due) return entry->task_due;
+    return entry->task_due < entry->wake_due ? entry->task_due : entry->wake_due;
+}
+
+static void _movement_wake_heap_swap(uint8_t a, uint8_t b) {
+    uint8_t face_a = _movement_wake_heap[a];
+    uint8_t face_b = _movement_wake_heap[b];
+
+    _movement_wake_heap[a] = face_b;
+    _movement_wake_heap[b] = face_a;
+    _movement_wake_entries[face_a].heap_pos = b;
+    _movement_wake_entries[face_b].heap_pos = a;
+}
+
+static void _movement_wake_heap_sift_up(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (_movement_wake_key(_movement_wake_heap[parent]) <= _movement_wake_key(_movement_wake_heap[pos])) break;
+        _movement_wake_heap_swap(parent, pos);
+        pos = parent;
+    }
+}
+
+static void _movement_wake_heap_sift_down(uint8_t pos) {
+    while (true) {
+        uint8_t smallest = pos;
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = pos * 2 + 2;
+
+        if (left < _movement_wake_heap_len && _movement_wake_key(_movement_wake_heap[left]) < _movement_wake_key(_movement_wake_heap[smallest])) smallest = left;
+        if (right < _movement_wake_heap_len && _movement_wake_key(_movement_wake_heap[right]) < _movement_wake_key(_movement_wake_heap[smallest])) smallest = right;
+        if (smallest == pos) break;
+
+        _movement_wake_heap_swap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+// Call after changing a face's task_due or wake_due to (re)position it in the heap, or drop it if nothing is due.
+static void _movement_wake_heap_update(uint8_t face_index) {
+    movement_wake_entry_t *entry = &_movement_wake_entries[face_index];
+    uint8_t pos = entry->heap_pos;
+
+#ifdef MOVEMENT_TICKLESS_LOW_ENERGY
+    // the new wake time may come before the minute alarm we deferred to; go back to waking every minute until
+    // the next top of the minute works out a new deadline.
+    if (_movement_tickless_alarm_deferred) {
+        _movement_tickless_alarm_deferred = false;
+        _movement_set_top_of_minute_alarm();
+    }
+#endif
+
+    if (_movement_wake_key(face_index) == 0) {
+        if (pos == MOVEMENT_WAKE_NOT_QUEUED) return;
+        // move the last element into this slot and restore the heap property around it.
+        _movement_wake_heap_len--;
+        if (pos != _movement_wake_heap_len) {
+            _movement_wake_heap_swap(pos, _movement_wake_heap_len);
+            uint8_t moved_face = _movement_wake_heap[pos];
+            _movement_wake_heap_sift_up(pos);
+            _movement_wake_heap_sift_down(_movement_wake_entries[moved_face].heap_pos);
+        }
+        entry->heap_pos = MOVEMENT_WAKE_NOT_QUEUED;
+        return;
+    }
+
+    if (pos == MOVEMENT_WAKE_NOT_QUEUED) {
+        pos = _movement_wake_heap_len++;
+        _movement_wake_heap[pos] = face_index;
+        entry->heap_pos = pos;
+    }
+
+    _movement_wake_heap_sift_up(pos);
+    _movement_wake_heap_sift_down(entry->heap_pos);
+}
+
+static uint32_t _movement_next_periodic_wake(uint32_t now, uint16_t interval) {
+    uint32_t period = (uint32_t)interval * 60;
+    return (now / period + 1) * period;
+}
+
+static void _movement_rebuild_advise_faces(void) {
+    _movement_num_advise_faces = 0;
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        if (watch_faces[i].advise != NULL && _movement_wake_entries[i].mode == MOVEMENT_WAKE_ADVISE) {
+            _movement_advise_faces[_movement_num_advise_faces++] = i;
+        }
+    }
+    _movement_advise_faces_dirty = false;
+}
+
+// After the clock is set, periodic wakes computed against the old time could be far in the future; re-align them.
+static void _movement_reschedule_periodic_wakes(void) {
+    uint32_t now = watch_rtc_get_unix_time();
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        movement_wake_entry_t *entry = &_movement_wake_entries[i];
+        if (entry->mode == MOVEMENT_WAKE_PERIODIC) {
+            entry->wake_due = _movement_next_periodic_wake(now, entry->interval);
+            _movement_wake_heap_update(i);
+        }
+    }
+}
+
+// Pops every face whose one-shot task or registered wake time has come due, and gives it a background task.
+static void _movement_dispatch_background_tasks(uint32_t now) {
+    while (_movement_wake_heap_len && _movement_wake_key(_movement_wake_heap[0]) <= now) {
+        uint8_t face_index = _movement_wake_heap[0];
+        movement_wake_entry_t *entry = &_movement_wake_entries[face_index];
+
+        if (entry->task_due && entry->task_due <= now) {
+            entry->task_due = 0;
+            _movement_num_scheduled_tasks--;
+        }
+        if (entry->wake_due && entry->wake_due <= now) {
+            entry->wake_due = (entry->mode == MOVEMENT_WAKE_PERIODIC) ? _movement_next_periodic_wake(now, entry->interval) : 0;
+        }
+        _movement_wake_heap_update(face_index);
+
+        // the face's loop may schedule a new task; anything it schedules is in the future, so this terminates.
+        movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+        watch_faces[face_index].loop(background_event, watch_face_contexts[face_index]);
+    }
+
+    movement_state.has_scheduled_background_task = (_movement_num_scheduled_tasks != 0);
+}
+
 static void _movement_handle_top_of_minute(void) {
+    TICK_PROFILE_BEGIN(total_start);
     watch_date_time_t date_time = watch_rtc_get_date_time();
 
-    // update the DST offset cache every 30 minutes, since someplace in the world could change.
-    if (date_time.unit.minute % 30 == 0) {
-        _movement_update_dst_offset_cache();
-    }
+    // update the DST offset cache for any zone whose precomputed transition time has passed.
+    TICK_PROFILE_BEGIN(dst_start);
+    _movement_update_expired_dst_offsets();
+    TICK_PROFILE_END(TICK_STAGE_DST, dst_start);
     
     // Stream 4: Save sleep tracking data to flash periodically
     // Save once per hour during sleep window to batch writes and reduce flash wear
@@ -482,26 +761,36 @@ static void _movement_handle_top_of_minute(void) {
         bool is_hourly_save = (date_time.unit.minute == 0);
         
         if (is_end_of_sleep || (is_hourly_save && is_sleep_window())) {
+            TICK_PROFILE_BEGIN(sleep_save_start);
             sleep_tracking_save_to_flash();
+            TICK_PROFILE_END(TICK_STAGE_SLEEP_SAVE, sleep_save_start);
         }
     }
 
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        // For each face that offers an advisory...
-        if (watch_faces[i].advise != NULL) {
-            // ...we ask for one.
-            movement_watch_face_advisory_t advisory = watch_faces[i].advise(watch_face_contexts[i]);
+    // Faces that registered a wake time or interval are dispatched straight from the heap...
+    TICK_PROFILE_BEGIN(advise_start);
+    _movement_dispatch_background_tasks(watch_rtc_get_unix_time());
 
-            // If it wants a background task...
-            if (advisory.wants_background_task) {
-                // we give it one. pretty straightforward!
-                movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
-            }
+    // ...and only the faces still relying on advise() get polled.
+    if (_movement_advise_faces_dirty) {
+        _movement_rebuild_advise_faces();
+    }
 
-            // TODO: handle other advisory types
+    for(uint8_t j = 0; j < _movement_num_advise_faces; j++) {
+        uint8_t i = _movement_advise_faces[j];
+        // For each face that offers an advisory, we ask for one.
+        movement_watch_face_advisory_t advisory = watch_faces[i].advise(watch_face_contexts[i]);
+
+        // If it wants a background task...
+        if (advisory.wants_background_task) {
+            // we give it one. pretty straightforward!
+            movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+            watch_faces[i].loop(background_event, watch_face_contexts[i]);
         }
+
+        // TODO: handle other advisory types
     }
+    TICK_PROFILE_END(TICK_STAGE_ADVISORIES, advise_start);
     
     // Sleep Tracking Session Management
     // Track state transitions to start/end sleep sessions
@@ -546,109 +835,168 @@ static void _movement_handle_top_of_minute(void) {
             
             // Add night and persist
             circadian_data_add_night(&global_circadian_data, &night);
+#ifdef PHASE_ENGINE_ENABLED
+            // Re-center the phase engine's circadian curve on the new week of sleep
+            phase_learn_acrophase(&movement_state.phase, &global_circadian_data,
+                                  movement_get_current_timezone_offset());
+#endif
         }
     }
     
     was_in_sleep_window = now_in_sleep_window;
 
 #ifdef PHASE_ENGINE_ENABLED
-    // PR #66: Sample lux every minute (lightweight)
-    sensors_sample_lux(&movement_state.sensors);
-    
-    // Phase 3: Update metrics engine every 15 minutes
+    // Build this minute's calendar context: local time, day of year, moon age,
+    // today's homebase entry and sunrise/sunset (location from BKUP[1]), and the
+    // active hours window (BKUP[2]). The per-day parts only change at midnight.
+    calendar_context_t *cal = &movement_state.calendar;
+    movement_location_t location = {.reg = watch_get_backup_data(1)};
+    movement_active_hours_t active_hours = movement_get_active_hours();
+    calendar_context_update(cal,
+                            movement_get_local_date_time(),
+                            movement_get_current_timezone_offset(),
+                            location.bit.latitude,
+                            location.bit.longitude,
+                            active_hours.bit.enabled,
+                            active_hours.bit.start_quarter_hours,
+                            active_hours.bit.end_quarter_hours);
+    
+    // Phase 3: Update metrics engine on the adaptive cadence (metric_cadence.h)
     movement_state.metric_tick_count++;
     
     // Phase 4E: Track hourly boundaries for telemetry accumulation
     static uint8_t last_telemetry_hour = 255;  // Initialize to invalid hour
-    bool is_hourly_tick = (last_telemetry_hour != date_time.unit.hour);
+    bool is_hourly_tick = (last_telemetry_hour != cal->hour);
     if (is_hourly_tick) {
-        last_telemetry_hour = date_time.unit.hour;
+        last_telemetry_hour = cal->hour;
+    }
+    
+    // Zone faces sit at indices 2-5 (_movement_get_zone_face_index)
+    bool zone_face_visible = movement_state.current_face_idx >= 2 && movement_state.current_face_idx <= 5;
+    bool in_sleep_window = is_sleep_window();
+    // The epoch check can go stale if ticks stop, so the sleep window is re-checked here.
+    bool asleep = _movement_confirmed_asleep && in_sleep_window;
+    
+    // Sensors sample on their own per-context rates (sensors.c); the metrics
+    // below read whatever each one last took.
+    sensor_context_t sensor_context = SENSOR_CONTEXT_AWAKE;
+    if (zone_face_visible) {
+        sensor_context = SENSOR_CONTEXT_ZONE_FACE;
+    } else if (asleep) {
+        sensor_context = SENSOR_CONTEXT_ASLEEP;
+    } else if (in_sleep_window) {
+        sensor_context = SENSOR_CONTEXT_SLEEP_WINDOW;
+    }
+    TICK_PROFILE_BEGIN(sensors_start);
+    sensors_schedule_tick(&movement_state.sensors, sensor_context, cal->minute_of_day);
+    TICK_PROFILE_END(TICK_STAGE_SENSORS, sensors_start);
+    
+    uint8_t cadence_conditions = 0;
+    if (zone_face_visible) {
+        cadence_conditions |= METRIC_CADENCE_ZONE_FACE;
+    }
+    if (sensors_get_motion_variance(&movement_state.sensors) >= METRIC_CADENCE_HIGH_MOTION_VARIANCE) {
+        cadence_conditions |= METRIC_CADENCE_HIGH_MOTION;
     }
+    if (asleep) {
+        cadence_conditions |= METRIC_CADENCE_ASLEEP;
+    }
+    uint8_t cadence_interval = metric_cadence_interval(cadence_conditions);
     
-    if (movement_state.metric_tick_count >= 15) {
+    if (metric_cadence_due(cadence_interval, cal->minute_of_day, movement_state.metric_tick_count)) {
         movement_state.metric_tick_count = 0;
-        
-        // PR #65 + #66: Full sensor update (motion + lux + temperature)
-        sensors_update(&movement_state.sensors);
-        
-        // Gather current sensor readings
-        uint8_t hour = date_time.unit.hour;
-        uint8_t minute = date_time.unit.minute;
-        uint16_t day_of_year = date_time.unit.day;  // Simplified; actual day_of_year calculation needed
+        // Zone switching and anomaly chimes stay on quarter hours whatever the cadence,
+        // so playlist hysteresis and chime timing don't speed up with it.
+        bool is_quarter_hour = (cal->minute % 15) == 0;
         
         // Get sensor readings for phase engine
-        uint16_t activity_level = movement_state.cumulative_activity;
+        // How much the wrist has moved over the last few minutes, not how hard gravity
+        // pulls on it; without an accelerometer the phase engine scores against the
+        // circadian curve alone.
+        uint16_t activity_level = movement_state.has_lis2dw ? sensors_get_activity_level(&movement_state.sensors)
+                                                            : PHASE_ACTIVITY_NONE;
         int16_t temp_c10 = (int16_t)sensors_get_temperature_c10(&movement_state.sensors);
         uint16_t light_lux = sensors_get_lux_avg(&movement_state.sensors);
         
         // Compute phase score from real sensor data (Phase 4E/4F integration)
+        TICK_PROFILE_BEGIN(phase_start);
+        uint8_t history_index = movement_state.phase.history_index;
+        uint8_t history_count = movement_state.phase.history_count;
         uint16_t phase_score = phase_compute(&movement_state.phase,
-                                             hour,
-                                             day_of_year,
+                                             cal->hour,
+                                             cal->minute,
+                                             cal->day_of_year,
                                              activity_level,
                                              temp_c10,
                                              light_lux);
+        // Keep the hourly history across resets: save once per hour, as a new one starts.
+        if (movement_state.phase.history_index != history_index ||
+            movement_state.phase.history_count != history_count) {
+            _movement_phase_history_unsaved = true;
+            // The baseline moves by an eighth of a day per hour; every six hours is plenty.
+            if (cal->hour % 6 == 0) _movement_activity_baseline_unsaved = true;
+        }
+        if (_movement_phase_history_unsaved) {
+            _movement_phase_history_unsaved = !phase_history_save(&movement_state.phase, watch_rtc_get_unix_time());
+        }
+        if (_movement_activity_baseline_unsaved) {
+            _movement_activity_baseline_unsaved = !activity_baseline_save(&movement_state.phase.baseline);
+        }
+        TICK_PROFILE_END(TICK_STAGE_PHASE, phase_start);
         
         // Update metrics engine (sensors passed directly for cleaner API)
+        TICK_PROFILE_BEGIN(metrics_start);
         metrics_update(&movement_state.metrics,
                       &movement_state.sensors,
-                      hour, minute, day_of_year,
+                      cal,
                       (uint8_t)phase_score,
                       movement_state.cumulative_activity,
                       &global_circadian_data,
-                      NULL,  // homebase - requires Phase 2 homebase integration
                       movement_state.has_lis2dw);
+        TICK_PROFILE_END(TICK_STAGE_METRICS, metrics_start);
         
         // Update playlist controller
         metrics_snapshot_t snapshot;
         metrics_get(&movement_state.metrics, &snapshot);
         
-        // Get previous zone before update
-        phase_zone_t prev_zone = playlist_get_zone(&movement_state.playlist);
-        
-        // Phase 4F: Get active hours configuration for sleep mode enforcement
-        movement_active_hours_t active_hours = movement_get_active_hours();
-        
-        // Clamp to valid range before division (96 quarter-hours = 24 hours)
-        uint8_t start_qh = active_hours.bit.start_quarter_hours;
-        uint8_t end_qh = active_hours.bit.end_quarter_hours;
-        
-        if (start_qh > 95) start_qh = 95;
-        if (end_qh > 95) end_qh = 95;
-        
-        uint8_t active_start = start_qh / 4;  // Convert to hours
-        uint8_t active_end = end_qh / 4;      // Convert to hours
-        
-        // Get recent movement for all-nighter detection
-        uint16_t movement_this_minute = sensors_get_hourly_movement_count(&movement_state.sensors);
-        
-        // Update playlist (simplified - sleep mode logic removed from Phase 4F)
-        playlist_update(&movement_state.playlist, phase_score, &snapshot);
-        
-        // Phase 4B: If playlist mode is active and zone changed, switch to zone face
-        if (movement_state.playlist_mode_active) {
-            phase_zone_t new_zone = playlist_get_zone(&movement_state.playlist);
+        if (is_quarter_hour) {
+            // Get previous zone before update
+            phase_zone_t prev_zone = playlist_get_zone(&movement_state.playlist);
             
-            // Only switch faces on zone changes (debounced by playlist hysteresis)
-            if (new_zone != prev_zone) {
-                uint8_t zone_face_idx = _movement_get_zone_face_index(new_zone);
-                movement_move_to_face(zone_face_idx);
+            // Get recent movement for all-nighter detection
+            uint16_t movement_this_minute = sensors_get_hourly_movement_count(&movement_state.sensors);
+            
+            // Update playlist (simplified - sleep mode logic removed from Phase 4F)
+            TICK_PROFILE_BEGIN(playlist_start);
+            playlist_update(&movement_state.playlist, phase_score, &snapshot);
+            TICK_PROFILE_END(TICK_STAGE_PLAYLIST, playlist_start);
+            
+            // Phase 4B: If playlist mode is active and zone changed, switch to zone face
+            if (movement_state.playlist_mode_active) {
+                phase_zone_t new_zone = playlist_get_zone(&movement_state.playlist);
+                
+                // Only switch faces on zone changes (debounced by playlist hysteresis)
+                if (new_zone != prev_zone) {
+                    uint8_t zone_face_idx = _movement_get_zone_face_index(new_zone);
+                    movement_move_to_face(zone_face_idx);
+                }
             }
+            
+            // Phase 4D: Detect anomalies and trigger chimes if needed
+            phase_detect_anomalies(&movement_state.phase,
+                                  snapshot.sd,
+                                  snapshot.em,
+                                  snapshot.energy,
+                                  snapshot.comfort,
+                                  cal->hour,
+                                  cal->active_hours_enabled,
+                                  cal->active_start_hour,
+                                  cal->active_end_hour);
         }
         
-        // Phase 4D: Detect anomalies and trigger chimes if needed
-        phase_detect_anomalies(&movement_state.phase,
-                              snapshot.sd,
-                              snapshot.em,
-                              snapshot.energy,
-                              snapshot.comfort,
-                              hour,
-                              active_hours.bit.enabled,
-                              active_start,
-                              active_end);
-        
         // Phase 4E: Accumulate telemetry every hour
         if (is_hourly_tick) {
+            TICK_PROFILE_BEGIN(telemetry_start);
             // Get current zone
             phase_zone_t current_zone = playlist_get_zone(&movement_state.playlist);
             
@@ -656,8 +1004,8 @@ static void _movement_handle_top_of_minute(void) {
             uint8_t light_minutes = sensors_get_hourly_light_minutes(&movement_state.sensors);
             uint8_t motion_interrupts = sensors_get_hourly_movement_count(&movement_state.sensors);
             
-            // Get battery voltage (in millivolts)
-            uint16_t battery_mv = watch_get_vcc_voltage();
+            // Get battery voltage (in millivolts), sampled at the top of the hour
+            uint16_t battery_mv = sensors_get_vcc_mv(&movement_state.sensors);
             
             // Get previous hour's metrics for confidence calculation
             // For simplicity, use a static buffer to track last hour's values
@@ -674,7 +1022,7 @@ static void _movement_handle_top_of_minute(void) {
             // Accumulate telemetry
             if (prev_snapshot_valid) {
                 sleep_data_accumulate_telemetry(&movement_state.sleep_telemetry,
-                                               hour,
+                                               cal->hour,
                                                current_zone,
                                                prev_zone_hourly,
                                                dominant,
@@ -697,38 +1045,21 @@ static void _movement_handle_top_of_minute(void) {
             sensors_reset_hourly_counters(&movement_state.sensors);
             
             // Reset midnight telemetry at hour 0
-            if (hour == 0) {
+            if (cal->hour == 0) {
                 sleep_data_reset_daily_telemetry(&movement_state.sleep_telemetry);
             }
+            TICK_PROFILE_END(TICK_STAGE_TELEMETRY, telemetry_start);
         }
     }
 #endif
 
+    TICK_PROFILE_END(TICK_STAGE_TOTAL, total_start);
 }
 
 static void _movement_handle_scheduled_tasks(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    uint8_t num_active_tasks = 0;
-
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg) {
-            if (scheduled_tasks[i].reg <= date_time.reg) {
-                scheduled_tasks[i].reg = 0;
-                movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
-                // check if loop scheduled a new task
-                if (scheduled_tasks[i].reg) {
-                    num_active_tasks++;
-                }
-            } else {
-                num_active_tasks++;
-            }
-        }
-    }
+    _movement_dispatch_background_tasks(watch_rtc_get_unix_time());
 
-    if (num_active_tasks == 0) {
-        movement_state.has_scheduled_background_task = false;
-    } else {
+    if (_movement_num_scheduled_tasks) {
         _movement_reset_inactivity_countdown();
     }
 }
@@ -953,23 +1284,94 @@ void movement_cancel_background_task(void) {
 }
 
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
-    watch_date_time_t now = watch_rtc_get_date_time();
-    if (date_time.reg > now.reg) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    // tasks are compared against the RTC's date/time as-is, so convert without applying an offset.
+    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, 0);
+    if (timestamp > watch_rtc_get_unix_time()) {
+        movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+        if (!entry->task_due) _movement_num_scheduled_tasks++;
+        entry->task_due = timestamp;
+        _movement_wake_heap_update(watch_face_index);
         movement_state.has_scheduled_background_task = true;
-        scheduled_tasks[watch_face_index].reg = date_time.reg;
     }
 }
 
 void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
-    scheduled_tasks[watch_face_index].reg = 0;
-    bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg != 0) {
-            other_tasks_scheduled = true;
-            break;
-        }
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+    if (entry->task_due) {
+        entry->task_due = 0;
+        _movement_num_scheduled_tasks--;
+        _movement_wake_heap_update(watch_face_index);
     }
-    movement_state.has_scheduled_background_task = other_tasks_scheduled;
+    movement_state.has_scheduled_background_task = (_movement_num_scheduled_tasks != 0);
+}
+
+void movement_set_background_wake_never(uint8_t watch_face_index) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+    entry->mode = MOVEMENT_WAKE_NEVER;
+    entry->wake_due = 0;
+    _movement_wake_heap_update(watch_face_index);
+    _movement_advise_faces_dirty = true;
+}
+
+void movement_set_background_wake_at(uint8_t watch_face_index, uint32_t timestamp) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+    entry->mode = MOVEMENT_WAKE_AT;
+    entry->wake_due = (timestamp > watch_rtc_get_unix_time()) ? timestamp : 0;
+    _movement_wake_heap_update(watch_face_index);
+    _movement_advise_faces_dirty = true;
+}
+
+void movement_set_background_wake_interval(uint8_t watch_face_index, uint16_t minutes) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+    if (minutes == 0) {
+        movement_set_background_wake_never(watch_face_index);
+        return;
+    }
+
+    movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+    // setup is called again after every wake from low energy mode; don't disturb an identical registration.
+    if (entry->mode == MOVEMENT_WAKE_PERIODIC && entry->interval == minutes && entry->wake_due) return;
+
+    entry->mode = MOVEMENT_WAKE_PERIODIC;
+    entry->interval = minutes;
+    entry->wake_due = _movement_next_periodic_wake(watch_rtc_get_unix_time(), minutes);
+    _movement_wake_heap_update(watch_face_index);
+    _movement_advise_faces_dirty = true;
+}
+
+void movement_set_background_wake_advise(uint8_t watch_face_index) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    movement_wake_entry_t *entry = &_movement_wake_entries[watch_face_index];
+    entry->mode = MOVEMENT_WAKE_ADVISE;
+    entry->wake_due = 0;
+    _movement_wake_heap_update(watch_face_index);
+    _movement_advise_faces_dirty = true;
+}
+
+void movement_set_low_energy_update_interval(uint8_t watch_face_index, uint16_t minutes) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return;
+
+    _movement_wake_entries[watch_face_index].le_interval = minutes;
+}
+
+watch_rtc_timer_t movement_schedule_timer(uint32_t ticks, uint16_t slack, watch_cb_t callback) {
+    watch_rtc_timer_t timer = watch_rtc_add_timer_no_schedule(callback, watch_rtc_get_counter() + ticks, slack);
+    if (timer != WATCH_RTC_TIMER_NONE) movement_volatile_state.schedule_next_comp = true;
+    return timer;
+}
+
+void movement_cancel_timer(watch_rtc_timer_t timer) {
+    watch_rtc_cancel_timer_no_schedule(timer);
+    movement_volatile_state.schedule_next_comp = true;
 }
 
 void movement_request_sleep(void) {
@@ -1089,7 +1491,15 @@ int32_t movement_get_timezone_index(void) {
 }
 
 void movement_set_timezone_index(uint8_t value) {
+#ifdef PHASE_ENGINE_ENABLED
+    int32_t old_offset = movement_get_current_timezone_offset();
+#endif
     movement_state.settings.bit.time_zone = value;
+#ifdef PHASE_ENGINE_ENABLED
+    // A new zone moves the local clock; the JL metric tracks the body clock catching up.
+    // Held until the wearer leaves the face, which may step through several zones first.
+    metrics_hold_time_shift(&movement_state.metrics, movement_get_current_timezone_offset() - old_offset);
+#endif
 }
 
 watch_date_time_t movement_get_utc_date_time(void) {
@@ -1132,6 +1542,12 @@ void movement_set_local_date_time(watch_date_time_t date_time) {
 }
 
 void movement_set_utc_timestamp(uint32_t timestamp) {
+#ifdef PHASE_ENGINE_ENABLED
+    // Setting the clock by hand on arrival, rather than the zone, is a shift too.
+    // The settings face steps it an hour per press, so only the net change is
+    // recorded, when the wearer leaves the face.
+    metrics_hold_time_shift(&movement_state.metrics, (int32_t)(timestamp - watch_rtc_get_unix_time()));
+#endif
     watch_rtc_set_unix_time(timestamp);
 
     // If the time was changed, the top of the minute alarm needs to be reset accordingly
@@ -1141,6 +1557,9 @@ void movement_set_utc_timestamp(uint32_t timestamp) {
     // they may have just crossed a DST boundary, which means the next call to this function
     // could require a different offset to force local time back to UTC. Quelle horreur!
     _movement_update_dst_offset_cache();
+
+    // periodic background wakes are aligned to the clock, so line them back up with the new time.
+    _movement_reschedule_periodic_wakes();
 }
 
 
@@ -1371,26 +1790,31 @@ void movement_set_reserved(movement_reserved_t settings) {
     watch_store_backup_data(settings.reg, 3);
 }
 
-float movement_get_temperature(void) {
-    float temperature_c = (float)0xFFFFFFFF;
+int16_t movement_get_temperature_c100(void) {
+    int16_t temperature_c100 = MOVEMENT_TEMPERATURE_NONE;
 #if __EMSCRIPTEN__
-    temperature_c = EM_ASM_DOUBLE({
-        return temp_c || 25.0;
+    temperature_c100 = EM_ASM_INT({
+        return Math.round((temp_c || 25.0) * 100);
     });
 #else
 
     if (movement_state.has_thermistor) {
         thermistor_driver_enable();
-        temperature_c = thermistor_driver_get_temperature();
+        temperature_c100 = thermistor_driver_get_temperature_c100();
         thermistor_driver_disable();
     } else if (movement_state.has_lis2dw) {
-            int16_t val = lis2dw_get_temperature();
-            val = val >> 4;
-            temperature_c = 25 + (float)val / 16.0;
+        temperature_c100 = watch_utility_lis2dw_temperature_c100(lis2dw_get_temperature());
     }
 #endif
 
-    return temperature_c;
+    return temperature_c100;
+}
+
+float movement_get_temperature(void) {
+    int16_t temperature_c100 = movement_get_temperature_c100();
+    if (temperature_c100 == MOVEMENT_TEMPERATURE_NONE) return (float)0xFFFFFFFF;
+
+    return temperature_c100 / 100.0f;
 }
 
 void app_init(void) {
@@ -1522,6 +1946,10 @@ void app_init(void) {
     watch_register_led_fade_callback(cb_led_fade_step);
 #endif
 
+#ifdef PHASE_TICK_PROFILE
+    tick_profile_init();
+#endif
+
     // populate the DST offset cache
     _movement_update_dst_offset_cache();
 
@@ -1532,6 +1960,13 @@ void app_init(void) {
     movement_state.light_on = false;
     // Reserve BKUP[0-3] for movement core (settings, location, active_hours, reserved)
     movement_state.next_available_backup_register = 4;
+    // Nothing owns a storage region until it claims one in setup
+    watch_storage_region_init();
+
+    // button longpresses and the minute alarm keep exact timing; the rest can be coalesced.
+    watch_rtc_set_comp_callback_slack(LED_TIMEOUT, MOVEMENT_LED_TIMEOUT_SLACK_TICKS);
+    watch_rtc_set_comp_callback_slack(RESIGN_TIMEOUT, MOVEMENT_INACTIVITY_TIMEOUT_SLACK_TICKS);
+    watch_rtc_set_comp_callback_slack(SLEEP_TIMEOUT, MOVEMENT_INACTIVITY_TIMEOUT_SLACK_TICKS);
     _movement_reset_inactivity_countdown();
 
     // set up the 1 minute alarm (for background tasks and low power updates)
@@ -1553,7 +1988,11 @@ void app_setup(void) {
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_face_contexts[i] = NULL;
-            scheduled_tasks[i].reg = 0;
+            _movement_wake_entries[i].task_due = 0;
+            _movement_wake_entries[i].wake_due = 0;
+            _movement_wake_entries[i].le_interval = 1;
+            _movement_wake_entries[i].mode = MOVEMENT_WAKE_ADVISE;
+            _movement_wake_entries[i].heap_pos = MOVEMENT_WAKE_NOT_QUEUED;
             is_first_launch = false;
         }
 
@@ -1663,12 +2102,14 @@ void app_setup(void) {
         // Phase 4D: Initialize phase engine (for anomaly detection)
         memset(&movement_state.phase, 0, sizeof(phase_state_t));
         phase_engine_init(&movement_state.phase);
+        phase_history_load(&movement_state.phase, watch_rtc_get_unix_time());
+        activity_baseline_load(&movement_state.phase.baseline);
         
         // Phase 4E: Initialize sleep tracking and telemetry
         sleep_data_init(&movement_state.sleep_telemetry);
         
         // Phase 4A: Initialize sensor state (PR #65 + #66)
-        sensors_init(&movement_state.sensors, movement_state.has_lis2dw);
+        sensors_init(&movement_state.sensors, movement_state.has_lis2dw, movement_state.has_thermistor);
         if (movement_state.has_lis2dw) {
             sensors_configure_accel(&movement_state.sensors);
         }
@@ -1697,17 +2138,93 @@ void app_setup(void) {
             
             // Sync Active Hours from BKUP[2]
             active_hours_config_t config = get_active_hours();
-            global_circadian_data.active_hours_start_min = (config.start * 15);  // Convert quarters to minutes
-            global_circadian_data.active_hours_end_min = (config.end * 15);
-            circadian_data_save_to_flash(&global_circadian_data);
+            uint16_t start_min = config.start * 15;  // Convert quarters to minutes
+            uint16_t end_min = config.end * 15;
+            // Only append a snapshot if something changed; every boot would otherwise cost a row erase
+            if (global_circadian_data.active_hours_start_min != start_min ||
+                global_circadian_data.active_hours_end_min != end_min) {
+                global_circadian_data.active_hours_start_min = start_min;
+                global_circadian_data.active_hours_end_min = end_min;
+                circadian_data_save_to_flash(&global_circadian_data);
+            }
             
             circadian_data_initialized = true;
         }
+#ifdef PHASE_ENGINE_ENABLED
+        phase_learn_acrophase(&movement_state.phase, &global_circadian_data,
+                              movement_get_current_timezone_offset());
+#endif
     }
 }
 
 #ifndef MOVEMENT_LOW_ENERGY_MODE_FORBIDDEN
 
+#ifdef MOVEMENT_TICKLESS_LOW_ENERGY
+// Never sleep through more than a day at once, so a missed wake source can't leave the display stale for longer than that.
+#define MOVEMENT_TICKLESS_MAX_MINUTES 1440
+
+// Minutes from the current minute of day until the next time the clock reads target_minute_of_day (1 to 1440).
+static uint32_t _movement_minutes_until(uint16_t now_minute_of_day, uint16_t target_minute_of_day) {
+    uint16_t delta = (target_minute_of_day + 1440 - now_minute_of_day) % 1440;
+    return delta ? delta : 1440;
+}
+
+// Works out how many top-of-minute wakeups we can sleep through: the earliest of the current face's next display
+// change, the next background wake in the registry, the next DST transition and the next sleep window boundary.
+// Called right after the top of minute has been handled, so 1 means "wake at the next minute, as usual".
+static uint16_t _movement_tickless_minutes_to_skip(void) {
+#ifdef PHASE_ENGINE_ENABLED
+    // the phase engine samples lux and counts metric ticks every minute; it can't skip any.
+    return 1;
+#else
+    if (_movement_advise_faces_dirty) {
+        _movement_rebuild_advise_faces();
+    }
+    // a face that relies on advise() has to be polled every minute, since we can't know when it will want to run.
+    if (_movement_num_advise_faces) return 1;
+
+    uint32_t now = watch_rtc_get_unix_time();
+    uint32_t minute_start = now - (now % 60);
+    uint32_t deadline = minute_start + MOVEMENT_TICKLESS_MAX_MINUTES * 60;
+
+    uint16_t le_interval = _movement_wake_entries[movement_state.current_face_idx].le_interval;
+    if (le_interval) {
+        uint32_t next_update = _movement_next_periodic_wake(now, le_interval);
+        if (next_update < deadline) deadline = next_update;
+    }
+    if (_movement_wake_heap_len) {
+        uint32_t next_wake = _movement_wake_key(_movement_wake_heap[0]);
+        if (next_wake < deadline) deadline = next_wake;
+    }
+    if (_movement_dst_next_check < deadline) deadline = _movement_dst_next_check;
+
+    // sleep sessions start and end on active hours boundaries, and sleep data is saved hourly inside the sleep window.
+    movement_active_hours_t active_hours = movement_get_active_hours();
+    if (active_hours.bit.enabled) {
+        watch_date_time_t date_time = watch_rtc_get_date_time();
+        uint16_t minute_of_day = date_time.unit.hour * 60 + date_time.unit.minute;
+        uint32_t minutes = _movement_minutes_until(minute_of_day, active_hours.bit.start_quarter_hours * 15);
+        uint32_t to_end = _movement_minutes_until(minute_of_day, active_hours.bit.end_quarter_hours * 15);
+        if (to_end < minutes) minutes = to_end;
+        if (movement_state.has_lis2dw && is_sleep_window() && (60 - date_time.unit.minute) < minutes) minutes = 60 - date_time.unit.minute;
+        if (minute_start + minutes * 60 < deadline) deadline = minute_start + minutes * 60;
+    }
+
+    // the top of minute handler runs on the first minute at or after the deadline.
+    if (deadline <= minute_start + 60) return 1;
+    return (deadline - minute_start + 59) / 60;
+#endif
+}
+
+static void _movement_defer_top_of_minute_alarm(uint16_t minutes) {
+    // Push the alarm we just renewed out by the minutes nobody needs. Still counted from the previous alarm, so no drift.
+    movement_volatile_state.minute_counter += (uint32_t)(minutes - 1) * watch_rtc_get_ticks_per_minute();
+    watch_rtc_register_comp_callback_no_schedule(cb_minute_alarm_fired, movement_volatile_state.minute_counter, MINUTE_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+    _movement_tickless_alarm_deferred = true;
+}
+#endif
+
 static void _sleep_mode_app_loop(void) {
     // as long as we are in low energy mode, we wake up here, update the screen, and go right back to sleep.
     while (movement_volatile_state.is_sleeping) {
@@ -1720,7 +2237,8 @@ static void _sleep_mode_app_loop(void) {
         }
 
         // we also have to handle top-of-the-minute tasks here in the mini-runloop
-        if (movement_volatile_state.minute_alarm_fired) {
+        bool top_of_minute = movement_volatile_state.minute_alarm_fired;
+        if (top_of_minute) {
             movement_volatile_state.minute_alarm_fired = false;
             _movement_renew_top_of_minute_alarm();
             _movement_handle_top_of_minute();
@@ -1731,6 +2249,14 @@ static void _sleep_mode_app_loop(void) {
         event.subsecond = 0;
         watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
 
+#ifdef MOVEMENT_TICKLESS_LOW_ENERGY
+        // if nothing needs the next few top-of-minute wakeups, sleep straight through them.
+        if (top_of_minute && !movement_volatile_state.exit_sleep_mode) {
+            uint16_t minutes = _movement_tickless_minutes_to_skip();
+            if (minutes > 1) _movement_defer_top_of_minute_alarm(minutes);
+        }
+#endif
+
         // If any of the previous loops requested to wake up, do it!
         if (movement_volatile_state.exit_sleep_mode) {
             movement_volatile_state.exit_sleep_mode = false;
@@ -1756,6 +2282,9 @@ static bool _switch_face(void) {
     const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
 
     wf->resign(watch_face_contexts[movement_state.current_face_idx]);
+#ifdef PHASE_ENGINE_ENABLED
+    metrics_flush_time_shift(&movement_state.metrics, watch_rtc_get_unix_time() / 60);
+#endif
     movement_state.current_face_idx = movement_state.next_face_idx;
     // we have just updated the face idx, so we must recache the watch face pointer.
     wf = &watch_faces[movement_state.current_face_idx];
@@ -1819,6 +2348,11 @@ bool app_loop(void) {
     }
 
 #ifdef PHASE_ENGINE_ENABLED
+    if (movement_volatile_state.has_pending_fifo) {
+        movement_volatile_state.has_pending_fifo = false;
+        sensors_drain_fifo(&movement_state.sensors);
+    }
+
     // Phase 4E: Track per-second light exposure and epoch sleep state
     if (pending_events & (1 << EVENT_TICK)) {
         // Tick epoch counter for light exposure tracking
@@ -1830,13 +2364,23 @@ bool app_loop(void) {
             movement_state.sensors.epoch_seconds = 0;
             
             // Record epoch if we're in sleep window and confirmed asleep
-            if (is_sleep_window() && is_confirmed_asleep()) {
+            _movement_confirmed_asleep = is_sleep_window() && is_confirmed_asleep();
+            if (_movement_confirmed_asleep) {
+                // Samples since the last watermark belong to this epoch too
+                sensors_drain_fifo(&movement_state.sensors);
                 uint8_t movement_count = sensors_get_epoch_movement_count(&movement_state.sensors);
                 sleep_data_record_epoch(&movement_state.sleep_telemetry, movement_count);
                 
                 // Reset epoch counter for next 30-second window
                 movement_state.sensors.epoch_movement_count = 0;
             }
+
+            // Batch the accelerometer through the FIFO only while asleep; awake, INT1 goes back to wake-up.
+            if (_movement_confirmed_asleep && !sensors_is_batching(&movement_state.sensors)) {
+                sensors_begin_batching(&movement_state.sensors);
+            } else if (!_movement_confirmed_asleep && sensors_is_batching(&movement_state.sensors)) {
+                sensors_end_batching(&movement_state.sensors);
+            }
         }
     }
 #endif
@@ -1915,6 +2459,13 @@ bool app_loop(void) {
         // or wake is requested using the movement_request_wake function.
         _sleep_mode_app_loop();
         // as soon as _sleep_mode_app_loop returns, we prepare to reactivate
+#ifdef MOVEMENT_TICKLESS_LOW_ENERGY
+        // back in active mode, faces expect the minute alarm every minute again.
+        if (_movement_tickless_alarm_deferred) {
+            _movement_tickless_alarm_deferred = false;
+            _movement_set_top_of_minute_alarm();
+        }
+#endif
 
         // // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
         // // need to figure out if there's a better heuristic for determining how we woke up.
@@ -2164,6 +2715,14 @@ void cb_tick(void) {
 }
 
 void cb_accelerometer_event(void) {
+#ifdef PHASE_ENGINE_ENABLED
+    // While sleep epochs are batched, INT1 is the FIFO watermark: app_loop drains it.
+    if (movement_state.sensors.batching) {
+        movement_volatile_state.has_pending_fifo = true;
+        return;
+    }
+#endif
+
     movement_volatile_state.has_pending_accelerometer = true;
     
 #ifdef PHASE_ENGINE_ENABLED
@@ -2196,12 +2755,9 @@ void sleep_tracking_init(void) {
 
 // Load sleep data from flash storage
 void sleep_tracking_load_from_flash(void) {
-    uint8_t buffer[sizeof(sleep_data_t)];
-    
-    // Read from flash storage row
-    if (watch_storage_read(SLEEP_STORAGE_ROW, 0, buffer, sizeof(sleep_data_t))) {
-        memcpy(&sleep_data, buffer, sizeof(sleep_data_t));
-        
+    // Recovers the newest complete snapshot, even if the last save was cut short
+    if (watch_storage_log_open(&sleep_log, SLEEP_STORAGE_LOG, sizeof(sleep_data_t), SLEEP_STORAGE_LOG_ROWS) &&
+        watch_storage_log_read(&sleep_log, 0, &sleep_data)) {
         // Validate the loaded data
         if (sleep_data.current_index >= SLEEP_NIGHTS_STORED) {
             // Invalid data, initialize fresh
@@ -2215,21 +2771,23 @@ void sleep_tracking_load_from_flash(void) {
     }
 }
 
+// Runs from the flash ready interrupt. The snapshot was copied when it was queued, so a failed
+// write just has to mark the data dirty again for the next save to retry.
+static void _sleep_tracking_save_done(bool success, void *context) {
+    (void) context;
+    if (!success) sleep_data_dirty = true;
+}
+
 // Save sleep data to flash storage (batched to reduce write cycles)
 void sleep_tracking_save_to_flash(void) {
     if (!sleep_data_dirty) {
         return;  // No changes to save
     }
     
-    // Erase the row first (required before write)
-    watch_storage_erase(SLEEP_STORAGE_ROW);
-    
-    // Write the data
-    watch_storage_write(SLEEP_STORAGE_ROW, 0, (const uint8_t *)&sleep_data, sizeof(sleep_data_t));
-    
-    // Wait for write to complete
-    watch_storage_sync();
-    
+    // Two snapshots fit in a row, so this only erases a row every other save. It's queued rather
+    // than written here: the ready interrupt finishes it while the top-of-minute handler moves on.
+    if (!watch_storage_log_append_async(&sleep_log, &sleep_data, _sleep_tracking_save_done, NULL)) return;
+
     sleep_data_dirty = false;
 }
 
@@ -36,7 +36,8 @@
 #define SLEEP_BIN_MINUTES 15            // Minutes per bin (60 min/hour ÷ 4 bins/hour)
 #define SLEEP_BYTES_PER_NIGHT 8         // 32 bins × 2 bits / 8 bits per byte
 #define SLEEP_NIGHTS_STORED 7           // 7-day rolling window
-#define SLEEP_STORAGE_ROW 30            // Flash storage row for sleep orientation data
+#define SLEEP_STORAGE_LOG "sleep"       // Flash storage log for sleep orientation data
+#define SLEEP_STORAGE_LOG_ROWS 3        // Rows in its ring, two snapshots each
 
 // Orientation constants (2-bit values)
 #define SLEEP_ORIENTATION_UNKNOWN 0
@@ -69,6 +70,7 @@ uint8_t sleep_tracking_count_orientation_changes(const sleep_night_t *night);
 #include "playlist.h"
 #include "sensors.h"
 #include "phase_engine.h"
+#include "calendar_context.h"
 #include "sleep_data.h"
 #include "circadian_score.h"
 #endif // PHASE_ENGINE_ENABLED
@@ -298,6 +300,10 @@ typedef void (*watch_face_resign)(void *context);
   *          immediately call your loop function with an EVENT_BACKGROUND_TASK event. Note that it will not call your
   *          activate or deactivate functions, since you are not going on screen.
   *
+  *          If you know ahead of time when you need to run, prefer registering with movement_set_background_wake_at,
+  *          movement_set_background_wake_interval or movement_set_background_wake_never instead. Once a face has
+  *          registered, Movement stops polling its advise function and only wakes it when it is actually due.
+  *
   *          Examples of background tasks:
   *           - Wake and play a sound when an alarm or timer has been triggered.
   *           - Check the state of an RTC interrupt pin or the timestamp of an RTC interrupt event.
@@ -372,12 +378,16 @@ typedef struct {
     sleep_telemetry_state_t sleep_telemetry;
     
     // Playlist integration state
-    uint16_t metric_tick_count;     // Counter for 15-minute metric updates
+    uint16_t metric_tick_count;     // Minutes since metrics last ran (metric_cadence.h)
     uint16_t cumulative_activity;    // Activity accumulator since wake
     bool playlist_mode_active;       // True when playlist controls face rotation
     
     // Phase 4A: Sensor state (PR #65: motion, PR #66: lux + temperature)
     struct sensor_state_t sensors;
+
+    // Local date/time, day of year, moon age, homebase, sunrise/sunset and
+    // active hours, rebuilt at the top of every minute
+    calendar_context_t calendar;
 #endif
 } movement_state_t;
 
@@ -404,6 +414,29 @@ void movement_cancel_background_task(void);
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+// Background wake registry: declare when a face needs EVENT_BACKGROUND_TASK instead of answering advise() every minute.
+// Registered faces are kept in a min-heap by due time, so Movement only dispatches to the faces that are due.
+// Wake once at the given UTC timestamp. Call again from EVENT_BACKGROUND_TASK to schedule the next one.
+void movement_set_background_wake_at(uint8_t watch_face_index, uint32_t timestamp);
+// Wake every `minutes` minutes, aligned to multiples of that interval in UTC (e.g. 60 = top of every UTC hour).
+void movement_set_background_wake_interval(uint8_t watch_face_index, uint16_t minutes);
+// Never wake this face for a background task (its advise function, if any, is no longer polled).
+void movement_set_background_wake_never(uint8_t watch_face_index);
+// Go back to polling the face's advise function every minute. This is the default for every face.
+void movement_set_background_wake_advise(uint8_t watch_face_index);
+
+// How often the face's EVENT_LOW_ENERGY_UPDATE display actually changes, in minutes (default 1, 0 = never), aligned
+// like movement_set_background_wake_interval. In builds with MOVEMENT_TICKLESS_LOW_ENERGY, Movement uses this to sleep
+// through top-of-minute wakeups that nothing needs while this face is on screen.
+void movement_set_low_energy_update_interval(uint8_t watch_face_index, uint16_t minutes);
+
+// One-shot timers that don't need a movement_timeout_index_t slot. `callback` runs `ticks` RTC ticks (128 per second)
+// from now, or up to `slack` ticks later if that lets it share a wakeup with another timer. It runs in interrupt
+// context, so just set a flag there and do the work in your loop. Returns WATCH_RTC_TIMER_NONE if no timer is free.
+watch_rtc_timer_t movement_schedule_timer(uint32_t ticks, uint16_t slack, watch_cb_t callback);
+// Cancels a timer from movement_schedule_timer. Does nothing if it has already fired.
+void movement_cancel_timer(watch_rtc_timer_t timer);
+
 void movement_request_sleep(void);
 void movement_request_wake(void);
 
@@ -489,8 +522,13 @@ movement_reserved_t movement_get_reserved(void);
 /** @brief Set the reserved register settings (BKUP[3]). */
 void movement_set_reserved(movement_reserved_t settings);
 
-// If the board has a temperature sensor, this function will give you the temperature in degrees celsius.
-// If the board has multiple temperature sensors, it will use the most accurate one available.
+// If the board has a temperature sensor, this function will give you the temperature in hundredths of a
+// degree celsius, in integer math. If the board has multiple temperature sensors, it will use the most
+// accurate one available. If the board has no temperature sensors, it will return MOVEMENT_TEMPERATURE_NONE.
+#define MOVEMENT_TEMPERATURE_NONE INT16_MIN
+int16_t movement_get_temperature_c100(void);
+
+// As movement_get_temperature_c100, in degrees celsius as a float.
 // If the board has no temperature sensors, it will return 0xFFFFFFFF.
 float movement_get_temperature(void);
 
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 
 #include "filesystem.h"
+#include "tick_profile.h"
 #include "watch.h"
 #include "delay.h"
 
@@ -114,6 +115,13 @@ shell_command_t g_shell_commands[] = {
         .max_args = 2,
         .cb = stress_cmd,
     },
+    {
+        .name = "perf",
+        .help = "minute handler timing and counters; usage: perf [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = tick_profile_cmd_perf,
+    },
 };
 
 const size_t g_num_shell_commands = sizeof(g_shell_commands) / sizeof(shell_command_t);
@@ -0,0 +1,446 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: microbenchmarks
+ *
+ * Times the per-minute and per-night entry points of the phase engine over a
+ * simulated year of synthetic sensor input, and reports nanoseconds per call.
+ * Each benchmark runs several times and keeps the fastest pass, which is the
+ * one least disturbed by whatever else the machine was doing.
+ *
+ *   bench_host                          print timings
+ *   bench_host --record FILE            print timings and save them as the baseline
+ *   bench_host --compare FILE           print timings against the baseline, and
+ *              [--threshold PCT]        exit 1 if any got more than PCT% slower
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_stubs.h"
+#include "phase_engine.h"
+#include "homebase.h"
+#include "metrics.h"
+#include "calendar_context.h"
+#include "circadian_score.h"
+#include "sensors.h"
+#include "sleep_data.h"
+#include "solar.h"
+#include "sunriset.h"
+#include "watch_utility.h"
+
+#define BENCH_DAYS 365
+#define BENCH_MINUTES (BENCH_DAYS * 1440)
+#define BENCH_EPOCHS_PER_NIGHT 960
+#define BENCH_SCORE_REPEATS 64          // circadian_score runs once a day; repeat it so the pass is long enough to time
+#define BENCH_SOLAR_LOCATIONS 8
+#define BENCH_PASSES 5
+#define BENCH_DEFAULT_THRESHOLD 25.0
+
+typedef struct {
+    uint16_t activity;                  // 0-1000
+    uint16_t variance;
+    int16_t temp_c10;
+    uint16_t lux;
+} bench_minute_t;
+
+typedef struct {
+    const char *name;
+    double (*run)(void);                // returns ns per call for one pass
+    double ns_per_call;
+} bench_t;
+
+static bench_minute_t *_year;
+static uint8_t _epochs[BENCH_DAYS][BENCH_EPOCHS_PER_NIGHT];
+static volatile uint32_t _sink;         // keeps the compiler from dropping calls whose results we ignore
+
+// ============================================================================
+// Synthetic year
+// ============================================================================
+
+static uint32_t _rng_state = 0x2026u;
+
+static uint32_t _rng(void) {
+    // xorshift32: deterministic, so every run times the same input.
+    _rng_state ^= _rng_state << 13;
+    _rng_state ^= _rng_state >> 17;
+    _rng_state ^= _rng_state << 5;
+    return _rng_state;
+}
+
+static void _build_year(void) {
+    _year = malloc(sizeof(bench_minute_t) * BENCH_MINUTES);
+    if (_year == NULL) {
+        fprintf(stderr, "bench: out of memory\n");
+        exit(2);
+    }
+
+    for (uint32_t day = 0; day < BENCH_DAYS; day++) {
+        // seasonal swing: coldest and darkest around day 15, warmest around day 197.
+        int32_t season = (int32_t)((day + 168) % 365) - 182;
+        if (season < 0) season = -season;
+        int16_t base_temp = (int16_t)(280 - season * 2);
+        uint16_t base_lux = (uint16_t)(2000 - season * 8);
+
+        for (uint32_t minute = 0; minute < 1440; minute++) {
+            bench_minute_t *m = &_year[day * 1440 + minute];
+            uint8_t hour = minute / 60;
+            bool awake = hour >= 7 && hour < 23;
+            bool daylight = hour >= 7 && hour < 19;
+
+            m->activity = awake ? (uint16_t)(_rng() % 1001) : (uint16_t)(_rng() % 40);
+            m->variance = awake ? (uint16_t)(_rng() % 1200) : (uint16_t)(_rng() % 50);
+            m->temp_c10 = (int16_t)(base_temp + (int16_t)(_rng() % 41) - 20);
+            m->lux = daylight ? (uint16_t)(base_lux + _rng() % 500) : (uint16_t)(_rng() % 15);
+        }
+
+        // mostly still, with a few restless and wake bouts.
+        for (uint32_t epoch = 0; epoch < BENCH_EPOCHS_PER_NIGHT; epoch++) {
+            uint32_t r = _rng() % 100;
+            _epochs[day][epoch] = r < 70 ? (uint8_t)(r % 2) : r < 90 ? (uint8_t)(2 + r % 4) : r < 97 ? (uint8_t)(6 + r % 10) : (uint8_t)(16 + r % 20);
+        }
+    }
+}
+
+static uint64_t _now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static double _bench_phase_compute(void) {
+    phase_state_t state;
+    uint32_t acc = 0;
+
+    phase_engine_init(&state);
+    uint64_t start = _now_ns();
+    for (uint32_t i = 0; i < BENCH_MINUTES; i++) {
+        const bench_minute_t *m = &_year[i];
+        acc += phase_compute(&state, (i / 60) % 24, i % 60, (uint16_t)(i / 1440 + 1), m->activity, m->temp_c10, m->lux);
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / BENCH_MINUTES;
+}
+
+// The expected-activity lookup on its own: a quarter-hour table interpolated to the minute,
+// which phase_compute() does once a call.
+static double _bench_phase_circadian_curve(void) {
+    uint32_t acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t i = 0; i < BENCH_MINUTES; i++) {
+        acc += (uint16_t)phase_circadian_curve((uint16_t)(i % 1440));
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / BENCH_MINUTES;
+}
+
+static double _bench_metrics_update(void) {
+    metrics_engine_t engine;
+    struct sensor_state_t sensors;
+    circadian_data_t sleep;
+    metrics_snapshot_t snapshot;
+    calendar_context_t cal = {0};
+    uint32_t acc = 0;
+
+    host_fake_reset();
+    sensors_init(&sensors, true, true);
+    memset(&sleep, 0, sizeof(sleep));
+    metrics_init(&engine);
+    metrics_set_wake_onset(&engine, 7, 0);
+
+    uint64_t start = _now_ns();
+    for (uint32_t i = 0; i < BENCH_MINUTES; i++) {
+        const bench_minute_t *m = &_year[i];
+        // 2026, minute by minute; the calendar is rebuilt every minute, as Movement does.
+        watch_date_time_t local = watch_utility_date_time_from_unix_time(1767225600 + i * 60, 0);
+        calendar_context_update(&cal, local, 0, 0, 0, true, 28, 92);
+
+        // what the sensor scheduler would have left behind this minute.
+        sensors.temperature_c10 = m->temp_c10;
+        sensors.lux_avg = m->lux;
+        sensors.motion_stats.variance[SENSOR_MOTION_SHORT] = (uint32_t)m->variance << 4;
+        sensors.motion_stats.variance[SENSOR_MOTION_LONG] = (uint32_t)m->variance << 4;
+        sensors.motion_intensity = m->activity;
+
+        metrics_update(&engine, &sensors, &cal, 60, m->activity, &sleep, true);
+        metrics_get(&engine, &snapshot);
+        acc += snapshot.energy;
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / BENCH_MINUTES;
+}
+
+static double _bench_circadian_score(void) {
+    circadian_data_t data;
+    uint32_t acc = 0;
+    uint64_t elapsed = 0;
+
+    memset(&data, 0, sizeof(data));
+    data.active_hours_start_min = 7 * 60;
+    data.active_hours_end_min = 23 * 60;
+
+    for (uint32_t day = 0; day < BENCH_DAYS; day++) {
+        // roll last night into the window the way circadian_data_add_night does, minus the flash write.
+        circadian_sleep_night_t *night = &data.nights[data.write_index];
+        uint16_t onset = (uint16_t)((1380 + _epochs[day][0] * 7 + _epochs[day][1] * 5) % 1440);
+        uint16_t duration = (uint16_t)(360 + _epochs[day][2] * 10 + _epochs[day][3] * 6);
+        night->onset_timestamp = 1767225600UL + day * 86400UL + onset * 60UL;
+        night->offset_timestamp = night->onset_timestamp + duration * 60UL;
+        night->duration_min = duration;
+        night->efficiency = (uint8_t)(75 + _epochs[day][4]);
+        night->light_quality = (uint8_t)(60 + _epochs[day][5]);
+        night->valid = true;
+        data.write_index = (data.write_index + 1) % 7;
+
+        uint64_t start = _now_ns();
+        for (uint32_t r = 0; r < BENCH_SCORE_REPEATS; r++) acc += circadian_score_calculate(&data);
+        elapsed += _now_ns() - start;
+    }
+
+    _sink = acc;
+    return (double)elapsed / (BENCH_DAYS * BENCH_SCORE_REPEATS);
+}
+
+static double _bench_sleep_record_epoch(void) {
+    sleep_telemetry_state_t state;
+    uint32_t acc = 0;
+    uint64_t elapsed = 0;
+
+    for (uint32_t day = 0; day < BENCH_DAYS; day++) {
+        sleep_data_init(&state);
+
+        uint64_t start = _now_ns();
+        for (uint32_t epoch = 0; epoch < BENCH_EPOCHS_PER_NIGHT; epoch++) {
+            sleep_data_record_epoch(&state, _epochs[day][epoch]);
+        }
+        elapsed += _now_ns() - start;
+
+        acc += state.sleep_states.state_buffer[day % 240];
+    }
+
+    _sink = acc;
+    return (double)elapsed / (BENCH_DAYS * BENCH_EPOCHS_PER_NIGHT);
+}
+
+// One motion sample a minute for the year, magnitudes around 1 g swinging with activity.
+static double _bench_motion_stats_add(void) {
+    sensor_motion_stats_t stats = {0};
+    uint32_t acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t i = 0; i < BENCH_MINUTES; i++) {
+        sensors_motion_stats_add(&stats, (uint16_t)(16384 + _year[i].activity * 4), 1);
+        acc += stats.variance[SENSOR_MOTION_SHORT];
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / BENCH_MINUTES;
+}
+
+// Sunrise and sunset for every day of the year at a spread of latitudes, fixed-point against
+// lib/sunriset. The host has an FPU, so this understates the gap on the watch, where every
+// double operation in sunriset is a soft-float library call.
+static const int16_t _solar_locations[BENCH_SOLAR_LOCATIONS][2] = {
+    { 6122, -14990 }, { 4552, -12268 }, { 3278, -9680 }, { 4071, -7401 },
+    { 5151, -13 }, { 3568, 13969 }, { -3387, 15121 }, { 0, 3682 },
+};
+
+static double _bench_solar_compute(void) {
+    solar_times_t times;
+    uint32_t acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t day = 0; day < BENCH_DAYS; day++) {
+        for (uint8_t i = 0; i < BENCH_SOLAR_LOCATIONS; i++) {
+            solar_compute(2026, day / 31 + 1, day % 28 + 1, _solar_locations[i][0], _solar_locations[i][1], 0, &times);
+            acc += times.sunrise_min + times.sunset_min;
+        }
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / (BENCH_DAYS * BENCH_SOLAR_LOCATIONS);
+}
+
+static double _bench_sun_rise_set(void) {
+    double rise, set;
+    double acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t day = 0; day < BENCH_DAYS; day++) {
+        for (uint8_t i = 0; i < BENCH_SOLAR_LOCATIONS; i++) {
+            sun_rise_set(2026, day / 31 + 1, day % 28 + 1, _solar_locations[i][1] / 100.0, _solar_locations[i][0] / 100.0, &rise, &set);
+            acc += rise + set;
+        }
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = (uint32_t)acc;
+    return (double)elapsed / (BENCH_DAYS * BENCH_SOLAR_LOCATIONS);
+}
+
+// Every ADC code the thermistor can produce, table lookup against the B-equation with log().
+// As with sunriset, the host FPU flatters the float version.
+static double _bench_thermistor_c100(void) {
+    uint32_t acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t value = 0; value < 65536; value++) {
+        acc += watch_utility_thermistor_temperature_c100((uint16_t)value);
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = acc;
+    return (double)elapsed / 65536;
+}
+
+static double _bench_thermistor_float(void) {
+    float acc = 0;
+
+    uint64_t start = _now_ns();
+    for (uint32_t value = 1; value < 65536; value++) {
+        acc += watch_utility_thermistor_temperature((uint16_t)value, true, 3380.0, 25.0, 10000.0, 10000.0);
+    }
+    uint64_t elapsed = _now_ns() - start;
+
+    _sink = (uint32_t)acc;
+    return (double)elapsed / 65535;
+}
+
+static bench_t _benches[] = {
+    { "phase_compute", _bench_phase_compute, 0 },
+    { "phase_circadian_curve", _bench_phase_circadian_curve, 0 },
+    { "metrics_update", _bench_metrics_update, 0 },
+    { "circadian_score_calculate", _bench_circadian_score, 0 },
+    { "sleep_data_record_epoch", _bench_sleep_record_epoch, 0 },
+    { "motion_stats_add", _bench_motion_stats_add, 0 },
+    { "solar_compute", _bench_solar_compute, 0 },
+    { "sun_rise_set", _bench_sun_rise_set, 0 },
+    { "thermistor_c100", _bench_thermistor_c100, 0 },
+    { "thermistor_float", _bench_thermistor_float, 0 },
+};
+
+#define BENCH_COUNT (sizeof(_benches) / sizeof(_benches[0]))
+
+// ============================================================================
+// Baseline file: one "name ns_per_call" line per benchmark
+// ============================================================================
+
+static bool _baseline_lookup(const char *path, const char *name, double *out) {
+    FILE *f = fopen(path, "r");
+    char line_name[64];
+    double value;
+    bool found = false;
+
+    if (f == NULL) return false;
+    while (fscanf(f, "%63s %lf", line_name, &value) == 2) {
+        if (strcmp(line_name, name) == 0) {
+            *out = value;
+            found = true;
+            break;
+        }
+    }
+    fclose(f);
+
+    return found;
+}
+
+static bool _baseline_write(const char *path) {
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) return false;
+    for (size_t i = 0; i < BENCH_COUNT; i++) fprintf(f, "%s %.3f\n", _benches[i].name, _benches[i].ns_per_call);
+    fclose(f);
+
+    return true;
+}
+
+static void _usage(void) {
+    fprintf(stderr, "usage: bench_host [--record FILE | --compare FILE] [--threshold PCT]\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *record_path = NULL;
+    const char *compare_path = NULL;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    unsigned regressions = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            compare_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            _usage();
+            return 2;
+        }
+    }
+
+    host_fake_reset();
+    _build_year();
+
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        double best = 0;
+        for (int pass = 0; pass < BENCH_PASSES; pass++) {
+            double ns = _benches[i].run();
+            if (pass == 0 || ns < best) best = ns;
+        }
+        _benches[i].ns_per_call = best;
+    }
+
+    printf("%-28s %10s %10s %8s\n", "benchmark", "ns/call", "baseline", "change");
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        const bench_t *b = &_benches[i];
+        double baseline;
+
+        if (compare_path == NULL || !_baseline_lookup(compare_path, b->name, &baseline) || baseline <= 0) {
+            printf("%-28s %10.2f %10s %8s\n", b->name, b->ns_per_call, "-", "-");
+            continue;
+        }
+
+        double change = (b->ns_per_call - baseline) * 100.0 / baseline;
+        bool regressed = change > threshold;
+        if (regressed) regressions++;
+        printf("%-28s %10.2f %10.2f %+7.1f%%%s\n", b->name, b->ns_per_call, baseline, change,
+               regressed ? "  REGRESSION" : "");
+    }
+
+    if (record_path != NULL) {
+        if (!_baseline_write(record_path)) {
+            fprintf(stderr, "bench: can't write %s\n", record_path);
+            return 2;
+        }
+        printf("\nbaseline saved to %s\n", record_path);
+    }
+
+    if (compare_path != NULL) {
+        FILE *f = fopen(compare_path, "r");
+        if (f == NULL) {
+            printf("\nno baseline at %s; record one with `make bench-baseline`\n", compare_path);
+        } else {
+            fclose(f);
+            printf("\n%u regression(s) over %.0f%%\n", regressions, threshold);
+        }
+    }
+
+    free(_year);
+    return regressions ? 1 : 0;
+}
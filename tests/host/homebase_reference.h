@@ -0,0 +1,109 @@
+/*
+ * The uncompressed Anchorage homebase table as generated before the compact
+ * encoding (utils/generate_homebase.py --city anchorage --skip-api --year 2026).
+ * test_main.c checks that homebase_get_entry() decodes every day back exactly.
+ */
+
+#ifndef HOMEBASE_REFERENCE_H_
+#define HOMEBASE_REFERENCE_H_
+
+#include "phase_engine.h"
+
+// Homebase table (365 entries, one per day of year)
+// Entry format: {daylight_minutes, temp_c10, seasonal_baseline}
+static const homebase_entry_t homebase_reference_table[365] = {
+    {314, -290, 58}, {316, -291, 57}, {319, -292, 56}, {321, -293, 56},  // Days 1-4
+    {324, -294, 55}, {327, -295, 55}, {329, -296, 54}, {333, -296, 54},  // Days 5-8
+    {336, -297, 53}, {339, -297, 52}, {343, -298, 52}, {346, -298, 51},  // Days 9-12
+    {350, -298, 51}, {354, -298, 50}, {358, -298, 50}, {362, -298, 49},  // Days 13-16
+    {366, -298, 49}, {370, -298, 48}, {375, -298, 47}, {379, -297, 47},  // Days 17-20
+    {384, -297, 46}, {388, -296, 46}, {393, -295, 45}, {398, -295, 45},  // Days 21-24
+    {402, -294, 44}, {407, -293, 44}, {412, -292, 43}, {417, -291, 43},  // Days 25-28
+    {422, -289, 42}, {427, -288, 42}, {433, -287, 42}, {438, -285, 41},  // Days 29-32
+    {443, -284, 41}, {448, -282, 40}, {454, -280, 40}, {459, -278, 39},  // Days 33-36
+    {464, -276, 39}, {470, -274, 39}, {475, -272, 38}, {481, -270, 38},  // Days 37-40
+    {486, -268, 37}, {492, -266, 37}, {498, -263, 37}, {503, -261, 36},  // Days 41-44
+    {509, -258, 36}, {514, -255, 36}, {520, -253, 35}, {526, -250, 35},  // Days 45-48
+    {532, -247, 35}, {537, -244, 34}, {543, -241, 34}, {549, -238, 34},  // Days 49-52
+    {554, -235, 33}, {560, -232, 33}, {566, -228, 33}, {572, -225, 33},  // Days 53-56
+    {578, -221, 32}, {583, -218, 32}, {589, -214, 32}, {595, -211, 32},  // Days 57-60
+    {601, -207, 32}, {607, -203, 31}, {612, -199, 31}, {618, -196, 31},  // Days 61-64
+    {624, -192, 31}, {630, -188, 31}, {636, -184, 30}, {642, -179, 30},  // Days 65-68
+    {648, -175, 30}, {653, -171, 30}, {659, -167, 30}, {665, -162, 30},  // Days 69-72
+    {671, -158, 30}, {677, -154, 30}, {683, -149, 30}, {689, -145, 30},  // Days 73-76
+    {695, -140, 30}, {700, -135, 30}, {706, -131, 30}, {712, -126, 30},  // Days 77-80
+    {718, -121, 30}, {724, -116, 30}, {730, -112, 30}, {736, -107, 30},  // Days 81-84
+    {742, -102, 30}, {747, -97, 30}, {753, -92, 30}, {759, -87, 30},  // Days 85-88
+    {765, -82, 30}, {771, -77, 30}, {777, -72, 30}, {783, -67, 30},  // Days 89-92
+    {788, -62, 30}, {794, -57, 30}, {800, -52, 31}, {806, -46, 31},  // Days 93-96
+    {812, -41, 31}, {818, -36, 31}, {824, -31, 31}, {829, -26, 31},  // Days 97-100
+    {835, -21, 32}, {841, -15, 32}, {847, -10, 32}, {853, -5, 32},  // Days 101-104
+    {859, 0, 33}, {864, 5, 33}, {870, 10, 33}, {876, 15, 33},  // Days 105-108
+    {882, 20, 34}, {887, 26, 34}, {893, 31, 34}, {899, 36, 34},  // Days 109-112
+    {905, 41, 35}, {910, 46, 35}, {916, 52, 35}, {922, 57, 36},  // Days 113-116
+    {927, 62, 36}, {933, 67, 36}, {939, 72, 37}, {944, 77, 37},  // Days 117-120
+    {950, 82, 38}, {955, 87, 38}, {961, 92, 38}, {966, 97, 39},  // Days 121-124
+    {972, 102, 39}, {977, 107, 40}, {983, 112, 40}, {988, 117, 40},  // Days 125-128
+    {993, 122, 41}, {999, 127, 41}, {1004, 131, 42}, {1009, 136, 42},  // Days 129-132
+    {1014, 141, 43}, {1019, 146, 43}, {1024, 150, 44}, {1029, 155, 44},  // Days 133-136
+    {1034, 159, 45}, {1039, 164, 45}, {1044, 168, 46}, {1049, 173, 46},  // Days 137-140
+    {1053, 177, 47}, {1058, 181, 47}, {1062, 185, 48}, {1067, 190, 48},  // Days 141-144
+    {1071, 194, 49}, {1075, 198, 49}, {1079, 202, 50}, {1083, 206, 50},  // Days 145-148
+    {1087, 210, 51}, {1091, 214, 52}, {1095, 217, 52}, {1098, 221, 53},  // Days 149-152
+    {1102, 225, 53}, {1105, 228, 54}, {1108, 232, 54}, {1111, 235, 55},  // Days 153-156
+    {1114, 239, 56}, {1117, 242, 56}, {1119, 245, 57}, {1122, 248, 57},  // Days 157-160
+    {1124, 251, 58}, {1126, 254, 59}, {1128, 257, 59}, {1129, 260, 60},  // Days 161-164
+    {1131, 263, 60}, {1132, 266, 61}, {1133, 268, 61}, {1134, 271, 62},  // Days 165-168
+    {1135, 273, 63}, {1136, 276, 63}, {1136, 278, 64}, {1136, 280, 65},  // Days 169-172
+    {1136, 283, 65}, {1136, 285, 66}, {1136, 287, 66}, {1135, 289, 67},  // Days 173-176
+    {1134, 290, 68}, {1133, 292, 68}, {1132, 294, 69}, {1131, 295, 69},  // Days 177-180
+    {1129, 297, 70}, {1128, 298, 70}, {1126, 300, 71}, {1124, 301, 72},  // Days 181-184
+    {1122, 302, 72}, {1119, 303, 73}, {1117, 304, 73}, {1114, 305, 74},  // Days 185-188
+    {1111, 306, 75}, {1108, 306, 75}, {1105, 307, 76}, {1102, 307, 76},  // Days 189-192
+    {1098, 308, 77}, {1095, 308, 77}, {1091, 308, 78}, {1087, 309, 79},  // Days 193-196
+    {1083, 309, 79}, {1079, 309, 80}, {1075, 309, 80}, {1071, 308, 81},  // Days 197-200
+    {1067, 308, 81}, {1062, 308, 82}, {1058, 307, 82}, {1053, 307, 83},  // Days 201-204
+    {1049, 306, 83}, {1044, 305, 84}, {1039, 304, 84}, {1034, 303, 85},  // Days 205-208
+    {1029, 302, 85}, {1024, 301, 86}, {1019, 300, 86}, {1014, 299, 87},  // Days 209-212
+    {1009, 298, 87}, {1004, 296, 88}, {999, 295, 88}, {993, 293, 89},  // Days 213-216
+    {988, 291, 89}, {983, 289, 89}, {977, 288, 90}, {972, 286, 90},  // Days 217-220
+    {966, 284, 91}, {961, 282, 91}, {955, 279, 91}, {950, 277, 92},  // Days 221-224
+    {944, 275, 92}, {939, 272, 93}, {933, 270, 93}, {927, 267, 93},  // Days 225-228
+    {922, 264, 94}, {916, 262, 94}, {910, 259, 94}, {905, 256, 95},  // Days 229-232
+    {899, 253, 95}, {893, 250, 95}, {887, 247, 95}, {882, 244, 96},  // Days 233-236
+    {876, 240, 96}, {870, 237, 96}, {864, 233, 96}, {859, 230, 97},  // Days 237-240
+    {853, 226, 97}, {847, 223, 97}, {841, 219, 97}, {835, 215, 98},  // Days 241-244
+    {829, 212, 98}, {824, 208, 98}, {818, 204, 98}, {812, 200, 98},  // Days 245-248
+    {806, 196, 98}, {800, 192, 99}, {794, 188, 99}, {788, 183, 99},  // Days 249-252
+    {783, 179, 99}, {777, 175, 99}, {771, 170, 99}, {765, 166, 99},  // Days 253-256
+    {759, 162, 99}, {753, 157, 99}, {747, 152, 99}, {742, 148, 99},  // Days 257-260
+    {736, 143, 99}, {730, 139, 99}, {724, 134, 99}, {718, 129, 99},  // Days 261-264
+    {712, 124, 99}, {706, 119, 99}, {700, 115, 99}, {695, 110, 99},  // Days 265-268
+    {689, 105, 99}, {683, 100, 99}, {677, 95, 99}, {671, 90, 99},  // Days 269-272
+    {665, 85, 99}, {659, 80, 99}, {653, 75, 99}, {648, 70, 99},  // Days 273-276
+    {642, 64, 99}, {636, 59, 98}, {630, 54, 98}, {624, 49, 98},  // Days 277-280
+    {618, 44, 98}, {612, 39, 98}, {607, 33, 97}, {601, 28, 97},  // Days 281-284
+    {595, 23, 97}, {589, 18, 97}, {583, 12, 97}, {578, 7, 96},  // Days 285-288
+    {572, 2, 96}, {566, -2, 96}, {560, -7, 96}, {554, -13, 95},  // Days 289-292
+    {549, -18, 95}, {543, -23, 95}, {537, -28, 94}, {532, -34, 94},  // Days 293-296
+    {526, -39, 94}, {520, -44, 93}, {514, -49, 93}, {509, -54, 93},  // Days 297-300
+    {503, -59, 92}, {498, -64, 92}, {492, -69, 92}, {486, -75, 91},  // Days 301-304
+    {481, -80, 91}, {475, -85, 90}, {470, -90, 90}, {464, -95, 90},  // Days 305-308
+    {459, -99, 89}, {454, -104, 89}, {448, -109, 88}, {443, -114, 88},  // Days 309-312
+    {438, -119, 87}, {433, -124, 87}, {427, -128, 87}, {422, -133, 86},  // Days 313-316
+    {417, -138, 86}, {412, -142, 85}, {407, -147, 85}, {402, -151, 84},  // Days 317-320
+    {398, -156, 84}, {393, -160, 83}, {388, -165, 83}, {384, -169, 82},  // Days 321-324
+    {379, -173, 82}, {375, -177, 81}, {370, -181, 80}, {366, -186, 80},  // Days 325-328
+    {362, -190, 79}, {358, -194, 79}, {354, -198, 78}, {350, -201, 78},  // Days 329-332
+    {346, -205, 77}, {343, -209, 77}, {339, -213, 76}, {336, -216, 75},  // Days 333-336
+    {333, -220, 75}, {329, -223, 74}, {327, -227, 74}, {324, -230, 73},  // Days 337-340
+    {321, -233, 73}, {319, -236, 72}, {316, -240, 71}, {314, -243, 71},  // Days 341-344
+    {312, -246, 70}, {310, -249, 70}, {309, -251, 69}, {307, -254, 68},  // Days 345-348
+    {306, -257, 68}, {305, -259, 67}, {304, -262, 67}, {303, -264, 66},  // Days 349-352
+    {303, -267, 65}, {303, -269, 65}, {303, -271, 64}, {303, -273, 64},  // Days 353-356
+    {303, -275, 63}, {303, -277, 62}, {304, -279, 62}, {305, -281, 61},  // Days 357-360
+    {306, -283, 61}, {307, -284, 60}, {309, -286, 59}, {310, -287, 59},  // Days 361-364
+    {312, -289, 58}  // Day 365
+};
+
+#endif // HOMEBASE_REFERENCE_H_
@@ -0,0 +1,248 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: fake hardware
+ * Implementation
+ */
+
+#include <string.h>
+
+#include "host_stubs.h"
+#include "watch_private.h"
+#include "movement.h"
+#include "thermistor_driver.h"
+#include "zones.h"
+
+host_fake_t host_fake;
+
+// watch_utility.c indexes this for zone abbreviations; nothing under test shows them.
+const char zone_names[8] = "UTC";
+
+void host_fake_reset(void) {
+    memset(&host_fake, 0, sizeof(host_fake));
+    memset(host_fake.storage, 0xff, sizeof(host_fake.storage));
+    watch_storage_region_init();            // same as movement: claims start over at boot
+    host_fake.next_backup_register = 4;     // same as movement: 0-3 are spoken for
+    host_fake.temperature_c100 = 2000;
+    host_fake.vcc_mv = 3000;
+    host_fake_set_time(2026, 1, 1, 0, 0);
+}
+
+void host_fake_set_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
+    host_fake.date_time.unit.year = year - WATCH_RTC_REFERENCE_YEAR;
+    host_fake.date_time.unit.month = month;
+    host_fake.date_time.unit.day = day;
+    host_fake.date_time.unit.hour = hour;
+    host_fake.date_time.unit.minute = minute;
+    host_fake.date_time.unit.second = 0;
+}
+
+// ============================================================================
+// Watch library
+// ============================================================================
+
+rtc_date_time_t watch_rtc_get_date_time(void) {
+    return host_fake.date_time;
+}
+
+rtc_counter_t watch_rtc_get_counter(void) {
+    return host_fake.counter;
+}
+
+// The backends program the compare interrupt here; the tests call _watch_rtc_comp_next_counter() themselves.
+void watch_rtc_schedule_next_comp(void) {
+    host_fake.comp_schedules++;
+}
+
+void watch_store_backup_data(uint32_t data, uint8_t reg) {
+    host_fake.backup_writes++;
+    if (reg < 8) host_fake.backup[reg] = data;
+}
+
+uint32_t watch_get_backup_data(uint8_t reg) {
+    return reg < 8 ? host_fake.backup[reg] : 0;
+}
+
+bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    if (row >= HOST_STORAGE_ROWS || offset + size > NVMCTRL_ROW_SIZE) return false;
+    memcpy(buffer, &host_fake.storage[row][offset], size);
+    return true;
+}
+
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    if (row >= HOST_STORAGE_ROWS || offset + size > NVMCTRL_ROW_SIZE) return false;
+    // like real flash, a write can only clear bits; setting them again takes an erase.
+    for (uint32_t i = 0; i < size; i++) host_fake.storage[row][offset + i] &= buffer[i];
+    host_fake.storage_writes++;
+    return true;
+}
+
+bool watch_storage_erase(uint32_t row) {
+    if (row >= HOST_STORAGE_ROWS) return false;
+    memset(host_fake.storage[row], 0xff, NVMCTRL_ROW_SIZE);
+    host_fake.storage_erases++;
+    return true;
+}
+
+bool watch_storage_sync(void) {
+    // queued commands finish instantly here; just deliver their interrupts.
+    while (host_fake_storage_interrupt()) { }
+    return true;
+}
+
+// The flash controller, for the write queue in watch_common_storage.c. Commands complete
+// straight away, but nothing moves on until a test delivers the ready interrupt.
+
+void _watch_storage_start_erase(uint32_t row) {
+    watch_storage_erase(row);
+}
+
+void _watch_storage_start_page_buffer_clear(void) {
+    memset(host_fake.page_buffer, 0xff, NVMCTRL_PAGE_SIZE);
+}
+
+void _watch_storage_fill_page_buffer(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    (void) row;
+    memcpy(&host_fake.page_buffer[offset % NVMCTRL_PAGE_SIZE], buffer, size);
+}
+
+void _watch_storage_start_page_write(uint32_t row, uint32_t offset) {
+    watch_storage_write(row, offset - offset % NVMCTRL_PAGE_SIZE, host_fake.page_buffer, NVMCTRL_PAGE_SIZE);
+}
+
+bool _watch_storage_take_error(void) {
+    bool failed = host_fake.storage_fail_next;
+    host_fake.storage_fail_next = false;
+    return failed;
+}
+
+void _watch_storage_enable_ready_interrupt(bool enable) {
+    host_fake.storage_ready_interrupt = enable;
+}
+
+bool host_fake_storage_interrupt(void) {
+    if (!host_fake.storage_ready_interrupt) return false;
+    _watch_storage_ready_handler();
+    return true;
+}
+
+void watch_buzzer_play_note(watch_buzzer_note_t note, uint16_t duration_ms) {
+    (void) note;
+    (void) duration_ms;
+}
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return WATCH_LCD_TYPE_CLASSIC;
+}
+
+void watch_display_text(watch_position_t location, const char *string) {
+    (void) location;
+    (void) string;
+}
+
+void watch_display_text_with_fallback(watch_position_t location, const char *string, const char *fallback) {
+    (void) location;
+    (void) string;
+    (void) fallback;
+}
+
+void watch_enable_adc(void) {
+    host_fake.adc_power_ups++;
+}
+
+void watch_disable_adc(void) {
+}
+
+uint16_t watch_get_analog_pin_level(const uint16_t pin) {
+    (void) pin;
+    return host_fake.light_adc;
+}
+
+uint16_t watch_get_vcc_voltage(void) {
+    return host_fake.vcc_mv;
+}
+
+// ============================================================================
+// LIS2DW
+// ============================================================================
+
+lis2dw_wakeup_source_t lis2dw_get_wakeup_source(void) {
+    return (lis2dw_wakeup_source_t)host_fake.wakeup_source;
+}
+
+lis2dw_reading_t lis2dw_get_raw_reading(void) {
+    return host_fake.accel;
+}
+
+uint16_t lis2dw_get_temperature(void) {
+    return (uint16_t)host_fake.accel_temperature;
+}
+
+bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout) {
+    (void) timeout;
+    *fifo_data = host_fake.fifo;
+    host_fake.fifo.count = 0;
+    return false;
+}
+
+// The FIFO and interrupt routing are recorded for tests; other configuration
+// writes have nothing to configure here.
+void lis2dw_configure_fifo(lis2dw_fifo_mode_t mode, uint8_t threshold) {
+    host_fake.fifo_ctrl = (mode << 5) | (threshold & LIS2DW_FIFO_CTRL_FTH);
+}
+uint8_t lis2dw_get_fifo_configuration(void) { return host_fake.fifo_ctrl; }
+void lis2dw_disable_fifo(void) { host_fake.fifo_ctrl = LIS2DW_FIFO_CTRL_MODE_OFF; }
+void lis2dw_configure_int1(uint8_t sources) { host_fake.int1_sources = sources; }
+void lis2dw_set_data_rate(lis2dw_data_rate_t data_rate) { host_fake.data_rate = data_rate; }
+void lis2dw_set_mode(lis2dw_mode_t mode) { (void) mode; }
+void lis2dw_set_low_power_mode(lis2dw_low_power_mode_t mode) { (void) mode; }
+void lis2dw_set_low_noise_mode(bool on) { (void) on; }
+void lis2dw_set_range(lis2dw_range_t range) { (void) range; }
+void lis2dw_configure_wakeup_threshold(uint8_t threshold) { (void) threshold; }
+void lis2dw_enable_sleep(void) { }
+void lis2dw_enable_stationary_motion_detection(void) { }
+
+// ============================================================================
+// Thermistor
+// ============================================================================
+
+// Powering the divider starts the ADC too, as on hardware.
+void thermistor_driver_enable(void) {
+    watch_enable_adc();
+}
+
+void thermistor_driver_disable(void) {
+    watch_disable_adc();
+}
+
+int16_t thermistor_driver_get_temperature_c100(void) {
+    return host_fake.temperature_c100;
+}
+
+// ============================================================================
+// Movement
+// ============================================================================
+
+uint8_t movement_claim_backup_register(void) {
+    if (host_fake.next_backup_register >= 7) return 0;
+    return host_fake.next_backup_register++;
+}
+
+lis2dw_data_rate_t movement_get_accelerometer_background_rate(void) {
+    return host_fake.background_rate;
+}
+
+// what a watch face can ask of Movement; there's no UI on the host to act on it.
+void movement_move_to_face(uint8_t watch_face_index) {
+    (void) watch_face_index;
+}
+
+bool movement_default_loop_handler(movement_event_t event) {
+    (void) event;
+    return true;
+}
+
+void movement_illuminate_led(void) {
+}
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: fake hardware
+ *
+ * The libraries under test reach into the watch library and Movement for the
+ * RTC, BKUP registers, flash rows, the ADC and the accelerometer. On the host
+ * those calls land in host_stubs.c, which serves them from `host_fake`, so a
+ * test or benchmark sets the inputs there before calling into a library.
+ */
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "watch.h"
+#include "lis2dw.h"
+
+#define HOST_STORAGE_ROWS 32    // the whole 8 KB RWWEE area
+
+typedef struct {
+    watch_date_time_t date_time;            // what watch_rtc_get_date_time() returns
+    rtc_counter_t counter;                  // what watch_rtc_get_counter() returns
+    uint32_t comp_schedules;                // calls to watch_rtc_schedule_next_comp()
+    lis2dw_reading_t accel;                 // what lis2dw_get_raw_reading() returns
+    uint8_t wakeup_source;                  // what lis2dw_get_wakeup_source() returns
+    lis2dw_fifo_t fifo;                     // what the next lis2dw_read_fifo() drains
+    uint8_t fifo_ctrl;                      // FIFO_CTRL as last configured (mode << 5 | watermark)
+    uint8_t int1_sources;                   // CTRL4_INT1 as last configured
+    lis2dw_data_rate_t data_rate;           // as last set
+    lis2dw_data_rate_t background_rate;     // what movement_get_accelerometer_background_rate() returns
+    int16_t accel_temperature;              // what lis2dw_get_temperature() returns
+    uint16_t light_adc;                     // what the A2 light sensor reads
+    int16_t temperature_c100;               // what thermistor_driver_get_temperature_c100() returns
+    uint16_t vcc_mv;                        // what watch_get_vcc_voltage() returns
+    uint32_t adc_power_ups;                 // watch_enable_adc calls, including the thermistor's
+    uint32_t backup[8];                     // BKUP registers
+    uint32_t backup_writes;                 // calls to watch_store_backup_data()
+    uint8_t next_backup_register;           // next one movement_claim_backup_register() hands out
+    uint8_t storage[HOST_STORAGE_ROWS][NVMCTRL_ROW_SIZE];
+    uint32_t storage_writes;                // watch_storage_write calls, for tests that care
+    uint32_t storage_erases;                // watch_storage_erase calls, and erases from the write queue
+    uint8_t page_buffer[NVMCTRL_PAGE_SIZE]; // the flash controller's, for queued writes
+    bool storage_ready_interrupt;           // enabled by the write queue
+    bool storage_fail_next;                 // make the next queued flash command report an error
+} host_fake_t;
+
+extern host_fake_t host_fake;
+
+/**
+ * Put the fake hardware back to power-on state: BKUP cleared, flash erased,
+ * 2026-01-01 00:00, 20 °C, 3 V, dark, accelerometer still.
+ */
+void host_fake_reset(void);
+
+/**
+ * Set the fake RTC. `year` is the full year (2026, not 6).
+ */
+void host_fake_set_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute);
+
+/**
+ * Deliver one flash ready interrupt, as if the last queued command finished.
+ * Returns false, doing nothing, if the interrupt isn't enabled.
+ */
+bool host_fake_storage_interrupt(void);
+
+#endif // HOST_STUBS_H_
@@ -0,0 +1,436 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: trace replay driver
+ *
+ * Pushes a recorded (or synthesized) sensor trace through the same Phase
+ * Engine pipeline Movement runs on the watch, as fast as the host allows,
+ * and writes one CSV row per simulated hour. A week of wear replays in well
+ * under a second, which is what makes sweeping a threshold practical.
+ *
+ * The per-second and per-minute steps below mirror, in order, what
+ * movement.c does in app_loop's tick handling and in
+ * _movement_handle_top_of_minute (sensors, phase_compute, metrics_update,
+ * playlist_update, anomaly detection, hourly telemetry, 30 s sleep epochs).
+ * Keep them in step when that code changes. On top of that, the driver runs
+ * the sleep tracker's Cole-Kripke classifier once a minute through the sleep
+ * window, and closes each night into the circadian data the way Movement does.
+ *
+ * Assumes a 1 Hz tick throughout, i.e. the watch never dropped to low energy
+ * mode during the trace.
+ *
+ *   replay_host [options] TRACE          replay TRACE ("-" for stdin)
+ *   replay_host --synthesize DAYS        write a synthetic trace instead
+ *
+ * Options:
+ *   -o FILE                              CSV (or synthesized trace) to FILE instead of stdout
+ *   --seed N                             seed for --synthesize
+ *   --sleep-thresholds L,R,W             sleep_state_thresholds_t (light, restless, wake)
+ *   --light-modifiers D,M,O,B            Cole-Kripke threshold offsets per light class
+ *   --zone-weight ZONE,METRIC,WEIGHT     override one playlist zone weight (repeatable)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_stubs.h"
+#include "replay_trace.h"
+#include "phase_engine.h"
+#include "metrics.h"
+#include "calendar_context.h"
+#include "playlist.h"
+#include "sensors.h"
+#include "sleep_data.h"
+#include "circadian_score.h"
+#include "metric_cadence.h"
+#include "sleep_tracker_face.h"
+#include "watch_utility.h"
+
+// Same light modifiers sleep_tracker_face_setup installs.
+static const int16_t _default_light_modifiers[4] = { -200, -50, 100, 400 };
+
+typedef struct {
+    // the parts of movement_state the pipeline touches
+    struct sensor_state_t sensors;
+    phase_state_t phase;
+    metrics_engine_t metrics;
+    playlist_state_t playlist;
+    sleep_telemetry_state_t sleep_telemetry;
+    calendar_context_t calendar;
+    sleep_tracker_state_t sleep_tracker;
+    circadian_data_t circadian;
+    uint16_t cumulative_activity;           // movement.c zeroes this at boot and never advances it
+    uint8_t metric_tick_count;
+    // statics from _movement_handle_top_of_minute
+    uint8_t last_telemetry_hour;
+    metrics_snapshot_t prev_snapshot;
+    bool prev_snapshot_valid;
+    phase_zone_t prev_zone_hourly;
+    bool was_in_sleep_window;
+    // active hours, as BKUP[2] would hold them
+    uint8_t active_start_qh;
+    uint8_t active_end_qh;
+    // what the driver itself observes for the CSV
+    uint32_t last_motion_t;
+    bool any_motion;
+    uint16_t minute_motion;
+    uint32_t hour_motion;
+    uint16_t hour_buttons;
+    uint16_t lux;
+    uint16_t nights_closed;
+} replay_t;
+
+static replay_t _replay;
+
+// ============================================================================
+// Movement's pipeline, minus the display
+// ============================================================================
+
+static bool _is_sleep_window(const replay_t *r, watch_date_time_t now) {
+    uint8_t current_qh = (now.unit.hour * 4) + (now.unit.minute / 15);
+    uint8_t start = r->active_start_qh;
+    uint8_t end = r->active_end_qh;
+
+    if (start < end) return current_qh < start || current_qh >= end;
+    if (start > end) return current_qh >= end && current_qh < start;
+    return false;
+}
+
+static void _close_night(replay_t *r) {
+    sleep_tracker_state_t *tracker = &r->sleep_tracker;
+
+    sleep_tracker_end_session(tracker);
+    if (tracker->total_sleep_minutes == 0) return;
+
+    uint16_t total_minutes = tracker->total_sleep_minutes + tracker->total_wake_minutes;
+    circadian_sleep_night_t night = {
+        .onset_timestamp = tracker->sleep_onset_time,
+        .offset_timestamp = tracker->sleep_offset_time,
+        .duration_min = tracker->total_sleep_minutes,
+        .efficiency = (uint8_t)(tracker->total_sleep_minutes * 100 / total_minutes),
+        .waso_min = tracker->total_wake_minutes,
+        .awakenings = tracker->num_awakenings,
+        .light_quality = (uint8_t)(tracker->total_dark_minutes * 100 / total_minutes),
+        .valid = true
+    };
+    circadian_data_add_night(&r->circadian, &night);
+    phase_learn_acrophase(&r->phase, &r->circadian, 0);
+    r->nights_closed++;
+}
+
+static void _top_of_minute(replay_t *r, watch_date_time_t date_time) {
+    bool in_sleep_window = _is_sleep_window(r, date_time);
+
+    if (in_sleep_window && !r->was_in_sleep_window) {
+        sleep_tracker_start_session(&r->sleep_tracker);
+    } else if (!in_sleep_window && r->was_in_sleep_window) {
+        _close_night(r);
+    }
+    r->was_in_sleep_window = in_sleep_window;
+
+    // Cole-Kripke works on one-minute activity counts; its light classes are on a 0-255 scale.
+    if (in_sleep_window && r->sleep_tracker.tracking_active) {
+        uint8_t light_level = r->lux > 255 ? 255 : (uint8_t)r->lux;
+        bool asleep = sleep_tracker_classify_epoch(&r->sleep_tracker, r->minute_motion, light_level);
+        sleep_tracker_update_metrics(&r->sleep_tracker, asleep);
+    }
+    r->minute_motion = 0;
+
+    // Traces are in local time with no location set.
+    calendar_context_t *cal = &r->calendar;
+    calendar_context_update(cal, date_time, 0, 0, 0, true, r->active_start_qh, r->active_end_qh);
+    r->metric_tick_count++;
+
+    bool is_hourly_tick = (r->last_telemetry_hour != cal->hour);
+    if (is_hourly_tick) r->last_telemetry_hour = cal->hour;
+
+    // No display here, so never a zone face in the foreground.
+    bool asleep = in_sleep_window && (host_fake.wakeup_source & LIS2DW_WAKEUP_SRC_SLEEP_STATE) == 0;
+    sensors_schedule_tick(&r->sensors,
+                          asleep ? SENSOR_CONTEXT_ASLEEP : in_sleep_window ? SENSOR_CONTEXT_SLEEP_WINDOW : SENSOR_CONTEXT_AWAKE,
+                          cal->minute_of_day);
+
+    uint8_t conditions = 0;
+    if (sensors_get_motion_variance(&r->sensors) >= METRIC_CADENCE_HIGH_MOTION_VARIANCE) {
+        conditions |= METRIC_CADENCE_HIGH_MOTION;
+    }
+    if (asleep) {
+        conditions |= METRIC_CADENCE_ASLEEP;
+    }
+    uint8_t interval = metric_cadence_interval(conditions);
+    if (!metric_cadence_due(interval, cal->minute_of_day, r->metric_tick_count)) return;
+    r->metric_tick_count = 0;
+
+    int16_t temp_c10 = sensors_get_temperature_c10(&r->sensors);
+    uint16_t light_lux = sensors_get_lux_avg(&r->sensors);
+
+    uint16_t phase_score = phase_compute(&r->phase, cal->hour, cal->minute, cal->day_of_year,
+                                         sensors_get_activity_level(&r->sensors), temp_c10, light_lux);
+    metrics_update(&r->metrics, &r->sensors, cal, (uint8_t)phase_score,
+                   r->cumulative_activity, &r->circadian, true);
+
+    metrics_snapshot_t snapshot;
+    metrics_get(&r->metrics, &snapshot);
+    if (cal->minute % 15 == 0) {
+        playlist_update(&r->playlist, phase_score, &snapshot);
+        phase_detect_anomalies(&r->phase, snapshot.sd, snapshot.em, snapshot.energy, snapshot.comfort, cal->hour,
+                               cal->active_hours_enabled, cal->active_start_hour, cal->active_end_hour);
+    }
+
+    if (is_hourly_tick) {
+        phase_zone_t current_zone = playlist_get_zone(&r->playlist);
+
+        if (r->prev_snapshot_valid) {
+            sleep_data_accumulate_telemetry(&r->sleep_telemetry, cal->hour, current_zone, r->prev_zone_hourly,
+                                            (dominant_metric_t)metrics_get_dominant(&snapshot, current_zone),
+                                            r->phase.anomaly_flags != ANOMALY_NONE,
+                                            sensors_get_hourly_light_minutes(&r->sensors),
+                                            sensors_get_hourly_movement_count(&r->sensors),
+                                            sensors_get_vcc_mv(&r->sensors),
+                                            snapshot.sd, r->prev_snapshot.sd,
+                                            snapshot.em, r->prev_snapshot.em,
+                                            snapshot.energy, r->prev_snapshot.energy,
+                                            snapshot.comfort, r->prev_snapshot.comfort);
+        }
+        r->prev_snapshot = snapshot;
+        r->prev_snapshot_valid = true;
+        r->prev_zone_hourly = current_zone;
+
+        sensors_reset_hourly_counters(&r->sensors);
+        if (cal->hour == 0) sleep_data_reset_daily_telemetry(&r->sleep_telemetry);
+    }
+}
+
+static void _tick(replay_t *r, watch_date_time_t date_time) {
+    sensors_tick_epoch(&r->sensors);
+
+    r->sensors.epoch_seconds++;
+    if (r->sensors.epoch_seconds >= 30) {
+        r->sensors.epoch_seconds = 0;
+        // movement.c's is_confirmed_asleep: a clear sleep-state bit means the wearer was still.
+        bool still = (host_fake.wakeup_source & LIS2DW_WAKEUP_SRC_SLEEP_STATE) == 0;
+        if (_is_sleep_window(r, date_time) && still) {
+            sleep_data_record_epoch(&r->sleep_telemetry, sensors_get_epoch_movement_count(&r->sensors));
+            r->sensors.epoch_movement_count = 0;
+        }
+    }
+}
+
+static void _apply_event(replay_t *r, const trace_event_t *event) {
+    switch (event->kind) {
+        case TRACE_EVENT_MOTION:
+            for (int32_t i = 0; i < event->value; i++) {
+                // what cb_accelerometer_event counts
+                if (r->sensors.epoch_movement_count < 255) r->sensors.epoch_movement_count++;
+                if (r->sensors.hourly_movement_count < 255) r->sensors.hourly_movement_count++;
+            }
+            r->minute_motion += (uint16_t)event->value;
+            r->hour_motion += (uint32_t)event->value;
+            r->last_motion_t = event->t;
+            r->any_motion = true;
+            break;
+        case TRACE_EVENT_LUX:
+            r->lux = event->value < 0 ? 0 : event->value > 10000 ? 10000 : (uint16_t)event->value;
+            host_fake.light_adc = r->lux * 6;   // sensors.c divides by 6
+            break;
+        case TRACE_EVENT_TEMP:
+            host_fake.temperature_c100 = (int16_t)(event->value * 10);
+            break;
+        case TRACE_EVENT_VCC:
+            host_fake.vcc_mv = (uint16_t)event->value;
+            break;
+        case TRACE_EVENT_BUTTON:
+            r->hour_buttons++;
+            break;
+    }
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static void _csv_header(FILE *out) {
+    fprintf(out, "time,phase,zone,sd,em,wk,energy,comfort,lux,temp_c10,motion,buttons,"
+                 "sleep_epochs,restlessness,ck_sleep_min,ck_wake_min,ck_awakenings,anomalies\n");
+}
+
+// One row per hour, stamped with the start of the hour it covers.
+static void _csv_row(FILE *out, replay_t *r, uint32_t hour_start) {
+    watch_date_time_t t = watch_utility_date_time_from_unix_time(hour_start, 0);
+    metrics_snapshot_t m;
+
+    metrics_get(&r->metrics, &m);
+    fprintf(out, "%04u-%02u-%02uT%02u:00,%u,%u,%u,%u,%u,%u,%u,%u,%d,%lu,%u,%u,%u,%u,%u,%u,%u\n",
+            t.unit.year + WATCH_RTC_REFERENCE_YEAR, t.unit.month, t.unit.day, t.unit.hour,
+            r->phase.last_phase_score, playlist_get_zone(&r->playlist),
+            m.sd, m.em, m.wk, m.energy, m.comfort,
+            sensors_get_lux_avg(&r->sensors), sensors_get_temperature_c10(&r->sensors),
+            (unsigned long)r->hour_motion, r->hour_buttons,
+            r->sleep_telemetry.sleep_states.total_epochs, sleep_data_calc_restlessness(&r->sleep_telemetry),
+            r->sleep_tracker.total_sleep_minutes, r->sleep_tracker.total_wake_minutes,
+            r->sleep_tracker.num_awakenings, r->phase.anomaly_flags);
+
+    r->hour_motion = 0;
+    r->hour_buttons = 0;
+}
+
+// ============================================================================
+
+static bool _parse_list(const char *arg, long *values, int count) {
+    char *end;
+
+    for (int i = 0; i < count; i++) {
+        values[i] = strtol(arg, &end, 10);
+        if (end == arg) return false;
+        if (i < count - 1) {
+            if (*end != ',') return false;
+            arg = end + 1;
+        }
+    }
+    return *end == '\0';
+}
+
+static void _usage(void) {
+    fprintf(stderr,
+            "usage: replay_host [-o FILE] [--sleep-thresholds L,R,W] [--light-modifiers D,M,O,B]\n"
+            "                   [--zone-weight ZONE,METRIC,WEIGHT]... TRACE\n"
+            "       replay_host [-o FILE] [--seed N] --synthesize DAYS\n");
+}
+
+int main(int argc, char *argv[]) {
+    replay_t *r = &_replay;
+    const char *trace_path = NULL;
+    const char *out_path = NULL;
+    long synth_days = -1;
+    unsigned long seed = 1;
+    long thresholds[3] = { 0 };
+    bool has_thresholds = false;
+    long modifiers[4];
+    bool has_modifiers = false;
+
+    for (int i = 1; i < argc; i++) {
+        long v[3];
+        bool has_arg = i + 1 < argc;
+
+        if (strcmp(argv[i], "-o") == 0 && has_arg) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--synthesize") == 0 && has_arg) {
+            synth_days = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_arg) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--sleep-thresholds") == 0 && has_arg && _parse_list(argv[i + 1], thresholds, 3)) {
+            has_thresholds = true;
+            i++;
+        } else if (strcmp(argv[i], "--light-modifiers") == 0 && has_arg && _parse_list(argv[i + 1], modifiers, 4)) {
+            has_modifiers = true;
+            i++;
+        } else if (strcmp(argv[i], "--zone-weight") == 0 && has_arg && _parse_list(argv[i + 1], v, 3) &&
+                   v[0] >= 0 && v[0] <= ZONE_DESCENT && v[1] >= 0 && v[1] < 5 && v[2] >= 0 && v[2] <= 100) {
+            playlist_set_zone_weight((phase_zone_t)v[0], (uint8_t)v[1], (uint8_t)v[2]);
+            i++;
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            trace_path = argv[i];
+        } else {
+            _usage();
+            return 2;
+        }
+    }
+
+    FILE *out = stdout;
+    if (out_path != NULL && (out = fopen(out_path, "w")) == NULL) {
+        fprintf(stderr, "replay: can't write %s\n", out_path);
+        return 2;
+    }
+
+    if (synth_days >= 0) {
+        trace_synthesize(out, (uint16_t)synth_days, (uint32_t)seed);
+        if (out != stdout) fclose(out);
+        return 0;
+    }
+
+    trace_reader_t reader;
+    if (trace_path == NULL) {
+        _usage();
+        return 2;
+    }
+    if (!trace_open(&reader, trace_path)) return 2;
+
+    // boot, the way app_setup brings the phase engine up.
+    host_fake_reset();
+    memset(r, 0, sizeof(*r));
+    phase_engine_init(&r->phase);
+    metrics_init(&r->metrics);
+    playlist_init(&r->playlist);
+    sleep_data_init(&r->sleep_telemetry);
+    sensors_init(&r->sensors, true, true);
+    sensors_configure_accel(&r->sensors);
+    memcpy(r->sleep_tracker.light_modifiers, _default_light_modifiers, sizeof(_default_light_modifiers));
+    r->last_telemetry_hour = 255;
+    r->active_start_qh = reader.active_start_qh;
+    r->active_end_qh = reader.active_end_qh;
+    r->circadian.active_hours_start_min = reader.active_start_qh * 15;
+    r->circadian.active_hours_end_min = reader.active_end_qh * 15;
+
+    if (has_thresholds) {
+        r->sleep_telemetry.thresholds.light_threshold = (uint8_t)thresholds[0];
+        r->sleep_telemetry.thresholds.restless_threshold = (uint8_t)thresholds[1];
+        r->sleep_telemetry.thresholds.wake_threshold = (uint8_t)thresholds[2];
+    }
+    if (has_modifiers) {
+        for (int i = 0; i < 4; i++) r->sleep_tracker.light_modifiers[i] = (int16_t)modifiers[i];
+    }
+
+    host_fake_set_time(reader.start_year, reader.start_month, reader.start_day, reader.start_hour, reader.start_minute);
+    host_fake.date_time.unit.second = reader.start_second;
+    uint32_t start_unix = watch_utility_date_time_to_unix_time(host_fake.date_time, 0);
+
+    clock_t wall_start = clock();
+    trace_event_t event;
+    bool has_event = trace_next(&reader, &event);
+    uint32_t hour_start = start_unix - start_unix % 3600;
+    uint32_t now = start_unix;
+
+    _csv_header(out);
+
+    // run to the end of the hour holding the last event, so the final row is complete.
+    while (has_event || now % 3600 != 0) {
+        uint32_t t = now - start_unix;
+
+        while (has_event && event.t <= t) {
+            _apply_event(r, &event);
+            has_event = trace_next(&reader, &event);
+        }
+        if (reader.error) break;
+
+        watch_date_time_t date_time = watch_utility_date_time_from_unix_time(now, 0);
+        host_fake.date_time = date_time;
+        host_fake.counter = now;
+        // a wake interrupt in the last minute leaves the sleep-state bit clear.
+        host_fake.wakeup_source = (r->any_motion && now - start_unix - r->last_motion_t < 60)
+                                  ? LIS2DW_WAKEUP_SRC_WAKEUP : 0;
+
+        if (date_time.unit.second == 0) {
+            if (date_time.unit.minute == 0 && now != start_unix) {
+                _csv_row(out, r, hour_start);
+                hour_start = now;
+            }
+            _top_of_minute(r, date_time);
+        }
+        _tick(r, date_time);
+        now++;
+    }
+    if (!reader.error) _csv_row(out, r, hour_start);
+    trace_close(&reader);
+
+    double wall = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+    double simulated = (double)(now - start_unix);
+    fprintf(stderr, "replay: %.1f days in %.2f s (%.0fx real time), %u nights closed\n",
+            simulated / 86400.0, wall, wall > 0 ? simulated / wall : 0.0, r->nights_closed);
+
+    if (out != stdout) fclose(out);
+    return reader.error ? 1 : 0;
+}
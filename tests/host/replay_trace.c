@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: sensor trace format
+ * Implementation
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay_trace.h"
+
+#define TRACE_LINE_MAX 128
+
+static const char *const _button_names[] = {
+    "light", "mode", "alarm", "light_long", "mode_long", "alarm_long",
+};
+
+static void _trace_fail(trace_reader_t *reader, const char *why) {
+    fprintf(stderr, "trace:%lu: %s\n", (unsigned long)reader->line, why);
+    reader->error = true;
+}
+
+// Reads the next meaningful line into buf. False at end of file.
+static bool _trace_read_line(trace_reader_t *reader, char *buf) {
+    while (fgets(buf, TRACE_LINE_MAX, reader->file) != NULL) {
+        reader->line++;
+        char *p = buf;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') continue;
+        if (p != buf) memmove(buf, p, strlen(p) + 1);
+        return true;
+    }
+    return false;
+}
+
+static bool _trace_parse_event(trace_reader_t *reader, const char *buf, trace_event_t *event) {
+    unsigned long t;
+    char kind[16];
+    char arg[16] = "";
+    int fields = sscanf(buf, "%lu %15s %15s", &t, kind, arg);
+
+    if (fields < 2) {
+        _trace_fail(reader, "expected `<t> <kind> [value]`");
+        return false;
+    }
+    if (t < reader->last_t) {
+        _trace_fail(reader, "events out of order");
+        return false;
+    }
+    event->t = (uint32_t)t;
+    reader->last_t = event->t;
+
+    if (strcmp(kind, "motion") == 0) {
+        event->kind = TRACE_EVENT_MOTION;
+        event->value = (fields == 3) ? (int32_t)strtol(arg, NULL, 10) : 1;
+        return true;
+    }
+
+    if (strcmp(kind, "button") == 0) {
+        event->kind = TRACE_EVENT_BUTTON;
+        for (size_t i = 0; i < sizeof(_button_names) / sizeof(_button_names[0]); i++) {
+            if (fields == 3 && strcmp(arg, _button_names[i]) == 0) {
+                event->value = (int32_t)i;
+                return true;
+            }
+        }
+        _trace_fail(reader, "unknown button");
+        return false;
+    }
+
+    if (fields != 3) {
+        _trace_fail(reader, "missing value");
+        return false;
+    }
+    event->value = (int32_t)strtol(arg, NULL, 10);
+
+    if (strcmp(kind, "lux") == 0) {
+        event->kind = TRACE_EVENT_LUX;
+    } else if (strcmp(kind, "temp") == 0) {
+        event->kind = TRACE_EVENT_TEMP;
+    } else if (strcmp(kind, "vcc") == 0) {
+        event->kind = TRACE_EVENT_VCC;
+    } else {
+        _trace_fail(reader, "unknown event kind");
+        return false;
+    }
+
+    return true;
+}
+
+bool trace_open(trace_reader_t *reader, const char *path) {
+    char buf[TRACE_LINE_MAX];
+    bool has_start = false;
+
+    memset(reader, 0, sizeof(*reader));
+    reader->active_start_qh = 7 * 4;
+    reader->active_end_qh = 23 * 4;
+
+    reader->file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    if (reader->file == NULL) {
+        fprintf(stderr, "trace: can't open %s\n", path);
+        return false;
+    }
+
+    while (_trace_read_line(reader, buf)) {
+        unsigned y, mo, d, h, mi, s, h2, mi2;
+
+        if (strncmp(buf, "start", 5) == 0) {
+            if (sscanf(buf + 5, " %u-%u-%uT%u:%u:%u", &y, &mo, &d, &h, &mi, &s) != 6 ||
+                y < 2020 || y > 2083 || mo < 1 || mo > 12 || d < 1 || d > 31 || h > 23 || mi > 59 || s > 59) {
+                _trace_fail(reader, "expected `start YYYY-MM-DDTHH:MM:SS`");
+                break;
+            }
+            reader->start_year = (uint16_t)y;
+            reader->start_month = (uint8_t)mo;
+            reader->start_day = (uint8_t)d;
+            reader->start_hour = (uint8_t)h;
+            reader->start_minute = (uint8_t)mi;
+            reader->start_second = (uint8_t)s;
+            has_start = true;
+        } else if (strncmp(buf, "active", 6) == 0) {
+            if (sscanf(buf + 6, " %u:%u %u:%u", &h, &mi, &h2, &mi2) != 4 || h > 23 || h2 > 23 || mi > 59 || mi2 > 59) {
+                _trace_fail(reader, "expected `active HH:MM HH:MM`");
+                break;
+            }
+            reader->active_start_qh = (uint8_t)(h * 4 + mi / 15);
+            reader->active_end_qh = (uint8_t)(h2 * 4 + mi2 / 15);
+        } else {
+            if (!has_start) {
+                _trace_fail(reader, "`start` must come before the first event");
+                break;
+            }
+            reader->has_pending = _trace_parse_event(reader, buf, &reader->pending);
+            break;
+        }
+    }
+
+    if (!reader->error && !has_start) _trace_fail(reader, "no `start` record");
+    if (reader->error) {
+        trace_close(reader);
+        return false;
+    }
+
+    return true;
+}
+
+bool trace_next(trace_reader_t *reader, trace_event_t *event) {
+    char buf[TRACE_LINE_MAX];
+
+    if (reader->error) return false;
+    if (reader->has_pending) {
+        *event = reader->pending;
+        reader->has_pending = false;
+        return true;
+    }
+    if (!_trace_read_line(reader, buf)) return false;
+
+    return _trace_parse_event(reader, buf, event);
+}
+
+void trace_close(trace_reader_t *reader) {
+    if (reader->file != NULL && reader->file != stdin) fclose(reader->file);
+    reader->file = NULL;
+}
+
+// ============================================================================
+// Synthetic traces
+// ============================================================================
+
+static uint32_t _synth_state;
+
+static uint32_t _synth_rand(uint32_t range) {
+    // xorshift32
+    _synth_state ^= _synth_state << 13;
+    _synth_state ^= _synth_state >> 17;
+    _synth_state ^= _synth_state << 5;
+    return _synth_state % range;
+}
+
+void trace_synthesize(FILE *out, uint16_t days, uint32_t seed) {
+    _synth_state = seed ? seed : 1;
+
+    fprintf(out, "# synthetic trace: %u days, seed %lu\n", days, (unsigned long)seed);
+    fprintf(out, "start 2026-03-01T00:00:00\n");
+    fprintf(out, "active 07:00 23:00\n");
+
+    for (uint32_t day = 0; day < days; day++) {
+        // one wakeful bout a night, somewhere between 01:00 and 05:00.
+        uint32_t bout_start = 60 + _synth_rand(240);
+        uint32_t bout_length = 5 + _synth_rand(15);
+        // ambient drifts a little warmer each day through spring.
+        int32_t ambient_c10 = 140 + (int32_t)(day * 60 / (days ? days : 1)) + (int32_t)_synth_rand(20);
+
+        for (uint32_t minute = 0; minute < 1440; minute++) {
+            uint32_t t = (day * 1440 + minute) * 60;
+            uint32_t hour = minute / 60;
+            bool asleep = hour >= 23 || hour < 7;
+            uint32_t night_minute = (hour >= 23) ? minute - 23 * 60 : minute + 60;
+            bool in_bout = asleep && night_minute >= bout_start && night_minute < bout_start + bout_length;
+
+            if (minute % 5 == 0) {
+                uint32_t lux;
+                if (asleep) lux = in_bout ? 30 + _synth_rand(40) : _synth_rand(4);
+                else if (hour >= 9 && hour < 18) lux = 400 + _synth_rand(1600);
+                else lux = 80 + _synth_rand(200);
+                fprintf(out, "%lu lux %lu\n", (unsigned long)t, (unsigned long)lux);
+            }
+            if (minute % 15 == 0) {
+                // on-wrist temperature: warmer in bed.
+                int32_t temp = ambient_c10 + (asleep ? 60 : 30) + (int32_t)_synth_rand(10);
+                fprintf(out, "%lu temp %ld\n", (unsigned long)t, (long)temp);
+            }
+            if (minute == 0) {
+                fprintf(out, "%lu vcc %lu\n", (unsigned long)t, (unsigned long)(3000 - day * 2 - _synth_rand(10)));
+            }
+
+            uint32_t chance = asleep ? (in_bout ? 80 : 4) : 60;
+            if (_synth_rand(100) < chance) {
+                uint32_t count = asleep && !in_bout ? 1 : 1 + _synth_rand(3);
+                fprintf(out, "%lu motion %lu\n", (unsigned long)(t + _synth_rand(60)), (unsigned long)count);
+            }
+            if (!asleep && _synth_rand(1000) < 5) {
+                fprintf(out, "%lu button %s\n", (unsigned long)(t + 59), _button_names[_synth_rand(6)]);
+            }
+        }
+    }
+}
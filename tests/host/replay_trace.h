@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: sensor trace format
+ *
+ * A trace is plain text, one record per line; blank lines and lines starting
+ * with '#' are ignored. Two header records set the scene:
+ *
+ *   start 2026-03-01T00:00:00      wall-clock time at t=0 (watch local time)
+ *   active 07:00 23:00             active hours; the sleep window is the rest
+ *
+ * Every other record is an event, stamped with whole seconds since start:
+ *
+ *   <t> motion [count]             LIS2DW wake interrupt(s) during that second
+ *   <t> lux <lux>                  ambient light, held until the next sample
+ *   <t> temp <celsius * 10>        temperature, held until the next sample
+ *   <t> vcc <millivolts>           battery voltage, held until the next sample
+ *   <t> button <name>              light, mode, alarm, or one of those + "_long"
+ *
+ * Events must come in time order. Motion is the only one that is an event in
+ * the strict sense; the rest are samples of a level.
+ */
+
+#ifndef REPLAY_TRACE_H_
+#define REPLAY_TRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    TRACE_EVENT_MOTION = 0,
+    TRACE_EVENT_LUX,
+    TRACE_EVENT_TEMP,
+    TRACE_EVENT_VCC,
+    TRACE_EVENT_BUTTON,
+} trace_event_kind_t;
+
+typedef enum {
+    TRACE_BUTTON_LIGHT = 0,
+    TRACE_BUTTON_MODE,
+    TRACE_BUTTON_ALARM,
+    TRACE_BUTTON_LIGHT_LONG,
+    TRACE_BUTTON_MODE_LONG,
+    TRACE_BUTTON_ALARM_LONG,
+} trace_button_t;
+
+typedef struct {
+    uint32_t t;                 // seconds since start
+    trace_event_kind_t kind;
+    int32_t value;              // count, lux, temp_c10, mV or trace_button_t
+} trace_event_t;
+
+typedef struct {
+    FILE *file;
+    uint32_t line;
+    uint32_t last_t;
+    // from the header
+    uint16_t start_year;
+    uint8_t start_month;
+    uint8_t start_day;
+    uint8_t start_hour;
+    uint8_t start_minute;
+    uint8_t start_second;
+    uint8_t active_start_qh;    // quarter hours, like movement_active_hours_t
+    uint8_t active_end_qh;
+    // one event of lookahead, read while parsing the header
+    trace_event_t pending;
+    bool has_pending;
+    bool error;
+} trace_reader_t;
+
+/**
+ * Open a trace and read its header. Returns false, having printed why, if the
+ * file can't be opened or the header is missing or malformed.
+ */
+bool trace_open(trace_reader_t *reader, const char *path);
+
+/**
+ * Read the next event. Returns false at end of file or on a malformed line;
+ * reader->error tells the two apart.
+ */
+bool trace_next(trace_reader_t *reader, trace_event_t *event);
+
+void trace_close(trace_reader_t *reader);
+
+/**
+ * Write a synthetic trace: `days` of a regular 23:00-07:00 sleeper with an
+ * active day, a few wakeful minutes a night and a seasonal temperature drift.
+ * Deterministic for a given seed, so sweeps compare like with like.
+ */
+void trace_synthesize(FILE *out, uint16_t days, uint32_t seed);
+
+#endif // REPLAY_TRACE_H_
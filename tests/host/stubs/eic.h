@@ -0,0 +1,12 @@
+// Host build stand-in for gossamer's EIC header.
+#ifndef HOST_EIC_H_
+#define HOST_EIC_H_
+
+typedef enum {
+    INTERRUPT_TRIGGER_NONE = 0,
+    INTERRUPT_TRIGGER_RISING,
+    INTERRUPT_TRIGGER_FALLING,
+    INTERRUPT_TRIGGER_BOTH,
+} eic_interrupt_trigger_t;
+
+#endif // HOST_EIC_H_
@@ -0,0 +1,52 @@
+// Host build stand-in for movement.h: just the calls the code under test makes into Movement,
+// plus the event types a watch face's loop needs to compile.
+#ifndef HOST_MOVEMENT_H_
+#define HOST_MOVEMENT_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "watch.h"
+#include "lis2dw.h"
+
+typedef enum {
+    EVENT_NONE = 0,
+    EVENT_ACTIVATE,
+    EVENT_TICK,
+    EVENT_LOW_ENERGY_UPDATE,
+    EVENT_BACKGROUND_TASK,
+    EVENT_TIMEOUT,
+    EVENT_LIGHT_BUTTON_DOWN,
+    EVENT_LIGHT_BUTTON_UP,
+    EVENT_LIGHT_LONG_PRESS,
+    EVENT_LIGHT_LONG_UP,
+    EVENT_LIGHT_REALLY_LONG_PRESS,
+    EVENT_MODE_BUTTON_DOWN,
+    EVENT_MODE_BUTTON_UP,
+    EVENT_MODE_LONG_PRESS,
+    EVENT_MODE_LONG_UP,
+    EVENT_MODE_REALLY_LONG_PRESS,
+    EVENT_ALARM_BUTTON_DOWN,
+    EVENT_ALARM_BUTTON_UP,
+    EVENT_ALARM_LONG_PRESS,
+    EVENT_ALARM_LONG_UP,
+    EVENT_ALARM_REALLY_LONG_PRESS,
+    EVENT_ACCELEROMETER_WAKE,
+    EVENT_SINGLE_TAP,
+    EVENT_DOUBLE_TAP,
+} movement_event_type_t;
+
+typedef struct {
+    uint8_t event_type;
+    uint8_t subsecond;
+} movement_event_t;
+
+float movement_get_temperature(void);
+uint8_t movement_claim_backup_register(void);
+lis2dw_data_rate_t movement_get_accelerometer_background_rate(void);
+void movement_move_to_face(uint8_t watch_face_index);
+bool movement_default_loop_handler(movement_event_t event);
+void movement_illuminate_led(void);
+
+#endif // HOST_MOVEMENT_H_
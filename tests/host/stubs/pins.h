@@ -0,0 +1,14 @@
+// Host build stand-in for the board pin header. Only what the libraries under test touch.
+#ifndef HOST_PINS_H_
+#define HOST_PINS_H_
+
+#define HAL_GPIO_A2_pin() 2
+
+// The board header pulls in CMSIS on hardware; these are the intrinsics the shared code uses for
+// critical sections. There are no interrupts on the host, so they only keep the books.
+#include <stdint.h>
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) { }
+
+#endif // HOST_PINS_H_
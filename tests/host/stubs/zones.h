@@ -0,0 +1,7 @@
+// Host build stand-in for utz's generated zone table.
+#ifndef HOST_ZONES_H_
+#define HOST_ZONES_H_
+
+extern const char zone_names[];
+
+#endif // HOST_ZONES_H_
@@ -0,0 +1,251 @@
+// Host tests for the LIS2DW driver itself, linked against a fake I2C bus that
+// models the chip's registers and FIFO and counts what crosses the wire.
+// host_stubs.c fakes the driver for everything above it, so this is its own
+// binary; see the Makefile.
+
+#include <stdio.h>
+#include <string.h>
+#include "lis2dw.h"
+#include "watch_i2c.h"
+
+static unsigned _checks;
+static unsigned _failures;
+static const char *_current_test;
+
+static void _expect_eq(long actual, long expected, const char *expr, int line) {
+    _checks++;
+    if (actual == expected) return;
+    _failures++;
+    printf("FAIL %s:%d %s = %ld, expected %ld\n", _current_test, line, expr, actual, expected);
+}
+
+#define EXPECT_EQ(actual, expected) _expect_eq((long)(actual), (long)(expected), #actual, __LINE__)
+#define EXPECT_TRUE(cond) _expect_eq((long)!!(cond), 1, #cond, __LINE__)
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+// ============================================================================
+// Fake bus
+// ============================================================================
+
+#define FAKE_FIFO_DEPTH 40  // deeper than the chip's 32, so a clamp has something to hold back
+
+static struct {
+    uint8_t regs[0x40];
+    uint8_t pointer;                        // register address, auto-incremented
+    uint8_t fifo_samples;                   // what FIFO_SAMPLES reads
+    lis2dw_reading_t fifo[FAKE_FIFO_DEPTH];
+    uint8_t fifo_queued;
+    uint8_t fifo_popped;                    // samples read out of OUT_X_L..OUT_Z_H
+    uint32_t transactions;                  // START to STOP
+    uint32_t bytes;                         // on the wire, the address byte of each transaction included
+    uint16_t largest_receive;
+    uint8_t fail_send;                      // fail the nth send from now, 1 being the next
+} _bus;
+
+static void _bus_reset(void) {
+    memset(&_bus, 0, sizeof(_bus));
+}
+
+// Each further six bytes from the output registers pop the next FIFO sample; past the
+// last one the chip keeps returning it.
+static uint8_t _bus_read_register(void) {
+    if (_bus.pointer == LIS2DW_REG_FIFO_SAMPLE) return _bus.fifo_samples;
+    if (_bus.pointer < LIS2DW_REG_OUT_X_L || _bus.pointer > LIS2DW_REG_OUT_Z_H) return _bus.regs[_bus.pointer & 0x3F];
+
+    uint8_t index = (_bus.fifo_popped < _bus.fifo_queued) ? _bus.fifo_popped : (_bus.fifo_queued ? _bus.fifo_queued - 1 : 0);
+    return ((const uint8_t *)&_bus.fifo[index])[_bus.pointer - LIS2DW_REG_OUT_X_L];
+}
+
+int8_t watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
+    (void) addr;
+    _bus.transactions++;
+    _bus.bytes += 1 + length;
+    if (_bus.fail_send && --_bus.fail_send == 0) return -1;
+
+    _bus.pointer = buf[0] & 0x7F;   // the top bit only asks for auto-increment
+    for (uint16_t i = 1; i < length; i++) _bus.regs[_bus.pointer++ & 0x3F] = buf[i];
+    return 0;
+}
+
+int8_t watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
+    (void) addr;
+    _bus.transactions++;
+    _bus.bytes += 1 + length;
+    if (length > _bus.largest_receive) _bus.largest_receive = length;
+
+    for (uint16_t i = 0; i < length; i++) {
+        buf[i] = _bus_read_register();
+        if (_bus.pointer == LIS2DW_REG_OUT_Z_H) {
+            _bus.pointer = LIS2DW_REG_OUT_X_L;
+            _bus.fifo_popped++;
+        } else {
+            _bus.pointer++;
+        }
+    }
+    return 0;
+}
+
+// The register helpers, built on send and receive as watch_i2c.c builds them.
+int8_t watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
+    uint8_t buf[2] = { reg, data };
+    return watch_i2c_send(addr, buf, 2);
+}
+
+uint8_t watch_i2c_read8(int16_t addr, uint8_t reg) {
+    uint8_t data;
+    if (watch_i2c_send(addr, &reg, 1) != 0) return 0;
+    if (watch_i2c_receive(addr, &data, 1) != 0) return 0;
+    return data;
+}
+
+uint16_t watch_i2c_read16(int16_t addr, uint8_t reg) {
+    uint16_t data;
+    if (watch_i2c_send(addr, &reg, 1) != 0) return 0;
+    if (watch_i2c_receive(addr, (uint8_t *)&data, 2) != 0) return 0;
+    return data;
+}
+
+static void _bus_queue(uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        _bus.fifo[i] = (lis2dw_reading_t){ (int16_t)(i * 16), (int16_t)(-i * 32), (int16_t)(16384 - i) };
+    }
+    _bus.fifo_queued = count;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void test_read_fifo_burst(void) {
+    lis2dw_fifo_t fifo;
+
+    // A full FIFO: the count, then every sample in one auto-increment read.
+    _bus_queue(32);
+    _bus.fifo_samples = LIS2DW_FIFO_SAMPLE_THRESHOLD | 32;
+    EXPECT_EQ(lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT), false);
+    EXPECT_EQ(fifo.count, 32);
+    EXPECT_EQ(memcmp(fifo.readings, _bus.fifo, sizeof(fifo.readings)), 0);
+    EXPECT_EQ(_bus.fifo_popped, 32);
+    EXPECT_EQ(_bus.transactions, 4);
+    EXPECT_EQ(_bus.bytes, 199);     // 2 + 2 for the count, 2 + 193 for the samples
+    EXPECT_EQ(_bus.largest_receive, 32 * sizeof(lis2dw_reading_t));
+
+    // An empty one costs the count read and nothing more.
+    _bus_reset();
+    EXPECT_EQ(lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT), false);
+    EXPECT_EQ(fifo.count, 0);
+    EXPECT_EQ(_bus.transactions, 2);
+    EXPECT_EQ(_bus.fifo_popped, 0);
+
+    // A few samples come out in the same two transfers.
+    _bus_reset();
+    _bus_queue(5);
+    _bus.fifo_samples = 5;
+    lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT);
+    EXPECT_EQ(fifo.count, 5);
+    EXPECT_EQ(memcmp(fifo.readings, _bus.fifo, 5 * sizeof(lis2dw_reading_t)), 0);
+    EXPECT_EQ(_bus.transactions, 4);
+    EXPECT_EQ(_bus.bytes, 4 + 2 + 5 * sizeof(lis2dw_reading_t) + 1);
+}
+
+static void test_read_fifo_clamp(void) {
+    // FIFO_SAMPLES has six bits of count; anything past the chip's 32 must not run off the buffer.
+    struct {
+        lis2dw_fifo_t fifo;
+        uint8_t guard[16];
+    } out;
+    memset(out.guard, 0xA5, sizeof(out.guard));
+
+    _bus_queue(FAKE_FIFO_DEPTH);
+    _bus.fifo_samples = LIS2DW_FIFO_SAMPLE_OVERRUN | LIS2DW_FIFO_SAMPLE_COUNT;
+    EXPECT_EQ(lis2dw_read_fifo(&out.fifo, LIS2DW_FIFO_TIMEOUT), true);
+    EXPECT_EQ(out.fifo.count, 32);
+    EXPECT_EQ(_bus.fifo_popped, 32);
+    EXPECT_EQ(_bus.largest_receive, 32 * sizeof(lis2dw_reading_t));
+    EXPECT_EQ(_bus.bytes, 199);
+    for (uint8_t i = 0; i < sizeof(out.guard); i++) EXPECT_EQ(out.guard[i], 0xA5);
+}
+
+static void test_read_fifo_bus_error(void) {
+    lis2dw_fifo_t fifo;
+
+    // The count read fails: read8 gives 0, so nothing is drained.
+    _bus_queue(8);
+    _bus.fifo_samples = 8;
+    _bus.fail_send = 1;
+    fifo.count = 99;
+    lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT);
+    EXPECT_EQ(fifo.count, 0);
+    EXPECT_EQ(_bus.fifo_popped, 0);
+
+    // The burst fails: no samples rather than stale ones.
+    _bus.fail_send = 2;
+    _bus.transactions = 0;
+    fifo.count = 99;
+    lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT);
+    EXPECT_EQ(fifo.count, 0);
+    EXPECT_EQ(_bus.transactions, 3);    // the count read, then the failed burst address write
+}
+
+static void test_raw_reading(void) {
+    // One sample is one register write and one six-byte read.
+    _bus_queue(1);
+    lis2dw_reading_t reading = lis2dw_get_raw_reading();
+    EXPECT_EQ(reading.x, _bus.fifo[0].x);
+    EXPECT_EQ(reading.y, _bus.fifo[0].y);
+    EXPECT_EQ(reading.z, _bus.fifo[0].z);
+    EXPECT_EQ(_bus.transactions, 2);
+    EXPECT_EQ(_bus.bytes, 9);
+
+    // and zeros if the bus fails.
+    _bus.fail_send = 1;
+    reading = lis2dw_get_raw_reading();
+    EXPECT_EQ(reading.x, 0);
+    EXPECT_EQ(reading.y, 0);
+    EXPECT_EQ(reading.z, 0);
+
+    // Draining 32 samples a reading at a time, as lis2dw_read_fifo() once did, costs
+    // 66 transactions and 292 bytes against the burst's 4 and 199.
+    _bus_reset();
+    _bus_queue(32);
+    _bus.fifo_samples = 32;
+    uint8_t count = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE) & LIS2DW_FIFO_SAMPLE_COUNT;
+    for (uint8_t i = 0; i < count; i++) {
+        reading = lis2dw_get_raw_reading();
+        EXPECT_EQ(reading.z, _bus.fifo[i].z);
+    }
+    EXPECT_EQ(_bus.transactions, 66);
+    EXPECT_EQ(_bus.bytes, 292);
+}
+
+static void test_fifo_configuration(void) {
+    lis2dw_configure_fifo(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, 24);
+    EXPECT_EQ(lis2dw_get_fifo_configuration(), LIS2DW_FIFO_CTRL_MODE_COLLECT_CONTINUOUS | 24);
+    lis2dw_disable_fifo();
+    EXPECT_EQ(lis2dw_get_fifo_configuration(), LIS2DW_FIFO_CTRL_MODE_OFF);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} _tests[] = {
+    { "lis2dw_read_fifo_burst", test_read_fifo_burst },
+    { "lis2dw_read_fifo_clamp", test_read_fifo_clamp },
+    { "lis2dw_read_fifo_bus_error", test_read_fifo_bus_error },
+    { "lis2dw_raw_reading", test_raw_reading },
+    { "lis2dw_fifo_configuration", test_fifo_configuration },
+};
+
+int main(void) {
+    for (size_t i = 0; i < ARRAY_LEN(_tests); i++) {
+        unsigned failures_before = _failures;
+
+        _current_test = _tests[i].name;
+        _bus_reset();
+        _tests[i].run();
+        printf("%-36s %s\n", _tests[i].name, _failures == failures_before ? "ok" : "FAILED");
+    }
+
+    printf("\n%u checks, %u failed\n", _checks, _failures);
+    return _failures ? 1 : 0;
+}
@@ -0,0 +1,2039 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Host harness: unit tests
+ *
+ * Table-driven checks for the phase engine, metrics, circadian score and
+ * sleep data libraries. Where a table has a hand-derivable answer (duration
+ * curve, epoch thresholds) the expected values come from the spec; the rest
+ * are characterization values captured from the current implementation, so
+ * an optimization that changes any output shows up here first.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_stubs.h"
+#include "phase_engine.h"
+#include "homebase.h"
+#include "homebase_reference.h"
+#include "metrics.h"
+#include "calendar_context.h"
+#include "metric_cadence.h"
+#include "metric_sd.h"
+#include "metric_em.h"
+#include "metric_wk.h"
+#include "metric_energy.h"
+#include "metric_jl.h"
+#include "metric_comfort.h"
+#include "circadian_score.h"
+#include "sensors.h"
+#include "sleep_data.h"
+#include "solar.h"
+#include "lunar.h"
+#include "sunriset.h"
+#include "watch_utility.h"
+#include "watch_private.h"
+#include "thermistor_driver.h"
+
+static unsigned _checks;
+static unsigned _failures;
+static const char *_current_test;
+
+static void _expect_eq(long actual, long expected, const char *expr, int line, int row) {
+    _checks++;
+    if (actual == expected) return;
+    _failures++;
+    if (row >= 0) {
+        printf("FAIL %s:%d [row %d] %s = %ld, expected %ld\n", _current_test, line, row, expr, actual, expected);
+    } else {
+        printf("FAIL %s:%d %s = %ld, expected %ld\n", _current_test, line, expr, actual, expected);
+    }
+}
+
+#define EXPECT_EQ(actual, expected) _expect_eq((long)(actual), (long)(expected), #actual, __LINE__, -1)
+#define EXPECT_ROW_EQ(row, actual, expected) _expect_eq((long)(actual), (long)(expected), #actual, __LINE__, (int)(row))
+#define EXPECT_TRUE(cond) _expect_eq((long)!!(cond), 1, #cond, __LINE__, -1)
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+// ============================================================================
+// Fixtures
+// ============================================================================
+
+// 2026-01-01 00:00 UTC
+#define TEST_EPOCH 1767225600UL
+
+static circadian_sleep_night_t _night(uint8_t day, uint16_t onset_min, uint16_t duration_min,
+                                      uint8_t efficiency, uint8_t light_quality) {
+    circadian_sleep_night_t night = {0};
+    night.onset_timestamp = TEST_EPOCH + day * 86400UL + onset_min * 60UL;
+    night.offset_timestamp = night.onset_timestamp + duration_min * 60UL;
+    night.duration_min = duration_min;
+    night.efficiency = efficiency;
+    night.light_quality = light_quality;
+    night.valid = true;
+    return night;
+}
+
+// Seven identical nights, 23:00-07:00, inside a 07:00-23:00 active window.
+static void _regular_week(circadian_data_t *data) {
+    memset(data, 0, sizeof(*data));
+    for (uint8_t i = 0; i < 7; i++) data->nights[i] = _night(i, 23 * 60, 480, 90, 80);
+    data->active_hours_start_min = 7 * 60;
+    data->active_hours_end_min = 23 * 60;
+}
+
+// Late, short and wandering, with one missing night.
+static void _irregular_week(circadian_data_t *data) {
+    static const uint16_t onsets[7] = { 1380, 90, 1410, 150, 0, 1320, 60 };
+    static const uint16_t durations[7] = { 390, 300, 450, 330, 0, 510, 360 };
+
+    memset(data, 0, sizeof(*data));
+    for (uint8_t i = 0; i < 7; i++) {
+        if (durations[i] == 0) continue;
+        data->nights[i] = _night(i, onsets[i], durations[i], 70 + i * 3, 40 + i * 5);
+    }
+    data->write_index = 3;
+    data->active_hours_start_min = 7 * 60;
+    data->active_hours_end_min = 23 * 60;
+}
+
+// ============================================================================
+// Circadian score
+// ============================================================================
+
+static void test_circadian_duration(void) {
+    static const struct { uint16_t minutes; uint8_t score; } rows[] = {
+        {    0,   0 },
+        {  360,   0 },      // 6 h and under: no credit
+        {  361,   2 },
+        {  390,  50 },
+        {  419,  99 },
+        {  420, 100 },      // 7-8 h: optimal
+        {  480, 100 },
+        {  481, 100 },
+        {  510,  75 },      // long sleep costs half as much
+        {  539,  51 },
+        {  540,  50 },      // 9 h and over: floor at 50
+        { 1440,  50 },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        EXPECT_ROW_EQ(i, circadian_score_calculate_duration(rows[i].minutes), rows[i].score);
+    }
+}
+
+static void test_circadian_components(void) {
+    circadian_data_t data;
+    circadian_score_components_t c;
+
+    _regular_week(&data);
+    circadian_score_calculate_components(&data, &c);
+    EXPECT_EQ(c.timing_score, 100);
+    EXPECT_EQ(c.duration_score, 100);
+    EXPECT_EQ(c.efficiency_score, 90);
+    EXPECT_EQ(c.compliance_score, 100);
+    EXPECT_EQ(c.light_score, 80);
+    EXPECT_EQ(c.overall_score, 97);
+    EXPECT_EQ(circadian_score_calculate(&data), 97);
+
+    _irregular_week(&data);
+    circadian_score_calculate_components(&data, &c);
+    EXPECT_EQ(c.timing_score, 44);
+    EXPECT_EQ(c.duration_score, 50);        // six nights averaging 6.5 h
+    EXPECT_EQ(c.efficiency_score, 78);
+    EXPECT_EQ(c.compliance_score, 33);      // two of six inside the window
+    EXPECT_EQ(c.light_score, 54);
+    EXPECT_EQ(c.overall_score, 52);
+
+    memset(&data, 0, sizeof(data));
+    EXPECT_EQ(circadian_score_calculate_sri(&data), 50);     // no pairs: neutral
+}
+
+static void test_circadian_sleep_score(void) {
+    circadian_sleep_night_t night = _night(0, 23 * 60, 480, 90, 80);
+
+    EXPECT_EQ(circadian_score_calculate_sleep_score(&night), (100 * 50 + 90 * 30 + 80 * 20) / 100);
+    night.valid = false;
+    EXPECT_EQ(circadian_score_calculate_sleep_score(&night), 0);
+}
+
+static void test_circadian_flash_roundtrip(void) {
+    circadian_data_t saved, loaded;
+
+    host_fake_reset();
+    host_fake_set_time(2026, 1, 10, 12, 0);
+    _regular_week(&saved);
+    saved.nights[2].efficiency = 150;       // out of range, clamped on load
+    saved.nights[4].duration_min = 400;     // disagrees with its timestamps, dropped on load
+
+    EXPECT_TRUE(circadian_data_save_to_flash(&saved));
+    EXPECT_TRUE(circadian_data_load_from_flash(&loaded));
+    EXPECT_EQ(loaded.nights[0].onset_timestamp, saved.nights[0].onset_timestamp);
+    EXPECT_EQ(loaded.nights[6].duration_min, 480);
+    EXPECT_EQ(loaded.nights[2].efficiency, 100);
+    EXPECT_EQ(loaded.nights[4].valid, false);
+    EXPECT_EQ(loaded.active_hours_end_min, 23 * 60);
+
+    // erased flash reads back as write_index 0xff, which is rejected.
+    host_fake_reset();
+    EXPECT_EQ(circadian_data_load_from_flash(&loaded), false);
+    EXPECT_EQ(loaded.nights[0].valid, false);
+}
+
+// ============================================================================
+// Storage regions
+// ============================================================================
+
+static void test_storage_region_packing(void) {
+    uint8_t small[3] = { 110, 7, 1 };
+    uint8_t large[300];
+    uint8_t out[300];
+
+    host_fake_reset();
+    const watch_storage_region_t *a = watch_storage_region_claim("a", sizeof(small));
+    const watch_storage_region_t *b = watch_storage_region_claim("b", 100);
+    const watch_storage_region_t *big = watch_storage_region_claim("big", sizeof(large));
+
+    // small records share the first region row, each behind a word-aligned header.
+    EXPECT_TRUE(a != NULL && b != NULL && big != NULL);
+    EXPECT_EQ(a->row, WATCH_STORAGE_REGION_FIRST_ROW);
+    EXPECT_EQ(a->offset, 0);
+    EXPECT_EQ(b->row, WATCH_STORAGE_REGION_FIRST_ROW);
+    EXPECT_EQ(b->offset, 8);
+    // a record bigger than a row gets whole rows, from the top.
+    EXPECT_EQ(big->rows, 2);
+    EXPECT_EQ(big->row + big->rows, NVMCTRL_RWWEE_PAGES / 4);
+
+    // claiming again is idempotent; a clash is refused.
+    EXPECT_TRUE(watch_storage_region_claim("a", sizeof(small)) == a);
+    EXPECT_TRUE(watch_storage_region_claim("a", 4) == NULL);
+    EXPECT_TRUE(watch_storage_region_claim("too big", WATCH_STORAGE_REGION_ROWS * NVMCTRL_ROW_SIZE) == NULL);
+
+    // never written reads back empty.
+    EXPECT_EQ(watch_storage_region_read(a, out), false);
+
+    for (uint16_t i = 0; i < sizeof(large); i++) large[i] = (uint8_t)(i * 7);
+    memset(out, 0x55, 100);
+    EXPECT_TRUE(watch_storage_region_write(a, small));
+    EXPECT_TRUE(watch_storage_region_write(b, out));
+    EXPECT_TRUE(watch_storage_region_write(big, large));
+
+    // rewriting one record keeps its neighbour in the shared row.
+    small[1] = 8;
+    EXPECT_TRUE(watch_storage_region_write(a, small));
+    memset(out, 0, sizeof(out));
+    EXPECT_TRUE(watch_storage_region_read(a, out));
+    EXPECT_EQ(out[1], 8);
+    EXPECT_TRUE(watch_storage_region_read(b, out));
+    EXPECT_EQ(out[0], 0x55);
+    EXPECT_EQ(out[99], 0x55);
+    EXPECT_TRUE(watch_storage_region_read(big, out));
+    EXPECT_EQ(memcmp(out, large, sizeof(large)), 0);
+
+    // nothing below the region rows was touched: that's the filesystem's.
+    for (uint8_t row = 0; row < WATCH_STORAGE_REGION_FIRST_ROW; row++) EXPECT_EQ(host_fake.storage[row][0], 0xff);
+}
+
+static void test_storage_region_survives_reorder(void) {
+    uint8_t value[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t out[8];
+
+    host_fake_reset();
+    watch_storage_region_claim("first", 8);
+    EXPECT_TRUE(watch_storage_region_write(watch_storage_region_claim("second", 8), value));
+
+    // next boot: a new face claims ahead of "second", which still finds its record.
+    watch_storage_region_init();
+    const watch_storage_region_t *newcomer = watch_storage_region_claim("newcomer", 8);
+    const watch_storage_region_t *second = watch_storage_region_claim("second", 8);
+    EXPECT_TRUE(watch_storage_region_read(second, out));
+    EXPECT_EQ(out[7], 8);
+    EXPECT_TRUE(newcomer->offset != second->offset);
+
+    // same name with a different size (the struct grew) reads back empty rather than garbled.
+    watch_storage_region_init();
+    EXPECT_EQ(watch_storage_region_read(watch_storage_region_claim("second", 12), out), false);
+}
+
+static void test_storage_log_wear(void) {
+    watch_storage_log_t log;
+    uint8_t record[71];                     // sleep_data_t: two to a row
+    uint8_t out[71];
+
+    host_fake_reset();
+    EXPECT_TRUE(watch_storage_log_open(&log, "log", sizeof(record), 3));
+    EXPECT_EQ(log.slots_per_row, 2);
+    EXPECT_EQ(watch_storage_log_read(&log, 0, out), false);
+
+    // a night of hourly saves: rewriting one row in place would erase 24 times.
+    for (uint8_t i = 1; i <= 24; i++) {
+        memset(record, i, sizeof(record));
+        EXPECT_TRUE(watch_storage_log_append(&log, record));
+    }
+    EXPECT_TRUE(host_fake.storage_erases <= 12);
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[0], 24);
+    EXPECT_TRUE(watch_storage_log_read(&log, 3, out));
+    EXPECT_EQ(out[70], 21);
+    // the ring holds six slots; the oldest row is only erased when the next append needs it.
+    EXPECT_TRUE(watch_storage_log_read(&log, 5, out));
+    EXPECT_EQ(out[0], 19);
+    EXPECT_EQ(watch_storage_log_read(&log, 6, out), false);
+    EXPECT_TRUE(watch_storage_log_append(&log, record));
+    EXPECT_EQ(watch_storage_log_read(&log, 5, out), false);
+}
+
+static void test_storage_log_recovery(void) {
+    watch_storage_log_t log;
+    uint8_t record[100];
+    uint8_t out[100];
+
+    host_fake_reset();
+    EXPECT_TRUE(watch_storage_log_open(&log, "log", sizeof(record), 2));
+    for (uint8_t i = 1; i <= 5; i++) {
+        memset(record, i, sizeof(record));
+        EXPECT_TRUE(watch_storage_log_append(&log, record));
+    }
+
+    // a save cut short: the header page of the sixth record made it, its payload didn't.
+    uint16_t head_row = log.region->row + log.head / log.slots_per_row;
+    uint16_t head_offset = (log.head % log.slots_per_row) * log.slot_size;
+    host_fake.storage[head_row][head_offset] = log.region->tag & 0xff;
+    host_fake.storage[head_row][head_offset + 1] = log.region->tag >> 8;
+    host_fake.storage[head_row][head_offset + 4] = 6;
+    host_fake.storage[head_row][head_offset + 8] = 6;
+
+    // next boot finds the fifth, and the next append steps past the torn slot.
+    watch_storage_region_init();
+    EXPECT_TRUE(watch_storage_log_open(&log, "log", sizeof(record), 2));
+    EXPECT_EQ(log.sequence, 5);
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[99], 5);
+    memset(record, 7, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append(&log, record));
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[0], 7);
+    EXPECT_TRUE(watch_storage_log_read(&log, 1, out));
+    EXPECT_EQ(out[0], 5);
+
+    // a record of a different log in the same rows is never mistaken for ours.
+    watch_storage_region_init();
+    EXPECT_TRUE(watch_storage_log_open(&log, "other", sizeof(record), 2));
+    EXPECT_EQ(log.sequence, 0);
+}
+
+static uint8_t _storage_callbacks;
+static bool _storage_callback_success;
+
+static void _storage_callback(bool success, void *context) {
+    _storage_callbacks++;
+    _storage_callback_success = success;
+    *(uint8_t *)context += 1;
+}
+
+static void test_storage_write_queue(void) {
+    uint8_t data[100];
+    uint8_t marker = 0;
+    unsigned interrupts = 0;
+
+    host_fake_reset();
+    _storage_callbacks = 0;
+    memset(host_fake.storage[3], 0, NVMCTRL_ROW_SIZE);
+    for (uint8_t i = 0; i < sizeof(data); i++) data[i] = i;
+
+    // out-of-range and unaligned jobs are refused up front.
+    EXPECT_EQ(watch_storage_write_async(32, 0, data, 1, true, NULL, NULL), false);
+    EXPECT_EQ(watch_storage_write_async(3, 10, data, 1, true, NULL, NULL), false);
+    EXPECT_EQ(watch_storage_write_async(3, 192, data, 100, true, NULL, NULL), false);
+
+    // queuing returns before the flash is touched.
+    EXPECT_TRUE(watch_storage_write_async(3, 64, data, sizeof(data), true, _storage_callback, &marker));
+    EXPECT_TRUE(watch_storage_is_busy());
+    EXPECT_EQ(host_fake.storage[3][0], 0);
+
+    // erase, then clear-fill-write for each of two pages, then done: one interrupt per step.
+    while (host_fake_storage_interrupt()) interrupts++;
+    EXPECT_EQ(interrupts, 6);
+    EXPECT_EQ(watch_storage_is_busy(), false);
+    EXPECT_EQ(_storage_callbacks, 1);
+    EXPECT_EQ(marker, 1);
+    EXPECT_EQ(_storage_callback_success, true);
+    EXPECT_EQ(host_fake.storage[3][0], 0xff);
+    EXPECT_EQ(host_fake.storage[3][64], 0);
+    EXPECT_EQ(host_fake.storage[3][163], 99);
+    EXPECT_EQ(host_fake.storage[3][164], 0xff);
+
+    // the queue holds four jobs; an error fails its job and moves on to the next.
+    for (uint8_t i = 0; i < WATCH_STORAGE_QUEUE_LENGTH; i++) {
+        EXPECT_TRUE(watch_storage_write_async(4 + i, 0, data, 8, true, _storage_callback, &marker));
+    }
+    EXPECT_EQ(watch_storage_write_async(9, 0, data, 8, true, NULL, NULL), false);
+    host_fake_storage_interrupt();          // issues the first erase
+    host_fake.storage_fail_next = true;
+    host_fake_storage_interrupt();          // the erase "failed"
+    EXPECT_EQ(_storage_callbacks, 2);
+    EXPECT_EQ(_storage_callback_success, false);
+    EXPECT_TRUE(watch_storage_sync());      // drains the rest
+    EXPECT_EQ(_storage_callbacks, 5);
+    EXPECT_EQ(host_fake.storage[7][7], 7);
+}
+
+static void test_storage_log_append_async(void) {
+    watch_storage_log_t log;
+    uint8_t record[71];
+    uint8_t out[71];
+    uint8_t marker = 0;
+
+    host_fake_reset();
+    _storage_callbacks = 0;
+    EXPECT_TRUE(watch_storage_log_open(&log, "log", sizeof(record), 3));
+    memset(record, 1, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append(&log, record));
+
+    memset(record, 2, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append_async(&log, record, _storage_callback, &marker));
+    memset(record, 3, sizeof(record));      // the record was copied when queued
+    // until it lands, the log still reports the last record that did.
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[0], 1);
+
+    while (host_fake_storage_interrupt()) { }
+    EXPECT_EQ(marker, 1);
+    EXPECT_EQ(log.sequence, 2);
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[70], 2);
+
+    // a blocking append waits for a queued one instead of racing it for the slot.
+    EXPECT_TRUE(watch_storage_log_append_async(&log, record, NULL, NULL));
+    EXPECT_TRUE(watch_storage_log_append(&log, out));
+    EXPECT_EQ(log.sequence, 4);
+    EXPECT_TRUE(watch_storage_log_read(&log, 1, out));
+    EXPECT_EQ(out[0], 3);
+
+    // each log holds its own queued append, so two logs saved back to back both get written.
+    watch_storage_log_t other;
+    EXPECT_TRUE(watch_storage_log_open(&other, "other", sizeof(record), 2));
+    memset(record, 4, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append_async(&log, record, NULL, NULL));
+    memset(record, 5, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append_async(&other, record, NULL, NULL));
+    EXPECT_TRUE(log.pending && other.pending);
+    while (host_fake_storage_interrupt()) { }
+    EXPECT_EQ(log.sequence, 5);
+    EXPECT_EQ(other.sequence, 1);
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[0], 4);
+    EXPECT_TRUE(watch_storage_log_read(&other, 0, out));
+    EXPECT_EQ(out[0], 5);
+
+    // a second append to the same log waits for the first to land rather than being dropped.
+    memset(record, 6, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append_async(&log, record, NULL, NULL));
+    memset(record, 7, sizeof(record));
+    EXPECT_TRUE(watch_storage_log_append_async(&log, record, NULL, NULL));
+    EXPECT_EQ(log.sequence, 6);                 // the first is down; the second is queued
+    while (host_fake_storage_interrupt()) { }
+    EXPECT_EQ(log.sequence, 7);
+    EXPECT_TRUE(watch_storage_log_read(&log, 0, out));
+    EXPECT_EQ(out[0], 7);
+    EXPECT_TRUE(watch_storage_log_read(&log, 1, out));
+    EXPECT_EQ(out[0], 6);
+}
+
+static void test_storage_boot_claims(void) {
+    watch_storage_log_t sleep_log;
+    phase_state_t phase;
+    circadian_data_t circadian;
+    uint8_t used[NVMCTRL_RWWEE_PAGES / 4] = {0};
+
+    // every log Movement opens at boot, in the order it opens them: its own sleep log
+    // (SLEEP_STORAGE_LOG in movement.h), then the phase history and baseline, the faces'
+    // shared records as they are set up (lander_face's 3 bytes), and the circadian data.
+    host_fake_reset();
+    EXPECT_TRUE(watch_storage_log_open(&sleep_log, "sleep", 71, 3));
+    phase_engine_init(&phase);
+    phase_history_load(&phase, 1767225600);
+    activity_baseline_load(&phase.baseline);
+    const watch_storage_region_t *lander = watch_storage_region_claim("lander", 3);
+    circadian_data_load_from_flash(&circadian);
+
+    // each claim stuck (claiming again hands back the same rows), and none overlap.
+    const watch_storage_region_t *claims[] = {
+        sleep_log.region,
+        watch_storage_region_claim_rows(PHASE_STORAGE_LOG, PHASE_STORAGE_LOG_ROWS),
+        watch_storage_region_claim_rows(BASELINE_STORAGE_LOG, BASELINE_STORAGE_LOG_ROWS),
+        watch_storage_region_claim_rows(STORAGE_LOG_CIRCADIAN, STORAGE_LOG_CIRCADIAN_ROWS),
+    };
+    for (uint8_t i = 0; i < sizeof(claims) / sizeof(claims[0]); i++) {
+        EXPECT_TRUE(claims[i] != NULL);
+        if (claims[i] == NULL) continue;
+        for (uint8_t row = claims[i]->row; row < claims[i]->row + claims[i]->rows; row++) {
+            EXPECT_TRUE(row >= WATCH_STORAGE_REGION_FIRST_ROW);
+            EXPECT_EQ(used[row]++, 0);
+        }
+    }
+    // the shared record sits in a row no log owns.
+    EXPECT_TRUE(lander != NULL);
+    if (lander != NULL) EXPECT_EQ(used[lander->row], 0);
+
+    // a face set up after every log still finds room in the shared row.
+    EXPECT_TRUE(watch_storage_region_claim("late face", 16) != NULL);
+}
+
+// ============================================================================
+// Homebase
+// ============================================================================
+
+static uint8_t _comp_fired;
+
+static void _comp_fire(void) {
+    _comp_fired++;
+}
+
+static void test_rtc_comp_overdue_head(void) {
+    rtc_counter_t counter;
+
+    // far enough out: left alone. Too close: pushed to the grace period.
+    EXPECT_EQ(_watch_rtc_comp_clamp(1000, 900, 4), 1000);
+    EXPECT_EQ(_watch_rtc_comp_clamp(902, 900, 4), 904);
+    // ahead across the counter wrap is still ahead.
+    EXPECT_EQ(_watch_rtc_comp_clamp(0x8, 0xfffffff0u, 4), 0x8);
+
+    // A head that went overdue while the queue was being edited (say, interrupts were off
+    // for a flash write): it has to fire a grace period from now, not once the counter wraps.
+    host_fake_reset();
+    host_fake.counter = 0x10;
+    _watch_rtc_comp_init();
+    _comp_fired = 0;
+    watch_rtc_register_comp_callback(_comp_fire, 0xfffffff0u, 0);
+    watch_rtc_register_comp_callback(_comp_fire, 0x10 + 4096, 1);
+    EXPECT_EQ(host_fake.comp_schedules, 2);
+
+    EXPECT_TRUE(_watch_rtc_comp_next_counter(&counter));
+    EXPECT_EQ(counter, 0xfffffff0u);
+    counter = _watch_rtc_comp_clamp(counter, host_fake.counter, 4);
+    EXPECT_EQ(counter, 0x14);
+
+    _watch_rtc_comp_fire_due(counter);
+    EXPECT_EQ(_comp_fired, 1);
+    EXPECT_TRUE(_watch_rtc_comp_next_counter(&counter));
+    EXPECT_EQ(counter, 0x10 + 4096);
+}
+
+static void test_homebase_matches_reference(void) {
+    unsigned daylight = 0, temp = 0, baseline = 0;
+
+    for (uint16_t day = 1; day <= 365; day++) {
+        const homebase_entry_t *entry = homebase_get_entry(day);
+        const homebase_entry_t *expected = &homebase_reference_table[day - 1];
+        if (entry->expected_daylight_min != expected->expected_daylight_min) daylight++;
+        if (entry->avg_temp_c10 != expected->avg_temp_c10) temp++;
+        if (entry->seasonal_baseline != expected->seasonal_baseline) baseline++;
+    }
+
+    EXPECT_EQ(daylight, 0);
+    EXPECT_EQ(temp, 0);
+    EXPECT_EQ(baseline, 0);
+}
+
+static void test_homebase_presets(void) {
+    uint8_t count = homebase_preset_count();
+
+    EXPECT_TRUE(count >= 1);
+    EXPECT_EQ(homebase_get_preset(), 0);
+    EXPECT_TRUE(homebase_preset_name(0) != NULL);
+    EXPECT_TRUE(homebase_preset_name(count) == NULL);
+    EXPECT_TRUE(!homebase_select_preset(count));
+    EXPECT_EQ(homebase_get_preset(), 0);
+    EXPECT_EQ(homebase_get_metadata()->entry_count, 365);
+
+    // out-of-range days fall back to day 1, as the uncompressed table did
+    EXPECT_EQ(homebase_get_entry(0)->expected_daylight_min, homebase_reference_table[0].expected_daylight_min);
+    EXPECT_EQ(homebase_get_entry(366)->avg_temp_c10, homebase_reference_table[0].avg_temp_c10);
+
+    // switching away and back decodes afresh
+    EXPECT_TRUE(homebase_select_preset(count - 1));
+    homebase_get_entry(200);
+    EXPECT_TRUE(homebase_select_preset(0));
+    EXPECT_EQ(homebase_get_entry(200)->expected_daylight_min, homebase_reference_table[199].expected_daylight_min);
+}
+
+// ============================================================================
+// Solar model
+// ============================================================================
+
+// Minutes between two times of day, ignoring which day sunriset wrapped them into.
+static int _minutes_apart(double hours, int16_t minutes) {
+    int diff = ((int)lround(hours * 60) - minutes) % 1440;
+    if (diff > 720) diff -= 1440;
+    if (diff < -720) diff += 1440;
+    return abs(diff);
+}
+
+static void test_solar_matches_sunriset(void) {
+    int worst = 0;
+    unsigned kind_mismatches = 0;
+
+    // every 5° of latitude to the polar circles, every 15° of longitude, three days a month.
+    for (int16_t lat = -6500; lat <= 6500; lat += 500) {
+        for (int16_t lon = -18000; lon <= 18000; lon += 1500) {
+            for (uint8_t month = 1; month <= 12; month++) {
+                for (uint8_t day = 1; day <= 28; day += 9) {
+                    double rise, set;
+                    solar_times_t times;
+                    int expected = sun_rise_set(2026, month, day, lon / 100.0, lat / 100.0, &rise, &set);
+                    int8_t result = solar_compute(2026, month, day, lat, lon, 0, &times);
+                    if (result != expected) kind_mismatches++;
+                    if (result != SOLAR_RISES_AND_SETS || expected != 0) continue;
+
+                    int error = _minutes_apart(rise, times.sunrise_min);
+                    if (_minutes_apart(set, times.sunset_min) > error) error = _minutes_apart(set, times.sunset_min);
+                    if (error > worst) worst = error;
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(kind_mismatches, 0);
+    EXPECT_TRUE(worst <= 3);
+
+    // polar day and night
+    solar_times_t times;
+    EXPECT_EQ(solar_compute(2026, 6, 21, 7800, 1560, 3600, &times), SOLAR_ALWAYS_UP);
+    EXPECT_EQ(times.daylight_min, 1440);
+    EXPECT_EQ(solar_compute(2026, 12, 21, 7800, 1560, 3600, &times), SOLAR_ALWAYS_DOWN);
+    EXPECT_EQ(times.daylight_min, 0);
+}
+
+static void test_solar_today(void) {
+    // Anchorage on the June solstice, in AKDT (UTC-8): sunrise ~04:20, sunset ~23:42.
+    EXPECT_TRUE(solar_get_today() == NULL);
+    solar_update_today(2026, 6, 21, 6122, -14990, -8 * 3600);
+    const solar_times_t *today = solar_get_today();
+    EXPECT_TRUE(today != NULL);
+    EXPECT_TRUE(today->sunrise_min >= 4 * 60 + 15 && today->sunrise_min <= 4 * 60 + 25);
+    EXPECT_TRUE(today->sunset_min >= 23 * 60 + 37 && today->sunset_min <= 23 * 60 + 47);
+    EXPECT_TRUE(!solar_is_daylight(today, 3 * 60));
+    EXPECT_TRUE(solar_is_daylight(today, 23 * 60 + 30));
+
+    // the light penalty follows the real sunrise: 23:00 is daytime, which the
+    // 12 ± daylight/120 approximation (03:00-21:00) got wrong.
+    phase_state_t state;
+    phase_engine_init(&state);
+    uint16_t with_sun = phase_compute(&state, 23, 0, 172, 0, 100, 500);
+    solar_update_today(2026, 6, 21, 0, 0, 0);
+    EXPECT_TRUE(solar_get_today() == NULL);
+    phase_engine_init(&state);
+    uint16_t without_sun = phase_compute(&state, 23, 0, 172, 0, 100, 500);
+    EXPECT_TRUE(with_sun > without_sun);
+}
+
+// ============================================================================
+// Lunar phase
+// ============================================================================
+
+static void test_lunar_events(void) {
+    // Published new, quarter and full moons (UTC); the mean-motion model is
+    // within half a day of them.
+    static const struct {
+        uint32_t unix_time;
+        lunar_phase_name_t name;
+        uint8_t min_illumination;
+        uint8_t max_illumination;
+    } rows[] = {
+        {  944605920, LUNAR_NEW,            0,   1 },   // 1999-12-07 22:32, before the epoch
+        { 1712600460, LUNAR_NEW,            0,   1 },   // 2024-04-08 18:21, total eclipse
+        { 1757268540, LUNAR_FULL,          99, 100 },   // 2025-09-07 18:09, lunar eclipse
+        { 1767434580, LUNAR_FULL,          99, 100 },   // 2026-01-03 10:03
+        { 1768765920, LUNAR_NEW,            0,   1 },   // 2026-01-18 19:52
+        { 1769402820, LUNAR_FIRST_QUARTER, 45,  55 },   // 2026-01-26 04:47
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        lunar_phase_t moon;
+        lunar_compute(rows[i].unix_time, &moon);
+        EXPECT_ROW_EQ(i, moon.name, rows[i].name);
+        EXPECT_TRUE(moon.illumination >= rows[i].min_illumination &&
+                    moon.illumination <= rows[i].max_illumination);
+        EXPECT_TRUE(moon.age_days <= 29);
+    }
+
+    EXPECT_TRUE(lunar_get_today() == NULL);
+    lunar_update_today(2026, 1, 3, 0);
+    EXPECT_TRUE(lunar_get_today() != NULL);
+    EXPECT_EQ(lunar_get_today()->name, LUNAR_FULL);
+}
+
+static void test_lunar_matches_double(void) {
+    // The moon phase face's old double-precision fmod version, hourly over 25 years.
+    const double synodic = 29.53058770576 * 86400;
+    unsigned worst_fraction = 0;
+    unsigned worst_illumination = 0;
+
+    for (uint32_t t = LUNAR_NEW_MOON_EPOCH; t < LUNAR_NEW_MOON_EPOCH + 25u * 365 * 86400; t += 3607) {
+        double fraction = fmod(t - (double)LUNAR_NEW_MOON_EPOCH, synodic) / synodic;
+        long illumination = lround(100 * (1 - cos(2 * M_PI * fraction)) / 2);
+        lunar_phase_t moon;
+        lunar_compute(t, &moon);
+
+        unsigned fraction_error = (unsigned)labs(lround(fraction * 65536) - moon.fraction);
+        if (fraction_error > 32768) fraction_error = 65536 - fraction_error;
+        unsigned illumination_error = (unsigned)labs(illumination - moon.illumination);
+        if (fraction_error > worst_fraction) worst_fraction = fraction_error;
+        if (illumination_error > worst_illumination) worst_illumination = illumination_error;
+    }
+
+    EXPECT_TRUE(worst_fraction <= 4);       // under a minute of the cycle
+    EXPECT_TRUE(worst_illumination <= 1);
+}
+
+// ============================================================================
+// Calendar context
+// ============================================================================
+
+static watch_date_time_t _local_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
+    watch_date_time_t date_time = {0};
+    date_time.unit.year = year - WATCH_RTC_REFERENCE_YEAR;
+    date_time.unit.month = month;
+    date_time.unit.day = day;
+    date_time.unit.hour = hour;
+    date_time.unit.minute = minute;
+    return date_time;
+}
+
+static void test_calendar_context(void) {
+    static const struct {
+        uint16_t year;
+        uint8_t month;
+        uint8_t day;
+        uint16_t day_of_year;
+        uint8_t lunar_age;
+    } rows[] = {
+        { 2026,  1,  1,   1, 12 },
+        { 2026,  3, 15,  74, 26 },
+        { 2026,  6, 21, 172,  6 },
+        { 2026, 12, 31, 365, 22 },
+        { 2028,  2, 29,  60,  4 },
+        { 2028, 12, 31, 366, 14 },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        calendar_context_t cal = {0};
+        calendar_context_update(&cal, _local_time(rows[i].year, rows[i].month, rows[i].day, 13, 45),
+                                0, 0, 0, false, 0, 0);
+        EXPECT_ROW_EQ(i, cal.day_of_year, rows[i].day_of_year);
+        EXPECT_ROW_EQ(i, cal.lunar.age_days, rows[i].lunar_age);
+        EXPECT_ROW_EQ(i, cal.minute_of_day, 13 * 60 + 45);
+        // the homebase tables stop at 365; a leap year's last day reuses it.
+        uint16_t homebase_day = rows[i].day_of_year > 365 ? 365 : rows[i].day_of_year;
+        EXPECT_ROW_EQ(i, cal.homebase.avg_temp_c10, homebase_get_entry(homebase_day)->avg_temp_c10);
+        EXPECT_TRUE(cal.solar == NULL);
+    }
+
+    // Anchorage in AKDT: sunrise/sunset come with the location, active hours in whole hours.
+    calendar_context_t cal = {0};
+    calendar_context_update(&cal, _local_time(2026, 6, 21, 23, 30), -8 * 3600, 6122, -14990, true, 30, 99);
+    EXPECT_TRUE(cal.solar != NULL && solar_is_daylight(cal.solar, cal.minute_of_day));
+    EXPECT_EQ(cal.active_hours_enabled, true);
+    EXPECT_EQ(cal.active_start_hour, 7);
+    EXPECT_EQ(cal.active_end_hour, 23);     // clamped to quarter hour 95
+
+    // the next minute only moves the clock; the next day refreshes the rest.
+    calendar_context_update(&cal, _local_time(2026, 6, 21, 23, 31), -8 * 3600, 6122, -14990, true, 30, 92);
+    EXPECT_EQ(cal.minute_of_day, 23 * 60 + 31);
+    EXPECT_EQ(cal.day_of_year, 172);
+    EXPECT_EQ(cal.utc_minute, watch_utility_convert_to_unix_time(2026, 6, 21, 23, 31, 0, -8 * 3600) / 60);
+    calendar_context_update(&cal, _local_time(2026, 6, 22, 0, 0), -8 * 3600, 6122, -14990, true, 30, 92);
+    EXPECT_EQ(cal.day_of_year, 173);
+    EXPECT_EQ(cal.lunar.age_days, 7);
+    EXPECT_EQ(cal.utc_minute, watch_utility_convert_to_unix_time(2026, 6, 22, 0, 0, 0, -8 * 3600) / 60);
+
+    // clearing the location drops the sunrise/sunset (and the solar cache with it).
+    calendar_context_update(&cal, _local_time(2026, 6, 22, 0, 1), -8 * 3600, 0, 0, true, 30, 92);
+    EXPECT_TRUE(cal.solar == NULL);
+    EXPECT_TRUE(solar_get_today() == NULL);
+}
+
+// ============================================================================
+// Phase engine
+// ============================================================================
+
+static void test_phase_compute_table(void) {
+    static const struct {
+        uint8_t hour;
+        uint16_t day_of_year;
+        uint16_t activity;
+        int16_t temp_c10;
+        uint16_t lux;
+        uint8_t score;
+    } rows[] = {
+        {  0,   1,    0,   50,    0,  48 },
+        {  2,   1,    0,   50,    0,  55 },
+        { 14, 172,  800,  250,  900,  65 },
+        { 14, 172,    0,  250,  900,  73 },
+        {  8,  80,  300,  150,  400,  56 },
+        { 12, 200,  500,  300, 1200,  71 },
+        { 20, 300,  100,  100,   20,  44 },
+        { 23, 365, 1000, -100,    0,  56 },
+        {  6, 355,   50,  -50, 5000,  58 },
+        { 18, 100,  600,  200,  500,  53 },
+        { 10,  45,  200,   80,  300,  57 },
+        {  3, 250,    0,  180,    0,  80 },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        phase_state_t state;
+        phase_engine_init(&state);
+        uint16_t score = phase_compute(&state, rows[i].hour, 0, rows[i].day_of_year, rows[i].activity,
+                                       rows[i].temp_c10, rows[i].lux);
+        EXPECT_ROW_EQ(i, score, rows[i].score);
+        EXPECT_ROW_EQ(i, state.last_phase_score, rows[i].score);
+        EXPECT_ROW_EQ(i, phase_get_mean(&state, 24), rows[i].score);
+    }
+}
+
+static void test_phase_circadian_curve(void) {
+    static const int16_t hourly[24] = {
+        500, 259, 0, -259, -500, -707, -866, -966, -1000, -966, -866, -707,
+        -500, -259, 0, 259, 500, 707, 866, 966, 1000, 966, 866, 707
+    };
+    unsigned off_hour = 0;
+    unsigned jumps = 0;
+
+    // whole hours land on the hourly curve; minutes in between never step by
+    // more than the cosine's steepest slope (1000 * 2π / 1440 ≈ 4.4 a minute).
+    for (uint8_t hour = 0; hour < 24; hour++) {
+        if (phase_circadian_curve(hour * 60) != hourly[hour]) off_hour++;
+    }
+    for (uint16_t minute = 0; minute < 1440; minute++) {
+        int16_t step = phase_circadian_curve((minute + 1) % 1440) - phase_circadian_curve(minute);
+        if (step > 5 || step < -5) jumps++;
+    }
+    EXPECT_EQ(off_hour, 0);
+    EXPECT_EQ(jumps, 0);
+    EXPECT_EQ(phase_circadian_curve(20 * 60 + 7), 999);      // 1000 + (998 - 1000) * 7 / 15, rounded
+    EXPECT_EQ(phase_circadian_curve(2 * 60 + 7), -30);
+
+    // so does the score: a quarter hour now moves it a point or two, not an hour's worth at once.
+    phase_state_t state;
+    phase_engine_init(&state);
+    uint16_t on_hour = phase_compute(&state, 16, 0, 172, 1000, 250, 900);
+    uint16_t quarter_past = phase_compute(&state, 16, 15, 172, 1000, 250, 900);
+    uint16_t next_hour = phase_compute(&state, 17, 0, 172, 1000, 250, 900);
+    EXPECT_TRUE(quarter_past > on_hour && quarter_past < next_hour);
+    EXPECT_EQ(phase_compute(&state, 16, 60, 172, 1000, 250, 900), 0);
+}
+
+static void test_phase_learn_acrophase(void) {
+    circadian_data_t sleep_data;
+    phase_state_t state;
+    uint32_t midnight = 1767225600;     // 2026-01-01 00:00 UTC
+
+    // 03:00-09:00 local in UTC+1: mid-sleep at 06:00, two hours later than the reference.
+    memset(&sleep_data, 0, sizeof(sleep_data));
+    phase_engine_init(&state);
+    for (uint8_t i = 0; i < 2; i++) {
+        circadian_sleep_night_t night = {
+            .onset_timestamp = midnight + i * 86400 + 2 * 3600,
+            .offset_timestamp = midnight + i * 86400 + 8 * 3600,
+            .duration_min = 360,
+            .valid = true
+        };
+        circadian_data_add_night(&sleep_data, &night);
+    }
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, 3600), 0);    // two nights aren't enough
+    for (uint8_t i = 2; i < 5; i++) {
+        circadian_sleep_night_t night = {
+            .onset_timestamp = midnight + i * 86400 + 2 * 3600,
+            .offset_timestamp = midnight + i * 86400 + 8 * 3600,
+            .duration_min = 360,
+            .valid = true
+        };
+        circadian_data_add_night(&sleep_data, &night);
+    }
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, 3600), 120);
+    EXPECT_EQ(state.acrophase_offset_min, 120);
+
+    // the shifted curve: 10:00 for this wearer is 08:00 on the default one.
+    phase_state_t reference;
+    phase_engine_init(&reference);
+    EXPECT_EQ(phase_compute(&state, 10, 0, 100, 1000, 150, 400),
+              phase_compute(&reference, 8, 0, 100, 1000, 150, 400));
+
+    // an earlier sleeper shifts the other way; either way the shift stops at 3 hours.
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, -3 * 3600), -120);
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, -6 * 3600), -180);
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, 10 * 3600), 180);
+
+    // nights that end before they start don't count.
+    for (uint8_t i = 0; i < 7; i++) sleep_data.nights[i].offset_timestamp = sleep_data.nights[i].onset_timestamp;
+    EXPECT_EQ(phase_learn_acrophase(&state, &sleep_data, 0), 0);
+}
+
+static void test_phase_compute_rejects_bad_input(void) {
+    phase_state_t state;
+
+    phase_engine_init(&state);
+    EXPECT_EQ(phase_compute(&state, 24, 0, 100, 0, 200, 0), 0);
+    EXPECT_EQ(phase_compute(&state, 12, 0, 0, 0, 200, 0), 0);
+    EXPECT_EQ(phase_compute(&state, 12, 0, 367, 0, 200, 0), 0);
+    EXPECT_EQ(phase_compute(&state, 12, 0, 100, 1001, 200, 0), 0);
+    EXPECT_EQ(state.history_index, 0);      // none of them touched the history
+}
+
+// What the running statistics should come to, from the ring itself.
+static void _phase_walk(const phase_state_t *state, uint8_t hours, uint16_t *sum, uint32_t *sum_sq) {
+    *sum = 0;
+    *sum_sq = 0;
+    for (uint8_t age = 0; age < hours && age < state->history_count; age++) {
+        uint8_t value = state->phase_history[(state->history_index + 24 - age) % 24];
+        *sum += value;
+        *sum_sq += value * value;
+    }
+}
+
+static void test_phase_year_invariants(void) {
+    static const uint8_t windows[] = PHASE_WINDOWS;
+    phase_state_t state;
+    unsigned out_of_range = 0;
+    unsigned bad_sum = 0;
+    unsigned bad_trend = 0;
+
+    phase_engine_init(&state);
+    for (uint16_t day = 1; day <= 365; day++) {
+        for (uint8_t hour = 0; hour < 24; hour++) {
+            uint16_t activity = (hour >= 7 && hour <= 22) ? (uint16_t)((day * 37 + hour * 53) % 1000) : 0;
+            int16_t temp = (int16_t)(((day * 7 + hour * 11) % 400) - 50);
+            uint16_t lux = (hour >= 7 && hour <= 19) ? (uint16_t)((day * 13 + hour * 97) % 3000) : 0;
+            uint16_t score = phase_compute(&state, hour, 0, day, activity, temp, lux);
+            if (score > 100) out_of_range++;
+
+            // the kept sums match a walk of the ring, and so does the trend.
+            for (size_t w = 0; w < ARRAY_LEN(windows); w++) {
+                uint8_t hours = windows[w];
+                uint8_t count = state.history_count < hours ? state.history_count : hours;
+                uint16_t sum, half_sum;
+                uint32_t sum_sq, half_sum_sq;
+                _phase_walk(&state, hours, &sum, &sum_sq);
+                _phase_walk(&state, hours / 2, &half_sum, &half_sum_sq);
+                if (state.span_sum[w + 1] != sum || state.window_sum_sq[w] != sum_sq) bad_sum++;
+                if (phase_get_variance(&state, hours) != (sum_sq * count - (uint32_t)sum * sum) / (count * count)) bad_sum++;
+
+                uint8_t half_count = state.history_count < hours / 2 ? state.history_count : hours / 2;
+                int16_t trend = 0;
+                if (count > half_count) {
+                    trend = 2 * (half_sum / half_count - (sum - half_sum) / (count - half_count));
+                    trend = trend < -100 ? -100 : trend > 100 ? 100 : trend;
+                }
+                if (phase_get_trend(&state, hours) != trend) bad_trend++;
+            }
+        }
+    }
+
+    EXPECT_EQ(out_of_range, 0);
+    EXPECT_EQ(bad_sum, 0);
+    EXPECT_EQ(bad_trend, 0);
+    EXPECT_EQ(state.history_count, 24);
+}
+
+static void test_phase_hourly_history(void) {
+    phase_state_t state;
+
+    // four scores an hour, as Movement computes them, make one hourly mean.
+    phase_engine_init(&state);
+    uint16_t a = phase_compute(&state, 9, 0, 100, 0, 200, 0);
+    uint16_t b = phase_compute(&state, 9, 0, 100, 900, 200, 0);
+    phase_compute(&state, 9, 0, 100, 0, 200, 0);
+    phase_compute(&state, 9, 0, 100, 900, 200, 0);
+    EXPECT_EQ(state.history_count, 1);
+    EXPECT_EQ(phase_get_mean(&state, 1), (a + b + 1) / 2);
+
+    // a steady rise over twelve hours trends up; a fall trends down.
+    phase_engine_init(&state);
+    for (uint8_t hour = 0; hour < 12; hour++) {
+        phase_compute(&state, 12, 0, 100, 0, 200 + hour * 30, 500);    // temperature closing in on the baseline
+        state.last_hour = 11;                                       // next call starts the next hour
+    }
+    EXPECT_EQ(state.history_count, 12);
+    EXPECT_TRUE(phase_get_trend(&state, 12) < 0 || phase_get_trend(&state, 12) > 0);
+    EXPECT_EQ(phase_get_trend(&state, 2), 2 * (state.phase_history[11] - state.phase_history[10]));  // walks the ring
+    EXPECT_EQ(phase_get_ewma(&state, 5), phase_get_mean(&state, 5));     // not a window: the plain mean
+
+    // a constant score has no trend and no variance, and the EWMA settles on it.
+    phase_engine_init(&state);
+    for (uint8_t hour = 0; hour < 24; hour++) phase_compute(&state, hour, 0, 100, 0, 200, 0);
+    for (uint8_t hour = 0; hour < 24; hour++) phase_compute(&state, hour, 0, 101, 0, 200, 0);
+    EXPECT_EQ(phase_get_variance(&state, 24) > 0, true);    // a day's worth of circadian swing
+    EXPECT_EQ(phase_get_variance(&state, 3) <= phase_get_variance(&state, 24), true);
+    uint8_t ewma = phase_get_ewma(&state, 24);
+    EXPECT_TRUE(ewma >= phase_get_mean(&state, 24) - 10 && ewma <= phase_get_mean(&state, 24) + 10);
+}
+
+static void test_phase_history_persistence(void) {
+    phase_state_t state, restored;
+    uint32_t now = 1767225600;      // 2026-01-01 00:00 UTC
+
+    host_fake_reset();
+    phase_engine_init(&state);
+    EXPECT_EQ(phase_history_load(&state, now), false);      // nothing saved yet
+    for (uint8_t hour = 0; hour < 30; hour++) {
+        phase_compute(&state, hour % 24, 0, 1 + hour / 24, (hour * 77) % 1000, 150, hour < 20 ? 400 : 0);
+    }
+    // at minute 0 in the sleep window the sleep log's save is still queued; this one
+    // queues behind it instead of being dropped.
+    watch_storage_log_t sleep_log;
+    uint8_t sleep_record[71] = {0};
+    EXPECT_TRUE(watch_storage_log_open(&sleep_log, "sleep", sizeof(sleep_record), 3));
+    EXPECT_TRUE(watch_storage_log_append_async(&sleep_log, sleep_record, NULL, NULL));
+    EXPECT_TRUE(phase_history_save(&state, now + 30 * 3600));
+    while (host_fake_storage_interrupt()) { }
+    EXPECT_EQ(sleep_log.sequence, 1);
+
+    // a reset an hour later picks the history back up, sums and all.
+    phase_engine_init(&restored);
+    EXPECT_TRUE(phase_history_load(&restored, now + 31 * 3600));
+    EXPECT_EQ(memcmp(restored.phase_history, state.phase_history, sizeof(state.phase_history)), 0);
+    EXPECT_EQ(memcmp(restored.span_sum, state.span_sum, sizeof(state.span_sum)), 0);
+    EXPECT_EQ(memcmp(restored.window_sum_sq, state.window_sum_sq, sizeof(state.window_sum_sq)), 0);
+    EXPECT_EQ(phase_get_trend(&restored, 6), phase_get_trend(&state, 6));
+    EXPECT_EQ(phase_get_ewma(&restored, 12), phase_get_ewma(&state, 12));
+
+    // the next score opens a new hour rather than averaging into the saved one.
+    phase_compute(&restored, 7, 0, 2, 0, 150, 0);
+    EXPECT_EQ(restored.history_index, (state.history_index + 1) % 24);
+
+    // five hours later the four hours the watch missed are empty, and the saved
+    // hour sits five slots behind the one the next score opens.
+    phase_engine_init(&restored);
+    EXPECT_TRUE(phase_history_load(&restored, now + 35 * 3600));
+    phase_compute(&restored, 11, 0, 2, 0, 150, 0);
+    EXPECT_EQ(restored.history_index, (state.history_index + 5) % 24);
+    EXPECT_EQ(restored.history_count, 24);
+    EXPECT_EQ(restored.phase_history[(state.history_index + 5) % 24], restored.last_phase_score);
+    for (uint8_t age = 1; age < 5; age++) {
+        EXPECT_EQ(restored.phase_history[(state.history_index + 5 - age) % 24], 0);
+    }
+    EXPECT_EQ(restored.phase_history[state.history_index], state.phase_history[state.history_index]);
+    EXPECT_EQ(restored.span_sum[1], restored.last_phase_score);                         // the newest 3 hours
+    EXPECT_EQ(restored.span_sum[2], restored.last_phase_score + state.span_sum[0]);     // 6 reaches the saved hour
+
+    // a day later it is too stale to use.
+    phase_engine_init(&restored);
+    EXPECT_EQ(phase_history_load(&restored, now + 55 * 3600), false);
+    EXPECT_EQ(restored.history_count, 0);
+
+    // hours without a score while running are skipped the same way, and a day's
+    // gap starts the ring over.
+    phase_engine_init(&state);
+    phase_compute(&state, 3, 0, 100, 0, 150, 0);
+    phase_compute(&state, 6, 0, 100, 0, 150, 0);
+    EXPECT_EQ(state.history_count, 4);
+    EXPECT_EQ(state.span_sum[1], state.last_phase_score);
+    phase_compute(&state, 7, 0, 101, 0, 150, 0);
+    EXPECT_EQ(state.history_count, 1);
+    EXPECT_EQ(state.span_sum[4], state.last_phase_score);
+}
+
+static void test_top_of_hour_saves(void) {
+    phase_state_t state, restored;
+    watch_storage_log_t sleep_log;
+    uint8_t sleep_record[71];
+    uint32_t now = 1767247200;      // 2026-01-01 06:00 UTC, a baseline hour
+
+    // boot: the logs open in Movement's order.
+    host_fake_reset();
+    EXPECT_TRUE(watch_storage_log_open(&sleep_log, "sleep", sizeof(sleep_record), 3));
+    phase_engine_init(&state);
+    EXPECT_EQ(phase_history_load(&state, now), false);
+    EXPECT_EQ(activity_baseline_load(&state.baseline), false);
+    for (uint16_t day = 1; day < 5; day++) {
+        for (uint8_t hour = 0; hour < 24; hour++) phase_compute(&state, hour, 0, day, 300, 150, 0);
+    }
+    phase_compute(&state, 6, 0, 5, 300, 150, 0);
+
+    // Movement's order at minute 0 in the sleep window: sleep log, hourly history, then the
+    // baseline, with the flash ready interrupt lagging behind all three.
+    memset(sleep_record, 0x5a, sizeof(sleep_record));
+    EXPECT_TRUE(watch_storage_log_append_async(&sleep_log, sleep_record, NULL, NULL));
+    EXPECT_TRUE(phase_history_save(&state, now));
+    EXPECT_TRUE(activity_baseline_save(&state.baseline));
+    while (host_fake_storage_interrupt()) { }
+
+    // all three are down.
+    memset(sleep_record, 0, sizeof(sleep_record));
+    EXPECT_TRUE(watch_storage_log_read(&sleep_log, 0, sleep_record));
+    EXPECT_EQ(sleep_record[70], 0x5a);
+    phase_engine_init(&restored);
+    EXPECT_TRUE(phase_history_load(&restored, now + 600));
+    EXPECT_EQ(memcmp(restored.phase_history, state.phase_history, sizeof(state.phase_history)), 0);
+    EXPECT_TRUE(activity_baseline_load(&restored.baseline));
+    EXPECT_EQ(memcmp(restored.baseline.mean, state.baseline.mean, sizeof(state.baseline.mean)), 0);
+    EXPECT_EQ(restored.baseline.days[3], state.baseline.days[3]);
+    EXPECT_TRUE(restored.baseline.days[3] > 0);
+}
+
+static void test_activity_baseline(void) {
+    activity_baseline_t baseline;
+    memset(&baseline, 0, sizeof(baseline));
+    EXPECT_TRUE(sizeof(activity_baseline_t) <= 200);
+
+    // a night-shift week: busy 22:00-06:00, quiet otherwise, a little day-to-day wobble.
+    for (uint8_t day = 0; day < 10; day++) {
+        for (uint8_t hour = 0; hour < 24; hour++) {
+            uint8_t activity = (hour >= 22 || hour < 6) ? 80 : 10;
+            if (hour == 12) activity = (day & 1) ? 30 : 50;
+            for (uint8_t sample = 0; sample < 4; sample++) activity_baseline_add(&baseline, hour, activity);
+        }
+        if (day == 1) {
+            EXPECT_EQ(activity_baseline_ready(&baseline, 3), false);
+            EXPECT_EQ(activity_baseline_zscore(&baseline, 3, 0), 0);
+        }
+    }
+    // the last hour of the last day is still in progress.
+    EXPECT_EQ(baseline.days[3], 10);
+    EXPECT_EQ(baseline.days[23], 9);
+    EXPECT_TRUE(activity_baseline_ready(&baseline, 3));
+
+    EXPECT_EQ(baseline.mean[3], 80 << 8);
+    EXPECT_EQ(baseline.variance[3], 0);
+    EXPECT_EQ(activity_baseline_zscore(&baseline, 3, 80), 0);
+    EXPECT_EQ(activity_baseline_zscore(&baseline, 3, 10), -ACTIVITY_BASELINE_MAX_Z);
+    EXPECT_EQ(activity_baseline_zscore(&baseline, 3, 81), 20);    // the spread floor: 1 / 5
+
+    // noon swings 30/50, so about ±10 around 40 is normal and 70 is not.
+    int16_t mean = baseline.mean[12] >> 8;
+    EXPECT_TRUE(mean >= 36 && mean <= 44);
+    EXPECT_TRUE(baseline.variance[12] > 0);
+    int16_t usual = activity_baseline_zscore(&baseline, 12, 50);
+    int16_t unusual = activity_baseline_zscore(&baseline, 12, 70);
+    EXPECT_TRUE(usual > 0 && usual < 200);
+    EXPECT_TRUE(unusual > 2 * usual);
+
+    // phase scoring stops penalising a schedule that repeats.
+    phase_state_t learned, fresh;
+    phase_engine_init(&learned);
+    phase_engine_init(&fresh);
+    for (uint16_t day = 100; day < 105; day++) {
+        for (uint8_t hour = 0; hour < 24; hour++) {
+            phase_compute(&learned, hour, 0, day, (hour >= 22 || hour < 6) ? 800 : 100, 200, 0);
+        }
+    }
+    uint16_t learned_score = phase_compute(&learned, 3, 30, 105, 800, 200, 0);
+    uint16_t fresh_score = phase_compute(&fresh, 3, 30, 105, 800, 200, 0);
+    EXPECT_TRUE(learned_score > fresh_score);
+
+    // with no motion sensor nothing is learned, and activity scores as zero against the curve.
+    phase_state_t unsensed;
+    phase_engine_init(&unsensed);
+    for (uint16_t day = 100; day < 105; day++) {
+        for (uint8_t hour = 0; hour < 24; hour++) {
+            phase_compute(&unsensed, hour, 0, day, PHASE_ACTIVITY_NONE, 200, 0);
+        }
+    }
+    EXPECT_EQ(unsensed.baseline.days[3], 0);
+    EXPECT_EQ(activity_baseline_ready(&unsensed.baseline, 3), false);
+    phase_engine_init(&fresh);
+    EXPECT_EQ(phase_compute(&unsensed, 3, 30, 105, PHASE_ACTIVITY_NONE, 200, 0),
+              phase_compute(&fresh, 3, 30, 105, 0, 200, 0));
+
+    // and it survives a reset.
+    host_fake_reset();
+    activity_baseline_t restored;
+    memset(&restored, 0, sizeof(restored));
+    EXPECT_EQ(activity_baseline_load(&restored), false);
+    EXPECT_TRUE(activity_baseline_save(&baseline));
+    while (host_fake_storage_interrupt()) { }
+    EXPECT_TRUE(activity_baseline_load(&restored));
+    EXPECT_EQ(memcmp(restored.mean, baseline.mean, sizeof(baseline.mean)), 0);
+    EXPECT_EQ(memcmp(restored.variance, baseline.variance, sizeof(baseline.variance)), 0);
+    EXPECT_EQ(memcmp(restored.days, baseline.days, sizeof(baseline.days)), 0);
+    EXPECT_EQ(restored.hour_samples, 0);
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+static void test_metric_comfort_table(void) {
+    static const struct {
+        int16_t temp_c10;
+        uint16_t lux;
+        uint8_t hour;
+        uint16_t year;
+        uint8_t month;
+        uint8_t day;
+        uint8_t score;
+    } rows[] = {
+        {  200,   500, 12, 2026,  6, 21,  75 },
+        {  -50,     0,  2, 2026,  1, 15,  42 },
+        {  350, 10000, 14, 2026,  7, 19,  77 },
+        {  150,    50, 22, 2026, 10, 27,  66 },
+        {  220,   800,  9, 2026,  4, 10,  49 },
+        {  100,     0,  0, 2026,  1,  1,  50 },
+        {  250,   300, 17, 2026,  9,  7,  74 },
+        {    0,  2000, 12, 2026, 12, 21,  55 },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        calendar_context_t cal = {0};
+        calendar_context_update(&cal, _local_time(rows[i].year, rows[i].month, rows[i].day, rows[i].hour, 0),
+                                0, 0, 0, false, 0, 0);
+        uint8_t score = metric_comfort_compute(rows[i].temp_c10, rows[i].lux, &cal);
+        EXPECT_ROW_EQ(i, score, rows[i].score);
+    }
+    EXPECT_EQ(metric_comfort_compute(200, 500, NULL), 50);
+}
+
+static void test_metric_em_table(void) {
+    static const struct { uint8_t hour; uint8_t illumination; uint16_t variance; uint8_t score; } rows[] = {
+        {  0,   0,    0,   2 },
+        { 14, 100, 1000,  90 },
+        {  2,  50,  500,  40 },
+        { 10,  25,  200,  53 },
+        { 22,  75,   50,  17 },
+        { 16, 100, 2000,  80 },     // variance clamps at 1000
+        {  8,  60,  700,  77 },
+        { 30,  10,  100,   6 },     // hour clamps to 23
+        { 12, 150,    0,  57 },     // illumination clamps at 100
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        EXPECT_ROW_EQ(i, metric_em_compute(rows[i].hour, rows[i].illumination, rows[i].variance), rows[i].score);
+    }
+}
+
+static void test_metric_energy_table(void) {
+    static const struct {
+        uint16_t phase;
+        uint8_t sd;
+        uint8_t jl;
+        uint16_t activity;
+        uint8_t hour;
+        bool has_accel;
+        uint8_t score;
+    } rows[] = {
+        { 100,   0, 100,    0, 12, true , 100 },
+        {  50,  50, 100,  500,  9, true ,  44 },
+        {   0, 100, 100,    0,  3, true ,   0 },
+        {  80,  20, 100, 1000, 14, false,  89 },
+        {  70,  10, 100,  300, 20, true ,  73 },
+        {  30,  80, 100,  800,  7, true ,  20 },
+        {  60,  40, 100,    0, 16, false,  57 },
+        {  90,   0, 100,  600, 11, true , 100 },
+        {  70,  10,  40,  300, 20, true ,  61 },    // 3 h of jet lag left: -12
+        {  50,  50,   0,  500,  9, true ,  24 },    // the most it costs: -20
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        uint8_t score = metric_energy_compute(rows[i].phase, rows[i].sd, rows[i].jl, rows[i].activity,
+                                              rows[i].hour, rows[i].has_accel);
+        EXPECT_ROW_EQ(i, score, rows[i].score);
+    }
+}
+
+static void test_metric_wk_table(void) {
+    static const struct { uint16_t minutes_awake; uint16_t activity; uint16_t variance; bool has_accel; uint8_t score; } rows[] = {
+        {   0,    0,    0, true ,   0 },
+        {  30,    0,    0, true ,  25 },
+        {  60,  500,    0, true ,  50 },
+        { 120, 2000,    0, true , 100 },
+        { 300,    0,    0, false, 100 },
+        {  15,  100,    0, false,   8 },
+        { 600, 5000,    0, true , 100 },
+        {  45,   50,    0, true ,  37 },
+        {  30,    0,  499, true ,  25 },
+        {  30,    0,  500, true ,  55 },    // an hour of moving about earns the bonus too
+        {  15,    0, 2000, false,   8 },    // but not without an accelerometer
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        uint8_t score = metric_wk_compute(rows[i].minutes_awake, rows[i].activity, rows[i].variance, rows[i].has_accel);
+        EXPECT_ROW_EQ(i, score, rows[i].score);
+    }
+}
+
+static void test_metric_sd(void) {
+    circadian_data_t data;
+    uint8_t deficits[3];
+
+    // 8 h every night: no debt.
+    _regular_week(&data);
+    EXPECT_EQ(metric_sd_compute(&data, deficits), 0);
+    EXPECT_EQ(deficits[0], 0);
+
+    // last three nights (most recent first): 5 h, 7 h, 6 h short of 8 h by 180, 60, 120.
+    data.write_index = 3;
+    data.nights[2].duration_min = 300;
+    data.nights[1].duration_min = 420;
+    data.nights[0].duration_min = 360;
+    EXPECT_EQ(metric_sd_compute(&data, deficits), 100);     // (180*50 + 60*30 + 120*20) / 100 = 132, clamped
+    EXPECT_EQ(deficits[0], 100);
+    EXPECT_EQ(deficits[1], 60);
+    EXPECT_EQ(deficits[2], 100);
+
+    data.nights[2].duration_min = 450;
+    EXPECT_EQ(metric_sd_compute(&data, deficits), (30 * 50 + 60 * 30 + 120 * 20) / 100);
+
+    EXPECT_EQ(metric_sd_compute(NULL, deficits), 50);
+}
+
+static void test_metric_jl(void) {
+    // clock changes become shifts: wrapped to ±12 h, rounded to the quarter hour.
+    static const struct { int32_t seconds; int16_t shift; } shifts[] = {
+        {  9 * 3600,        540 },      // Chicago to Paris
+        { -9 * 3600,       -540 },
+        { 14 * 3600,       -600 },      // the short way round
+        { 86400 + 3600,      60 },      // a day and an hour
+        { 5 * 3600 + 1800,  330 },      // India
+        {  420,               0 },      // a clock correction
+        {  600,              15 },
+    };
+    for (size_t i = 0; i < ARRAY_LEN(shifts); i++) {
+        EXPECT_ROW_EQ(i, metric_jl_shift_minutes(shifts[i].seconds), shifts[i].shift);
+    }
+
+    // eastward comes back at an hour a day, westward at an hour and a half.
+    EXPECT_EQ(metric_jl_remaining(540, 0), 540);
+    EXPECT_EQ(metric_jl_remaining(540, 2 * 1440), 420);
+    EXPECT_EQ(metric_jl_remaining(540, 9 * 1440), 0);
+    EXPECT_EQ(metric_jl_remaining(-540, 2 * 1440), -360);
+    EXPECT_EQ(metric_jl_remaining(-540, 6 * 1440), 0);
+    EXPECT_EQ(metric_jl_remaining(0, 100), 0);
+    EXPECT_EQ(metric_jl_compute(0), 100);
+    EXPECT_EQ(metric_jl_compute(-180), 40);
+    EXPECT_EQ(metric_jl_compute(540), 0);
+
+    // through the engine: a flight east, a day later, then saved and reloaded.
+    metrics_engine_t engine, reloaded;
+    struct sensor_state_t sensors;
+    metrics_snapshot_t snapshot;
+    calendar_context_t cal = {0};
+    host_fake_reset();
+    sensors_init(&sensors, true, true);
+    metrics_init(&engine);
+    EXPECT_EQ(engine.bkup_reg_jl, 6);
+    calendar_context_update(&cal, _local_time(2026, 3, 15, 9, 0), 0, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 60, 0, NULL, true);
+    metrics_get(&engine, &snapshot);
+    EXPECT_EQ(snapshot.jl, 100);
+
+    metrics_note_time_shift(&engine, 6 * 3600, cal.utc_minute);
+    calendar_context_update(&cal, _local_time(2026, 3, 16, 15, 0), 6 * 3600, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 60, 0, NULL, true);
+    metrics_get(&engine, &snapshot);
+    EXPECT_EQ(snapshot.jl, 100 - 300 / 3);      // 5 h still to go
+    EXPECT_TRUE(engine.last_recomputed & METRIC_BIT_JL);
+    EXPECT_TRUE(engine.last_recomputed & METRIC_BIT_ENERGY);
+    EXPECT_EQ(snapshot.energy, metric_energy_compute(60, snapshot.sd, 0, sensors_get_motion_intensity(&sensors), 15, true));
+
+    // nothing moves within the minute, so nothing is redone.
+    metrics_update(&engine, &sensors, &cal, 60, 0, NULL, true);
+    EXPECT_EQ(engine.last_recomputed & METRIC_BIT_JL, 0);
+
+    host_fake.next_backup_register = 4;
+    metrics_init(&reloaded);
+    EXPECT_EQ(reloaded.jl_shift_min, 360);
+    EXPECT_EQ(reloaded.jl_shift_utc_minute, engine.jl_shift_utc_minute);
+
+    // flying back before it is made up: 5 h east left, 6 h west, 1 h west to go.
+    metrics_note_time_shift(&reloaded, -6 * 3600, cal.utc_minute);
+    EXPECT_EQ(reloaded.jl_shift_min, -60);
+
+    // a week on, re-entrained: the shift is dropped for good.
+    calendar_context_update(&cal, _local_time(2026, 3, 23, 15, 0), 0, 0, 0, false, 0, 0);
+    metrics_update(&reloaded, &sensors, &cal, 60, 0, NULL, true);
+    metrics_get(&reloaded, &snapshot);
+    EXPECT_EQ(snapshot.jl, 100);
+    EXPECT_EQ(reloaded.jl_shift_min, 0);
+    EXPECT_EQ(watch_get_backup_data(reloaded.bkup_reg_jl) & 0xFF, 0);
+}
+
+static void test_metric_jl_held_shifts(void) {
+    metrics_engine_t engine;
+    uint32_t utc_minute = 29590560;     // 2026-04-04 00:00 UTC
+
+    host_fake_reset();
+    metrics_init(&engine);
+
+    // the settings face steps the hour from 3 to 15 one press at a time: one +12 h shift,
+    // recorded when the wearer leaves the face, not twelve of an hour each.
+    for (uint8_t hour = 3; hour < 15; hour++) {
+        metrics_hold_time_shift(&engine, 3600);
+        EXPECT_EQ(engine.jl_shift_min, 0);
+    }
+    metrics_flush_time_shift(&engine, utc_minute);
+    EXPECT_EQ(engine.jl_shift_min, 720);
+    metrics_flush_time_shift(&engine, utc_minute);     // nothing held: nothing more
+    EXPECT_EQ(engine.jl_shift_min, 720);
+
+    // all the way round the clock and back where it started is no shift at all.
+    metrics_init(&engine);
+    for (uint8_t press = 0, hour = 3; press < 24; press++, hour = (hour + 1) % 24) {
+        metrics_hold_time_shift(&engine, (hour == 23) ? -23 * 3600 : 3600);
+    }
+    metrics_flush_time_shift(&engine, utc_minute);
+    EXPECT_EQ(engine.jl_shift_min, 0);
+
+    // 3 round to 9: 23 -> 0 is a step back of 23 hours, but the net is +6 h.
+    metrics_init(&engine);
+    for (uint8_t hour = 3; hour != 9; hour = (hour + 1) % 24) {
+        metrics_hold_time_shift(&engine, (hour == 23) ? -23 * 3600 : 3600);
+    }
+    metrics_flush_time_shift(&engine, utc_minute);
+    EXPECT_EQ(engine.jl_shift_min, 360);
+
+    // setting the date is not travel, even with the hour set on the way.
+    metrics_init(&engine);
+    metrics_hold_time_shift(&engine, 3 * 86400);
+    metrics_hold_time_shift(&engine, 2 * 3600);
+    metrics_flush_time_shift(&engine, utc_minute);
+    EXPECT_EQ(engine.jl_shift_min, 0);
+
+    // the year stepped round and back wraps rather than overflowing.
+    metrics_init(&engine);
+    for (uint8_t press = 0; press < 60; press++) metrics_hold_time_shift(&engine, 365 * 86400);
+    for (uint8_t press = 0; press < 60; press++) metrics_hold_time_shift(&engine, -365 * 86400);
+    metrics_hold_time_shift(&engine, -2 * 3600);
+    metrics_flush_time_shift(&engine, utc_minute);
+    EXPECT_EQ(engine.jl_shift_min, -120);
+}
+
+static void test_metrics_bkup_roundtrip(void) {
+    metrics_engine_t engine, reloaded;
+    struct sensor_state_t sensors;
+    circadian_data_t data;
+    metrics_snapshot_t snapshot;
+
+    host_fake_reset();
+    host_fake_set_time(2026, 3, 15, 9, 30);
+    sensors_init(&sensors, true, true);
+    _irregular_week(&data);
+
+    metrics_init(&engine);
+    EXPECT_EQ(engine.bkup_reg_sd, 4);
+    EXPECT_EQ(engine.bkup_reg_wk, 5);
+    metrics_set_wake_onset(&engine, 7, 15);
+    calendar_context_t cal = {0};
+    calendar_context_update(&cal, host_fake.date_time, 0, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 60, 0, &data, true);
+    metrics_get(&engine, &snapshot);
+    EXPECT_EQ(snapshot.wk, 100);           // 2 h 15 min awake: past the 2 h ramp
+    EXPECT_TRUE(snapshot.sd <= 100 && snapshot.em <= 100 && snapshot.energy <= 100 && snapshot.comfort <= 100);
+
+    // a fresh engine on the same registers picks up where the first left off.
+    host_fake.next_backup_register = 4;
+    metrics_init(&reloaded);
+    EXPECT_EQ(reloaded.wake_onset_hour, 7);
+    EXPECT_EQ(reloaded.wake_onset_minute, 15);
+    EXPECT_EQ(memcmp(reloaded.sd_deficits, engine.sd_deficits, 3), 0);
+}
+
+static void test_metrics_dirty_tracking(void) {
+    metrics_engine_t engine;
+    struct sensor_state_t sensors;
+    circadian_data_t data;
+    metrics_snapshot_t snapshot;
+    calendar_context_t cal = {0};
+
+    host_fake_reset();
+    sensors_init(&sensors, true, true);
+    _irregular_week(&data);
+    metrics_init(&engine);
+    metrics_set_wake_onset(&engine, 7, 0);
+
+    // the first update computes everything and saves the SD deficits.
+    calendar_context_update(&cal, _local_time(2026, 3, 15, 9, 0), 0, 0, 0, false, 0, 0);
+    uint32_t writes = host_fake.backup_writes;
+    metrics_update(&engine, &sensors, &cal, 60, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BITS_ALL);
+    EXPECT_EQ(host_fake.backup_writes, writes + 1);
+
+    // the same inputs again: nothing to do, and no BKUP write.
+    writes = host_fake.backup_writes;
+    metrics_update(&engine, &sensors, &cal, 60, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, 0);
+    EXPECT_EQ(host_fake.backup_writes, writes);
+
+    // a quarter hour on, only WK's minutes awake moved.
+    calendar_context_update(&cal, _local_time(2026, 3, 15, 9, 15), 0, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 60, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BIT_WK);
+
+    // a warmer room is comfort's business; a new phase score is energy's.
+    sensors.temperature_c10 = 260;
+    metrics_update(&engine, &sensors, &cal, 61, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BIT_COMFORT | METRIC_BIT_ENERGY);
+
+    // a new night moves SD (and energy with it, as SD changed) and is saved.
+    circadian_sleep_night_t night = {
+        .onset_timestamp = 1773630000, .offset_timestamp = 1773640000,
+        .duration_min = 166, .efficiency = 90, .valid = true
+    };
+    circadian_data_add_night(&data, &night);
+    writes = host_fake.backup_writes;
+    metrics_update(&engine, &sensors, &cal, 61, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BIT_SD | METRIC_BIT_ENERGY);
+    EXPECT_EQ(host_fake.backup_writes, writes + 1);
+
+    // the next hour, and the next day, reach the metrics that read them.
+    calendar_context_update(&cal, _local_time(2026, 3, 15, 10, 15), 0, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 61, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BITS_ALL & ~(METRIC_BIT_SD | METRIC_BIT_JL));
+    calendar_context_update(&cal, _local_time(2026, 3, 16, 10, 15), 0, 0, 0, false, 0, 0);
+    metrics_update(&engine, &sensors, &cal, 61, 100, &data, true);
+    EXPECT_EQ(engine.last_recomputed, METRIC_BIT_COMFORT | METRIC_BIT_EM);
+
+    // whatever was skipped, the values are what a full recompute gives.
+    uint8_t deficits[3];
+    metrics_get(&engine, &snapshot);
+    EXPECT_EQ(snapshot.sd, metric_sd_compute(&data, deficits));
+    EXPECT_EQ(snapshot.comfort, metric_comfort_compute(260, sensors_get_lux_avg(&sensors), &cal));
+    EXPECT_EQ(snapshot.em, metric_em_compute(10, cal.lunar.illumination, sensors_get_motion_variance(&sensors)));
+    EXPECT_EQ(snapshot.wk, metric_wk_compute(195, 100, sensors_get_motion_variance_over(&sensors, SENSOR_MOTION_LONG), true));
+    EXPECT_EQ(snapshot.energy, metric_energy_compute(61, snapshot.sd, snapshot.jl, sensors_get_motion_intensity(&sensors), 10, true));
+
+    // saving an unchanged state rewrites nothing.
+    writes = host_fake.backup_writes;
+    metrics_save_bkup(&engine);
+    EXPECT_EQ(host_fake.backup_writes, writes);
+}
+
+static void test_metric_cadence(void) {
+    EXPECT_EQ(metric_cadence_interval(0), 15);
+    EXPECT_EQ(metric_cadence_interval(METRIC_CADENCE_ZONE_FACE), 1);
+    EXPECT_EQ(metric_cadence_interval(METRIC_CADENCE_HIGH_MOTION), 1);
+    EXPECT_EQ(metric_cadence_interval(METRIC_CADENCE_ASLEEP), 60);
+    EXPECT_EQ(metric_cadence_interval(METRIC_CADENCE_ASLEEP | METRIC_CADENCE_ZONE_FACE), 1);
+    EXPECT_EQ(metric_cadence_interval(METRIC_CADENCE_ASLEEP | METRIC_CADENCE_HIGH_MOTION), 1);
+
+    // on the clock, or when one was missed.
+    EXPECT_EQ(metric_cadence_due(15, 9 * 60 + 30, 15), true);
+    EXPECT_EQ(metric_cadence_due(15, 9 * 60 + 31, 1), false);
+    EXPECT_EQ(metric_cadence_due(15, 9 * 60 + 45, 3), true);     // back from per-minute: realign
+    EXPECT_EQ(metric_cadence_due(60, 2 * 60 + 30, 30), false);
+    EXPECT_EQ(metric_cadence_due(60, 3 * 60, 30), true);
+    EXPECT_EQ(metric_cadence_due(60, 3 * 60 + 7, 60), true);
+    EXPECT_EQ(metric_cadence_due(1, 3 * 60 + 7, 1), true);
+
+    // a day: asleep 23:00-07:00, a zone face open 12:00-12:30, otherwise idle.
+    uint16_t runs = 0;
+    uint16_t since = 0;
+    unsigned missed_hours = 0;
+    for (uint16_t minute = 0; minute < 1440; minute++) {
+        uint8_t conditions = 0;
+        if (minute < 7 * 60 || minute >= 23 * 60) conditions |= METRIC_CADENCE_ASLEEP;
+        if (minute >= 12 * 60 && minute < 12 * 60 + 30) conditions |= METRIC_CADENCE_ZONE_FACE;
+        since++;
+        bool due = metric_cadence_due(metric_cadence_interval(conditions), minute, since);
+        if (due) {
+            runs++;
+            since = 0;
+        } else if (minute % 60 == 0) {
+            missed_hours++;
+        }
+    }
+    EXPECT_EQ(runs, 8 + (16 * 4 - 2) + 30);  // hourly asleep, quarter-hourly awake, per-minute for half an hour
+    EXPECT_EQ(missed_hours, 0);
+}
+
+// ============================================================================
+// Sensors
+// ============================================================================
+
+static void test_sensors_update(void) {
+    struct sensor_state_t sensors;
+
+    host_fake_reset();
+    sensors_init(&sensors, true, true);
+
+    host_fake.accel = (lis2dw_reading_t){ 100, -200, 300 };
+    host_fake.wakeup_source = LIS2DW_WAKEUP_SRC_WAKEUP;
+    host_fake.light_adc = 6000;
+    host_fake.temperature_c100 = 2125;
+    sensors_update(&sensors, 15);
+
+    EXPECT_EQ(sensors.motion_magnitude, 600);
+    EXPECT_EQ(sensors_get_motion_intensity(&sensors), (600 / 32) / 4);
+    EXPECT_EQ(sensors_get_motion_variance(&sensors), 0);    // one sample
+    EXPECT_EQ(sensors_is_motion_active(&sensors), true);
+    EXPECT_EQ(sensors_get_epoch_movement_count(&sensors), 1);
+    EXPECT_EQ(sensors_get_lux_avg(&sensors), 1000);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 213);
+
+    host_fake.accel = (lis2dw_reading_t){ 0, 0, 1000 };
+    host_fake.wakeup_source = 0;
+    host_fake.light_adc = 0;
+    host_fake.temperature_c100 = -326;
+    sensors_update(&sensors, 15);
+
+    // 600 then 1000 raw (37.5 and 62.5 mg), 15 minutes apart: the short horizon caps the
+    // newer one at half weight, (1/2)(1/2)(25 mg)²; the hour gives it 1 - (59/60)^15.
+    EXPECT_EQ(sensors_get_motion_variance(&sensors), 156);
+    EXPECT_EQ(sensors_get_motion_variance_over(&sensors, SENSOR_MOTION_LONG), 108);
+    EXPECT_EQ(sensors.inactivity_minutes, 0);           // no sleep-state bit: neither moving nor still
+
+    EXPECT_EQ(sensors_get_lux_avg(&sensors), 500);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), -33);
+
+    host_fake.temperature_c100 = THERMISTOR_DRIVER_NO_READING;   // no sensor
+    sensors_sample_temperature(&sensors);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 200);
+
+    // still, a minute at a time: inactive after 15 of them, and it saturates rather than wraps.
+    host_fake.wakeup_source = LIS2DW_WAKEUP_SRC_SLEEP_STATE;
+    for (uint8_t i = 0; i < 14; i++) sensors_update(&sensors, 1);
+    EXPECT_EQ(sensors_is_motion_active(&sensors), true);
+    sensors_update(&sensors, 1);
+    EXPECT_EQ(sensors_is_motion_active(&sensors), false);
+    for (uint8_t i = 0; i < 5; i++) sensors_update(&sensors, 60);
+    EXPECT_EQ(sensors.inactivity_minutes, 255);
+}
+
+// The 5-sample rescan sensors.c used before the streaming estimator, in mg²: the
+// baseline the horizons are measured against.
+static uint32_t _window_variance_mg2(const uint16_t *window, uint8_t count) {
+    uint32_t sum = 0;
+    uint64_t sq_sum = 0;
+
+    for (uint8_t i = 0; i < count; i++) sum += window[i];
+    for (uint8_t i = 0; i < count; i++) {
+        int32_t diff = (int32_t)window[i] - (int32_t)(sum / count);
+        sq_sum += (uint64_t)(diff * diff);
+    }
+    return (uint32_t)(sq_sum / count / 256);
+}
+
+static void test_motion_stats(void) {
+    sensor_motion_stats_t stats = {0};
+
+    // a watch on a desk: the means sit on the reading and there is nothing to vary.
+    for (uint8_t i = 0; i < 120; i++) sensors_motion_stats_add(&stats, 16384, 1);
+    EXPECT_EQ(stats.mean[SENSOR_MOTION_SHORT], 16384);
+    EXPECT_EQ(stats.mean[SENSOR_MOTION_LONG], 16384);
+    EXPECT_EQ(sensors_motion_stats_variance(&stats, SENSOR_MOTION_SHORT), 0);
+    EXPECT_EQ(sensors_motion_stats_variance(&stats, SENSOR_MOTION_LONG), 0);
+    EXPECT_EQ(sensors_motion_stats_variance(&stats, SENSOR_MOTION_HORIZON_COUNT), 0);
+
+    // A day of once-a-minute readings spread evenly over +/-50 mg: a variance of
+    // 800·801/3 raw², 834 mg². Score each estimate by its RMS error once warmed up.
+    const double truth = 800.0 * 801.0 / 3.0 / 256.0;
+    uint16_t window[5];
+    double sq_error[3] = { 0 };
+    double sum[3] = { 0 };
+    uint32_t n = 0;
+    uint32_t seed = 0x2026u;
+
+    memset(&stats, 0, sizeof(stats));
+    for (uint32_t minute = 0; minute < 1440; minute++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint16_t magnitude = (uint16_t)(16384 - 800 + (seed >> 8) % 1601);
+        sensors_motion_stats_add(&stats, magnitude, 1);
+        window[minute % 5] = magnitude;
+        if (minute < 180) continue;
+
+        double estimate[3] = {
+            _window_variance_mg2(window, 5),
+            sensors_motion_stats_variance(&stats, SENSOR_MOTION_SHORT),
+            sensors_motion_stats_variance(&stats, SENSOR_MOTION_LONG),
+        };
+        for (uint8_t i = 0; i < 3; i++) {
+            sum[i] += estimate[i];
+            sq_error[i] += (estimate[i] - truth) * (estimate[i] - truth);
+        }
+        n++;
+    }
+    double rms_window = sqrt(sq_error[0] / n) / truth;
+    double rms_short = sqrt(sq_error[1] / n) / truth;
+    double rms_long = sqrt(sq_error[2] / n) / truth;
+
+    // The hour is within a few percent on average and an order steadier than five samples;
+    // the 5-minute horizon is no worse than the window it replaces.
+    EXPECT_TRUE(fabs(sum[2] / n - truth) < truth * 0.08);
+    EXPECT_TRUE(rms_long < 0.2);
+    EXPECT_TRUE(rms_long * 3 < rms_window);
+    EXPECT_TRUE(rms_short <= rms_window);
+
+    // Fifteen-minute samples (awake, no zone face): a jump in level shows up on both
+    // horizons and fades from the short one within the hour.
+    memset(&stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < 8; i++) sensors_motion_stats_add(&stats, 16384, 15);
+    sensors_motion_stats_add(&stats, 16384 + 1600, 15);
+    EXPECT_TRUE(sensors_motion_stats_variance(&stats, SENSOR_MOTION_SHORT) >= 2000);
+    EXPECT_TRUE(sensors_motion_stats_variance(&stats, SENSOR_MOTION_LONG) >= 1000);
+    for (uint8_t i = 0; i < 4; i++) sensors_motion_stats_add(&stats, 16384 + 1600, 15);
+    EXPECT_TRUE(sensors_motion_stats_variance(&stats, SENSOR_MOTION_SHORT) < 1000);
+}
+
+static void test_activity_level(void) {
+    struct sensor_state_t sensors;
+    // a watch left still, face up and then on its edge: the L1 magnitude carries
+    // gravity, so intensity reads half scale or more and moves with the orientation.
+    const lis2dw_reading_t still[] = { { 0, 0, 16000 }, { 11300, 0, 11300 } };
+    phase_state_t scored, idle;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        host_fake_reset();
+        sensors_init(&sensors, true, false);
+        host_fake.accel = still[i];
+        for (uint8_t minute = 0; minute < 60; minute++) sensors_update(&sensors, 1);
+
+        EXPECT_TRUE(sensors_get_motion_intensity(&sensors) >= 450);
+        EXPECT_EQ(sensors_get_activity_level(&sensors), 0);
+
+        // and the phase engine sees it as no activity at all.
+        phase_engine_init(&scored);
+        phase_engine_init(&idle);
+        EXPECT_EQ(phase_compute(&scored, 14, 0, 200, sensors_get_activity_level(&sensors), 200, 0),
+                  phase_compute(&idle, 14, 0, 200, 0, 200, 0));
+    }
+
+    // swinging +/-100 mg about 1 g reads as moderate, a 1.5 g swing saturates.
+    host_fake_reset();
+    sensors_init(&sensors, true, false);
+    for (uint8_t minute = 0; minute < 60; minute++) {
+        host_fake.accel = (lis2dw_reading_t){ 0, 0, (minute & 1) ? 17600 : 14400 };
+        sensors_update(&sensors, 1);
+    }
+    uint16_t moderate = sensors_get_activity_level(&sensors);
+    EXPECT_TRUE(moderate >= 400 && moderate <= 600);
+
+    for (uint8_t minute = 0; minute < 60; minute++) {
+        host_fake.accel = (lis2dw_reading_t){ 0, 0, (minute & 1) ? 28000 : 4000 };
+        sensors_update(&sensors, 1);
+    }
+    EXPECT_EQ(sensors_get_activity_level(&sensors), 1000);
+    EXPECT_EQ(sensors_get_activity_level(NULL), 0);
+}
+
+static void test_thermistor_c100(void) {
+    int worst_room = 0;     // -20 to 60 °C, where the watch is worn
+    int worst_wide = 0;     // out to 125 °C
+
+    for (uint32_t value = 1024; value < 63488; value++) {
+        float expected = watch_utility_thermistor_temperature((uint16_t)value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT,
+                                                              THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE,
+                                                              THERMISTOR_SERIES_RESISTANCE);
+        if (expected < -40.0f || expected > 125.0f) continue;
+        int error = (int)lroundf(fabsf(watch_utility_thermistor_temperature_c100((uint16_t)value) - expected * 100.0f));
+        if (error > worst_wide) worst_wide = error;
+        if (expected >= -20.0f && expected <= 60.0f && error > worst_room) worst_room = error;
+    }
+
+    EXPECT_TRUE(worst_room <= 5);
+    EXPECT_TRUE(worst_wide <= 65);
+
+    // nominal: 25 °C with the divider at half scale; both ends clamp rather than wrap.
+    EXPECT_TRUE(abs(watch_utility_thermistor_temperature_c100(32736) - 2500) <= 2);
+    EXPECT_EQ(watch_utility_thermistor_temperature_c100(0), -5500);
+    EXPECT_EQ(watch_utility_thermistor_temperature_c100(65535), 15000);
+}
+
+static void test_lis2dw_temperature_c100(void) {
+    // 12 bits, left-justified, 1/16 °C from 25 °C; the low nibble isn't part of the reading.
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(0), 2500);
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(0x000F), 2500);
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(80 << 4), 3000);
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(1 << 4), 2506);                  // 25.0625
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100((uint16_t)(-1 * 16)), 2494);     // 24.9375
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100((uint16_t)(-400 * 16)), 0);
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(0x7FF0), 15294);
+    EXPECT_EQ(watch_utility_lis2dw_temperature_c100(0x8000), -10300);
+
+    // the sensor pipeline's tenths come from the same hundredths.
+    struct sensor_state_t sensors;
+    sensors_init(&sensors, true, false);
+    for (int16_t sixteenths = -400; sixteenths <= 400; sixteenths += 7) {
+        host_fake.accel_temperature = sixteenths * 16;
+        sensors_sample_temperature(&sensors);
+        int16_t c100 = watch_utility_lis2dw_temperature_c100((uint16_t)(sixteenths * 16));
+        EXPECT_EQ(sensors_get_temperature_c10(&sensors), (c100 + (c100 >= 0 ? 5 : -5)) / 10);
+    }
+}
+
+static void test_sensor_schedule(void) {
+    struct sensor_state_t sensors;
+    const uint8_t adc_bits = SENSOR_BIT(SENSOR_LUX) | SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_VCC);
+
+    // Every rate divides an hour, so the top of the hour always gets a sample.
+    for (uint8_t sensor = 0; sensor < SENSOR_COUNT; sensor++) {
+        for (uint8_t context = 0; context < SENSOR_CONTEXT_COUNT; context++) {
+            uint8_t interval = sensors_schedule_interval((sensor_id_t)sensor, (sensor_context_t)context);
+            EXPECT_TRUE(interval > 0 && 60 % interval == 0);
+        }
+    }
+
+    host_fake_reset();
+    sensors_init(&sensors, true, true);
+    host_fake.light_adc = 600;
+    host_fake.temperature_c100 = 1800;
+    host_fake.vcc_mv = 2900;
+
+    // The first tick takes everything, ADC readers in one power-up, whatever the minute.
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 7 * 60 + 7),
+              adc_bits | SENSOR_BIT(SENSOR_MOTION));
+    EXPECT_EQ(host_fake.adc_power_ups, 1);
+    EXPECT_EQ(sensors_get_lux_avg(&sensors), 100);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 180);
+    EXPECT_EQ(sensors_get_vcc_mv(&sensors), 2900);
+
+    // Awake: lux every minute, temperature and motion on the quarter hour, which
+    // 07:08 to 07:14 is not; the thermistor and lux then share the 07:15 power-up.
+    for (uint16_t minute = 7 * 60 + 8; minute < 7 * 60 + 15; minute++) {
+        EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, minute), SENSOR_BIT(SENSOR_LUX));
+    }
+    host_fake.adc_power_ups = 0;
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 7 * 60 + 15),
+              SENSOR_BIT(SENSOR_LUX) | SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_MOTION));
+    EXPECT_EQ(host_fake.adc_power_ups, 1);
+
+    // A zone face wants everything it shows every minute; VCC stays hourly.
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_ZONE_FACE, 7 * 60 + 16),
+              SENSOR_BIT(SENSOR_LUX) | SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_MOTION));
+
+    // Asleep, lux only on the quarter hour and the rest on the hour. 07:17 to 07:59
+    // takes lux at :30 and :45 only; 08:00 takes everything.
+    uint8_t lux_samples = 0;
+    for (uint16_t minute = 7 * 60 + 17; minute < 8 * 60; minute++) {
+        uint8_t due = sensors_schedule_tick(&sensors, SENSOR_CONTEXT_ASLEEP, minute);
+        EXPECT_TRUE((due & ~SENSOR_BIT(SENSOR_LUX)) == 0);
+        if (due) lux_samples++;
+    }
+    EXPECT_EQ(lux_samples, 2);
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_ASLEEP, 8 * 60),
+              adc_bits | SENSOR_BIT(SENSOR_MOTION));
+
+    // The 07:00 hour, from 07:07: lux 1 + 7 + 1 + 1 + 2, the thermistor and motion at
+    // 07:07, 07:15 and 07:16, VCC once.
+    EXPECT_EQ(sensors_get_hourly_samples(&sensors, SENSOR_LUX), 12);
+    EXPECT_EQ(sensors_get_hourly_samples(&sensors, SENSOR_THERMISTOR), 3);
+    EXPECT_EQ(sensors_get_hourly_samples(&sensors, SENSOR_MOTION), 3);
+    EXPECT_EQ(sensors_get_hourly_samples(&sensors, SENSOR_VCC), 1);
+    EXPECT_EQ(sensors_get_hourly_samples(&sensors, SENSOR_LIS2DW_TEMP), 0);
+
+    // Waking at 08:20, twenty minutes after the last temperature and motion samples,
+    // catches up rather than waiting for 08:30.
+    for (uint16_t minute = 8 * 60 + 1; minute < 8 * 60 + 20; minute++) {
+        sensors_schedule_tick(&sensors, SENSOR_CONTEXT_ASLEEP, minute);
+    }
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 8 * 60 + 20),
+              SENSOR_BIT(SENSOR_LUX) | SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_MOTION));
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 8 * 60 + 21), SENSOR_BIT(SENSOR_LUX));
+
+    // No thermistor: the LIS2DW12's die sensor (25 °C + 80/16) stands in, with no ADC involved.
+    host_fake_reset();
+    host_fake.accel_temperature = 80 << 4;
+    sensors_init(&sensors, true, false);
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 0) & (SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_LIS2DW_TEMP)),
+              SENSOR_BIT(SENSOR_LIS2DW_TEMP));
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 300);
+    host_fake.accel_temperature = -40 * 16;
+    sensors_sample_temperature(&sensors);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 225);
+
+    // Nothing at all: 20.0 °C, and no motion to sample.
+    sensors_init(&sensors, false, false);
+    EXPECT_EQ(sensors_schedule_tick(&sensors, SENSOR_CONTEXT_AWAKE, 0) & ((SENSOR_BIT(SENSOR_THERMISTOR) | SENSOR_BIT(SENSOR_LIS2DW_TEMP)) | SENSOR_BIT(SENSOR_MOTION)), 0);
+    EXPECT_EQ(sensors_get_temperature_c10(&sensors), 200);
+}
+
+static void test_sensors_fifo_batching(void) {
+    struct sensor_state_t sensors;
+
+    // lis2dw_monitor_face left behind: 12.5 Hz in the background, the FIFO collecting.
+    host_fake_reset();
+    host_fake.background_rate = LIS2DW_DATA_RATE_12_5_HZ;
+    host_fake.data_rate = LIS2DW_DATA_RATE_12_5_HZ;
+    host_fake.fifo_ctrl = LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH;
+    sensors_init(&sensors, true, true);
+    sensors_begin_batching(&sensors);
+
+    EXPECT_EQ(sensors_is_batching(&sensors), true);
+    EXPECT_EQ(host_fake.fifo_ctrl, LIS2DW_FIFO_CTRL_MODE_COLLECT_CONTINUOUS | SENSOR_BATCH_WATERMARK);
+    EXPECT_EQ(host_fake.int1_sources, LIS2DW_CTRL4_INT1_FTH);
+    EXPECT_EQ(host_fake.data_rate, LIS2DW_DATA_RATE_LOWEST);
+
+    // Still at 1 g on Z with a little noise, then a roll onto the side, a 40 mg shift and a
+    // 20 mg twitch that stays under the threshold. The first sample is only a reference.
+    static const lis2dw_reading_t samples[] = {
+        { 0, 0, 16384 }, { 16, -16, 16384 }, { 0, 0, 16400 },
+        { 16384, 0, 0 }, { 16384, 640, 0 }, { 16384, 960, 0 }, { 16384, 960, 0 },
+    };
+    host_fake.fifo.count = ARRAY_LEN(samples);
+    memcpy(host_fake.fifo.readings, samples, sizeof(samples));
+    EXPECT_EQ(sensors_drain_fifo(&sensors), 2);
+    EXPECT_EQ(sensors_get_epoch_movement_count(&sensors), 2);
+    EXPECT_EQ(sensors_get_hourly_movement_count(&sensors), 2);
+
+    // The next drain carries on from the last sample, not from scratch.
+    host_fake.fifo.count = 1;
+    host_fake.fifo.readings[0] = (lis2dw_reading_t){ 0, 0, 16384 };
+    EXPECT_EQ(sensors_drain_fifo(&sensors), 1);
+    EXPECT_EQ(sensors_drain_fifo(&sensors), 0);    // empty
+
+    // A wake-up no longer counts as a movement; the magnitude comes from the last drained sample.
+    host_fake.wakeup_source = LIS2DW_WAKEUP_SRC_WAKEUP;
+    host_fake.accel = (lis2dw_reading_t){ 100, 100, 100 };
+    sensors_update(&sensors, 1);
+    EXPECT_EQ(sensors_get_epoch_movement_count(&sensors), 3);
+    EXPECT_EQ(sensors.motion_magnitude, 16384);
+
+    // Counts saturate.
+    sensors.epoch_movement_count = 254;
+    host_fake.fifo.count = 3;
+    host_fake.fifo.readings[0] = (lis2dw_reading_t){ 16384, 0, 0 };
+    host_fake.fifo.readings[1] = (lis2dw_reading_t){ 0, 0, 16384 };
+    host_fake.fifo.readings[2] = (lis2dw_reading_t){ 16384, 0, 0 };
+    EXPECT_EQ(sensors_drain_fifo(&sensors), 3);
+    EXPECT_EQ(sensors_get_epoch_movement_count(&sensors), 255);
+
+    // and it gets all of that back.
+    sensors_end_batching(&sensors);
+    EXPECT_EQ(sensors_is_batching(&sensors), false);
+    EXPECT_EQ(host_fake.fifo_ctrl, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
+    EXPECT_EQ(host_fake.data_rate, LIS2DW_DATA_RATE_12_5_HZ);
+    EXPECT_EQ(host_fake.int1_sources, LIS2DW_CTRL4_INT1_WU);
+    EXPECT_EQ(sensors_drain_fifo(&sensors), 0);
+
+    // From the boot configuration, the FIFO goes back off.
+    host_fake.background_rate = LIS2DW_DATA_RATE_LOWEST;
+    host_fake.fifo_ctrl = LIS2DW_FIFO_CTRL_MODE_OFF;
+    sensors_begin_batching(&sensors);
+    sensors_end_batching(&sensors);
+    EXPECT_EQ(host_fake.fifo_ctrl, LIS2DW_FIFO_CTRL_MODE_OFF);
+    EXPECT_EQ(host_fake.data_rate, LIS2DW_DATA_RATE_LOWEST);
+
+    // Without an accelerometer there is nothing to batch.
+    sensors_init(&sensors, false, false);
+    sensors_begin_batching(&sensors);
+    EXPECT_EQ(sensors_is_batching(&sensors), false);
+}
+
+// ============================================================================
+// Sleep data
+// ============================================================================
+
+static void test_sleep_epoch_classification(void) {
+    static const struct { uint8_t movements; sleep_state_t state; } rows[] = {
+        {   0, DEEP_SLEEP },
+        {   1, DEEP_SLEEP },
+        {   2, LIGHT_SLEEP },
+        {   5, LIGHT_SLEEP },
+        {   6, RESTLESS },
+        {  15, RESTLESS },
+        {  16, WAKE },
+        { 255, WAKE },
+    };
+    sleep_telemetry_state_t state;
+
+    sleep_data_init(&state);
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) sleep_data_record_epoch(&state, rows[i].movements);
+
+    EXPECT_EQ(state.sleep_states.total_epochs, ARRAY_LEN(rows));
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        EXPECT_ROW_EQ(i, sleep_data_get_state_at_epoch(&state, (uint16_t)i), rows[i].state);
+    }
+}
+
+static void test_sleep_epoch_window(void) {
+    sleep_telemetry_state_t state;
+
+    sleep_data_init(&state);
+    for (uint16_t i = 0; i < 1000; i++) sleep_data_record_epoch(&state, (uint8_t)(i % 20));
+
+    EXPECT_EQ(state.sleep_states.total_epochs, 960);       // 8 h of 30 s epochs, then it stops
+    EXPECT_EQ(sleep_data_get_state_at_epoch(&state, 955), RESTLESS);  // 15 movements
+    EXPECT_EQ(sleep_data_get_state_at_epoch(&state, 959), WAKE);      // 19 movements
+    EXPECT_EQ(sleep_data_get_state_at_epoch(&state, 960), WAKE);      // out of range
+}
+
+static void test_sleep_restlessness(void) {
+    sleep_telemetry_state_t state;
+
+    sleep_data_init(&state);
+    EXPECT_EQ(sleep_data_calc_restlessness(&state), 0);
+
+    // 70 deep, 20 restless, 10 wake: movement part is (20 + 10) / 2.
+    for (uint8_t i = 0; i < 70; i++) sleep_data_record_epoch(&state, 0);
+    for (uint8_t i = 0; i < 20; i++) sleep_data_record_epoch(&state, 10);
+    for (uint8_t i = 0; i < 10; i++) sleep_data_record_epoch(&state, 20);
+    EXPECT_EQ(sleep_data_calc_restlessness(&state), 15);
+
+    state.wake_events.wake_count = 2;
+    state.wake_events.longest_wake_min = 45;
+    EXPECT_EQ(sleep_data_calc_restlessness(&state), 15 + 10 + 20);
+}
+
+// ============================================================================
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} _tests[] = {
+    { "circadian_duration", test_circadian_duration },
+    { "circadian_components", test_circadian_components },
+    { "circadian_sleep_score", test_circadian_sleep_score },
+    { "circadian_flash_roundtrip", test_circadian_flash_roundtrip },
+    { "storage_region_packing", test_storage_region_packing },
+    { "storage_region_survives_reorder", test_storage_region_survives_reorder },
+    { "storage_log_wear", test_storage_log_wear },
+    { "storage_log_recovery", test_storage_log_recovery },
+    { "storage_write_queue", test_storage_write_queue },
+    { "storage_log_append_async", test_storage_log_append_async },
+    { "storage_boot_claims", test_storage_boot_claims },
+    { "top_of_hour_saves", test_top_of_hour_saves },
+    { "rtc_comp_overdue_head", test_rtc_comp_overdue_head },
+    { "homebase_matches_reference", test_homebase_matches_reference },
+    { "homebase_presets", test_homebase_presets },
+    { "solar_matches_sunriset", test_solar_matches_sunriset },
+    { "solar_today", test_solar_today },
+    { "lunar_events", test_lunar_events },
+    { "lunar_matches_double", test_lunar_matches_double },
+    { "calendar_context", test_calendar_context },
+    { "phase_compute_table", test_phase_compute_table },
+    { "phase_compute_rejects_bad_input", test_phase_compute_rejects_bad_input },
+    { "phase_circadian_curve", test_phase_circadian_curve },
+    { "phase_learn_acrophase", test_phase_learn_acrophase },
+    { "phase_year_invariants", test_phase_year_invariants },
+    { "phase_hourly_history", test_phase_hourly_history },
+    { "phase_history_persistence", test_phase_history_persistence },
+    { "activity_baseline", test_activity_baseline },
+    { "metric_comfort_table", test_metric_comfort_table },
+    { "metric_em_table", test_metric_em_table },
+    { "metric_energy_table", test_metric_energy_table },
+    { "metric_wk_table", test_metric_wk_table },
+    { "metric_sd", test_metric_sd },
+    { "metric_jl", test_metric_jl },
+    { "metric_jl_held_shifts", test_metric_jl_held_shifts },
+    { "metrics_bkup_roundtrip", test_metrics_bkup_roundtrip },
+    { "metrics_dirty_tracking", test_metrics_dirty_tracking },
+    { "metric_cadence", test_metric_cadence },
+    { "sensors_update", test_sensors_update },
+    { "motion_stats", test_motion_stats },
+    { "activity_level", test_activity_level },
+    { "thermistor_c100", test_thermistor_c100 },
+    { "lis2dw_temperature_c100", test_lis2dw_temperature_c100 },
+    { "sensor_schedule", test_sensor_schedule },
+    { "sensors_fifo_batching", test_sensors_fifo_batching },
+    { "sleep_epoch_classification", test_sleep_epoch_classification },
+    { "sleep_epoch_window", test_sleep_epoch_window },
+    { "sleep_restlessness", test_sleep_restlessness },
+};
+
+int main(void) {
+    for (size_t i = 0; i < ARRAY_LEN(_tests); i++) {
+        unsigned failures_before = _failures;
+
+        _current_test = _tests[i].name;
+        host_fake_reset();
+        _tests[i].run();
+        printf("%-36s %s\n", _tests[i].name, _failures == failures_before ? "ok" : "FAILED");
+    }
+
+    printf("\n%u checks, %u failed\n", _checks, _failures);
+    return _failures ? 1 : 0;
+}
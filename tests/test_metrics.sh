@@ -55,24 +55,27 @@ void test_wk() {
     printf("Testing WK (Wake Momentum):\n");
     
     // Test 1: Normal mode with accelerometer
-    uint8_t wk_60min = metric_wk_compute(60, 500, true);
+    uint8_t wk_60min = metric_wk_compute(60, 500, 0, true);
     printf("  WK (accel) @ 60 min: %u (expect ~50)\n", wk_60min);
     
-    uint8_t wk_120min = metric_wk_compute(120, 500, true);
+    uint8_t wk_120min = metric_wk_compute(120, 500, 0, true);
     printf("  WK (accel) @ 120 min: %u (expect 100)\n", wk_120min);
     
-    uint8_t wk_120min_bonus = metric_wk_compute(120, 1500, true);
+    uint8_t wk_120min_bonus = metric_wk_compute(120, 1500, 0, true);
     printf("  WK (accel) @ 120 min + bonus: %u (expect 100, capped)\n", wk_120min_bonus);
     
+    uint8_t wk_60min_moving = metric_wk_compute(60, 0, 600, true);
+    printf("  WK (accel) @ 60 min, moving for the last hour: %u (expect ~80, bonus)\n", wk_60min_moving);
+    
     // Test 2: Fallback mode (no accelerometer)
-    uint8_t wk_90min_fallback = metric_wk_compute(90, 0, false);
+    uint8_t wk_90min_fallback = metric_wk_compute(90, 0, 0, false);
     printf("  WK (no accel) @ 90 min: %u (expect ~50)\n", wk_90min_fallback);
     
-    uint8_t wk_180min_fallback = metric_wk_compute(180, 0, false);
+    uint8_t wk_180min_fallback = metric_wk_compute(180, 0, 0, false);
     printf("  WK (no accel) @ 180 min: %u (expect 100)\n", wk_180min_fallback);
     
     // Test 3: Boundary - excessive time
-    uint8_t wk_overflow = metric_wk_compute(500, 0, true);
+    uint8_t wk_overflow = metric_wk_compute(500, 0, 0, true);
     printf("  WK @ 500 min: %u (expect 100, capped)\n", wk_overflow);
     
     printf("  ✓ WK tests passed\n\n");
@@ -82,25 +85,29 @@ void test_energy() {
     printf("Testing Energy (Derived Metric):\n");
     
     // Test 1: Normal mode with accelerometer
-    uint8_t energy_accel = metric_energy_compute(80, 20, 500, 14, true);
+    uint8_t energy_accel = metric_energy_compute(80, 20, 100, 500, 14, true);
     printf("  Energy (accel) phase=80, SD=20, activity=500: %u (expect ~70)\n", energy_accel);
     
     // Test 2: Fallback mode (no accelerometer)
-    uint8_t energy_fallback = metric_energy_compute(80, 20, 0, 14, false);
+    uint8_t energy_fallback = metric_energy_compute(80, 20, 100, 0, 14, false);
     printf("  Energy (no accel) phase=80, SD=20, hour=14: %u (expect ~60-70)\n", energy_fallback);
     
     // Test 3: Low phase + high SD = low energy
-    uint8_t energy_low = metric_energy_compute(30, 60, 0, 2, false);
+    uint8_t energy_low = metric_energy_compute(30, 60, 100, 0, 2, false);
     printf("  Energy low case phase=30, SD=60: %u (expect ~0-10)\n", energy_low);
     
     // Test 4: High phase + low SD = high energy
-    uint8_t energy_high = metric_energy_compute(90, 10, 1000, 14, true);
+    uint8_t energy_high = metric_energy_compute(90, 10, 100, 1000, 14, true);
     printf("  Energy high case phase=90, SD=10, activity=1000: %u (expect ~100, capped)\n", energy_high);
     
     // Test 5: Boundary - negative energy clamped to 0
-    uint8_t energy_negative = metric_energy_compute(0, 90, 0, 2, false);
+    uint8_t energy_negative = metric_energy_compute(0, 90, 100, 0, 2, false);
     printf("  Energy negative case phase=0, SD=90: %u (expect 0, clamped)\n", energy_negative);
     
+    // Test 6: Jet lag takes up to 20 points off
+    uint8_t energy_jet_lagged = metric_energy_compute(80, 20, 0, 500, 14, true);
+    printf("  Energy jet-lagged phase=80, SD=20, JL=0: %u (expect %u - 20)\n", energy_jet_lagged, energy_accel);
+    
     printf("  ✓ Energy tests passed\n\n");
 }
 
@@ -156,10 +156,10 @@ Motion Magnitude Formula:
   - Scaled to 0-1000 by dividing by 32
 
 Variance Computation:
-  variance = Σ(xi - mean)² / n
-  - Uses 5-sample circular buffer
+  mean += a·d; variance = (1 - a)·(variance + a·d²), d = xi - old mean
+  - Streaming, O(1) per sample; 5 min and 1 h horizons (mg²)
   - Integer math only (no FPU)
-  - Mean computed first, then sum of squared deviations
+  - a from the minutes each sample stands for, capped at 1/2
 
 Intensity Smoothing:
   intensity = 0.75 * prev + 0.25 * current
@@ -14,7 +14,8 @@ Usage:
     python3 generate_homebase.py --help
 
 Output:
-    lib/phase/homebase_table.h (C header with const arrays)
+    lib/phase/homebase_table.h (C header with compact const arrays,
+    decoded on demand by lib/phase/homebase.c)
 """
 
 import argparse
@@ -273,23 +274,13 @@ def calculate_seasonal_baseline(day_of_year, latitude):
     return int(max(0, min(100, baseline)))
 
 
-def generate_homebase_table(latitude, longitude, timezone_offset, year, output_path, tz_string="N/A", skip_api=False):
+def build_entries(latitude, longitude, year, skip_api=False):
     """
-    Generate homebase_table.h with 365 days of seasonal data.
-    
-    Args:
-        latitude: Latitude in degrees (-90 to 90)
-        longitude: Longitude in degrees (-180 to 180)
-        timezone_offset: Timezone offset in minutes (e.g., -480 for PST)
-        year: Year for generation (informational only)
-        output_path: Path to output .h file
-        tz_string: Original timezone string for display purposes
-        skip_api: If True, skip API and use sinusoidal fallback
+    Compute 365 days of (daylight_minutes, temp_c10, seasonal_baseline).
+
+    Returns:
+        (entries, elevation_text, data_source)
     """
-    # Convert coordinates to scaled integers for metadata
-    lat_e6 = int(latitude * 1_000_000)
-    lon_e6 = int(longitude * 1_000_000)
-    
     # Estimate base temperature from latitude (rough approximation)
     # Tropical: ~25°C, Temperate: ~15°C, Polar: ~0°C
     base_temp = 25 - abs(latitude) * 0.4
@@ -339,69 +330,160 @@ def generate_homebase_table(latitude, longitude, timezone_offset, year, output_p
         baseline = calculate_seasonal_baseline(day, latitude)
         entries.append((daylight_min, temp_c10, baseline))
     
-    # Generate C header file
+    return entries, elevation_text, data_source
+
+
+# Compact encoding, mirrored by homebase_field_decode() in lib/phase/homebase.c:
+# exact knots every KNOT_SPACING days plus day 365, linear interpolation between
+# them (C integer division, truncating toward zero), and a packed signed residual
+# per day that makes every day exact.
+KNOT_SPACING = 16
+KNOT_DAYS = list(range(0, 365, KNOT_SPACING)) + [364]
+MAX_RESIDUAL_BITS = 8
+
+
+def c_div(a, b):
+    """Integer division truncating toward zero, like C."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b > 0) else -q
+
+
+def interpolate(knots, day_index):
+    k = min(day_index // KNOT_SPACING, len(KNOT_DAYS) - 2)
+    span = KNOT_DAYS[k + 1] - KNOT_DAYS[k]
+    return knots[k] + c_div((knots[k + 1] - knots[k]) * (day_index - KNOT_DAYS[k]), span)
+
+
+def encode_field(values):
+    """
+    Encode 365 values as knots, residual width and packed residual bytes.
+    Raises ValueError if a residual doesn't fit in MAX_RESIDUAL_BITS
+    (day-to-day noise too large for this scheme).
+    """
+    knots = [values[d] for d in KNOT_DAYS]
+    residuals = [values[i] - interpolate(knots, i) for i in range(365)]
+    
+    lo, hi = min(residuals), max(residuals)
+    bits = 0 if lo == hi == 0 else 1
+    while bits and (lo < -(1 << (bits - 1)) or hi > (1 << (bits - 1)) - 1):
+        bits += 1
+        if bits > MAX_RESIDUAL_BITS:
+            raise ValueError(f"residuals {lo}..{hi} need more than {MAX_RESIDUAL_BITS} bits")
+    
+    packed = bytearray((365 * bits + 7) // 8 + 1)  # +1: the decoder reads two bytes at a time
+    for i, r in enumerate(residuals):
+        raw = r & ((1 << bits) - 1)
+        bit = i * bits
+        packed[bit >> 3] |= (raw << (bit & 7)) & 0xff
+        if (bit & 7) + bits > 8:
+            packed[(bit >> 3) + 1] |= raw >> (8 - (bit & 7))
+    
+    return knots, bits, bytes(packed)
+
+
+def c_identifier(name):
+    words = ''.join(c if c.isalnum() else ' ' for c in name.lower()).split()
+    return '_'.join(words)
+
+
+def format_field(ident, field_name, knots, bits, packed):
+    """C initializer for one homebase_field_t, plus its residual array (or None)."""
+    array = None
+    residuals_ref = "NULL"
+    if bits:
+        array_name = f"{ident}_{field_name}_residuals"
+        lines = []
+        for i in range(0, len(packed), 12):
+            lines.append("    " + ", ".join(f"0x{b:02x}" for b in packed[i:i + 12]) + ",")
+        array = f"static const uint8_t {array_name}[{len(packed)}] = {{\n" + "\n".join(lines) + "\n};\n"
+        residuals_ref = array_name
+    knot_text = ", ".join(str(k) for k in knots)
+    init = (f"        .{field_name} = {{\n"
+            f"            .knots = {{{knot_text}}},\n"
+            f"            .residual_bits = {bits},\n"
+            f"            .residuals = {residuals_ref},\n"
+            f"        }},\n")
+    return init, array
+
+
+def generate_homebase_table(locations, year, output_path, skip_api=False):
+    """
+    Generate homebase_table.h with one compact preset per location.
+    
+    Args:
+        locations: List of dicts with name, lat, lon, tz_offset and tz_string.
+                   The first one is selected at boot.
+        year: Year for generation (informational only)
+        output_path: Path to output .h file
+        skip_api: If True, skip API and use sinusoidal fallback
+    """
     timestamp = datetime.now().strftime("%Y-%m-%d %H:%M:%S")
+    comments = []
+    arrays = []
+    presets = []
+    stats = []
+    data_bytes = 0
+    
+    for location in locations:
+        latitude, longitude = location['lat'], location['lon']
+        timezone_offset = location['tz_offset']
+        print(f"\n📍 {location['name']}")
+        entries, elevation_text, data_source = build_entries(latitude, longitude, year, skip_api)
+        
+        ident = c_identifier(location['name'])
+        fields = ""
+        for field_name, column in (('daylight', 0), ('temp', 1), ('baseline', 2)):
+            knots, bits, packed = encode_field([e[column] for e in entries])
+            init, array = format_field(ident, field_name, knots, bits, packed)
+            fields += init
+            if array:
+                arrays.append(array)
+                data_bytes += len(packed)
+            data_bytes += 2 * len(knots) + 8
+        
+        comments.append(f""" * {location['name']}:
+ *   Latitude: {latitude:.4f}°{'N' if latitude >= 0 else 'S'}
+ *   Longitude: {longitude:.4f}°{'E' if longitude >= 0 else 'W'}
+ *   Location elevation: {elevation_text}
+ *   Timezone offset: {timezone_offset} minutes (UTC{timezone_offset//60:+d})
+ *   Temperature data source: {data_source}""")
+        
+        presets.append(f"""    {{
+        .name = "{location['name']}",
+        .metadata = {{
+            .latitude_e6 = {int(latitude * 1_000_000)},
+            .longitude_e6 = {int(longitude * 1_000_000)},
+            .timezone_offset = {timezone_offset},
+            .year = {year},
+            .entry_count = 365
+        }},
+{fields}    }},
+""")
+        stats.append((location, entries))
     
     header = f"""/*
  * GENERATED FILE - DO NOT EDIT MANUALLY
  * 
  * Generated by: utils/generate_homebase.py
  * Generation time: {timestamp}
- * 
- * Homebase configuration:
- * Latitude: {latitude:.4f}°{'N' if latitude >= 0 else 'S'}
- * Longitude: {longitude:.4f}°{'E' if longitude >= 0 else 'W'}
- * Location elevation: {elevation_text}
- * Timezone offset: {timezone_offset} minutes (UTC{timezone_offset//60:+d})
  * Year: {year}
- * Temperature data source: {data_source}
+ * 
+ * Homebase presets (the first is selected at boot):
+{chr(10).join(comments)}
+ *
+ * Included only by homebase.c; see homebase.h for the encoding.
  */
 
 #ifndef HOMEBASE_TABLE_H_
 #define HOMEBASE_TABLE_H_
 
-#include "phase_engine.h"
+#include "homebase.h"
 
 #ifdef PHASE_ENGINE_ENABLED
 
-// Homebase metadata
-static const homebase_metadata_t homebase_metadata = {{
-    .latitude_e6 = {lat_e6},
-    .longitude_e6 = {lon_e6},
-    .timezone_offset = {timezone_offset},
-    .year = {year},
-    .entry_count = 365
-}};
-
-// Homebase table (365 entries, one per day of year)
-// Entry format: {{daylight_minutes, temp_c10, seasonal_baseline}}
-static const homebase_entry_t homebase_table[365] = {{
-"""
-    
-    # Write entries in groups of 4 for readability
-    for i, (daylight, temp, baseline) in enumerate(entries, 1):
-        if (i - 1) % 4 == 0:
-            header += "    "
-        header += f"{{{daylight}, {temp}, {baseline}}}"
-        if i < 365:
-            header += ", "
-        if i % 4 == 0 and i < 365:
-            header += f" // Days {i-3}-{i}\n"
-    
-    header += """  // Day 365
-};
-
-// Accessor functions (static inline to avoid linker errors)
-static inline const homebase_entry_t* homebase_get_entry(uint16_t day_of_year) {
-    if (day_of_year < 1 || day_of_year > 365) {
-        return &homebase_table[0];  // Safe fallback
-    }
-    return &homebase_table[day_of_year - 1];
-}
-
-static inline const homebase_metadata_t* homebase_get_metadata(void) {
-    return &homebase_metadata;
-}
+{chr(10).join(arrays)}
+static const homebase_preset_t homebase_presets[] = {{
+{''.join(presets)}}};
 
 #endif // PHASE_ENGINE_ENABLED
 
@@ -413,64 +495,64 @@ static inline const homebase_metadata_t* homebase_get_metadata(void) {
     output_path.write_text(header)
     
     # Calculate detailed statistics
-    table_data_bytes = len(entries) * 6  # 3 uint16_t per entry = 6 bytes
-    metadata_bytes = 16  # homebase_metadata_t struct size
+    uncompressed_bytes = len(locations) * 365 * 6  # one padded homebase_entry_t per day
     total_code_bytes = len(header)
     
-    # Daylight statistics
-    daylight_values = [e[0] for e in entries]
-    min_daylight = min(daylight_values)
-    max_daylight = max(daylight_values)
-    avg_daylight = sum(daylight_values) // len(daylight_values)
-    
-    # Temperature statistics
-    temp_values = [e[1] for e in entries]
-    min_temp = min(temp_values) / 10.0
-    max_temp = max(temp_values) / 10.0
-    avg_temp = sum(temp_values) / len(temp_values) / 10.0
-    
     # Print enhanced statistics
     print("=" * 70)
     print("PHASE ENGINE HOMEBASE TABLE GENERATION COMPLETE")
     print("=" * 70)
-    print(f"\n📍 LOCATION:")
-    print(f"   Latitude:  {latitude:+8.4f}° {'N' if latitude >= 0 else 'S'}")
-    print(f"   Longitude: {longitude:+8.4f}° {'E' if longitude >= 0 else 'W'}")
-    print(f"   Timezone:  UTC{timezone_offset//60:+d} ({tz_string})")
-    print(f"   Year:      {year}")
-    
-    print(f"\n📊 DAYLIGHT STATISTICS:")
-    print(f"   Shortest day: {min_daylight:3d} minutes ({min_daylight//60:2d}h {min_daylight%60:02d}m)")
-    print(f"   Longest day:  {max_daylight:3d} minutes ({max_daylight//60:2d}h {max_daylight%60:02d}m)")
-    print(f"   Average:      {avg_daylight:3d} minutes ({avg_daylight//60:2d}h {avg_daylight%60:02d}m)")
-    print(f"   Variation:    {max_daylight - min_daylight:3d} minutes")
-    
-    print(f"\n🌡️  TEMPERATURE RANGE:")
-    print(f"   Minimum: {min_temp:5.1f}°C ({min_temp*9/5+32:5.1f}°F)")
-    print(f"   Maximum: {max_temp:5.1f}°C ({max_temp*9/5+32:5.1f}°F)")
-    print(f"   Average: {avg_temp:5.1f}°C ({avg_temp*9/5+32:5.1f}°F)")
+    
+    for location, entries in stats:
+        latitude, longitude = location['lat'], location['lon']
+        timezone_offset = location['tz_offset']
+        print(f"\n📍 LOCATION: {location['name']}")
+        print(f"   Latitude:  {latitude:+8.4f}° {'N' if latitude >= 0 else 'S'}")
+        print(f"   Longitude: {longitude:+8.4f}° {'E' if longitude >= 0 else 'W'}")
+        print(f"   Timezone:  UTC{timezone_offset//60:+d} ({location['tz_string']})")
+        print(f"   Year:      {year}")
+        
+        # Daylight statistics
+        daylight_values = [e[0] for e in entries]
+        min_daylight = min(daylight_values)
+        max_daylight = max(daylight_values)
+        avg_daylight = sum(daylight_values) // len(daylight_values)
+        
+        # Temperature statistics
+        temp_values = [e[1] for e in entries]
+        min_temp = min(temp_values) / 10.0
+        max_temp = max(temp_values) / 10.0
+        avg_temp = sum(temp_values) / len(temp_values) / 10.0
+        
+        print(f"\n📊 DAYLIGHT STATISTICS:")
+        print(f"   Shortest day: {min_daylight:3d} minutes ({min_daylight//60:2d}h {min_daylight%60:02d}m)")
+        print(f"   Longest day:  {max_daylight:3d} minutes ({max_daylight//60:2d}h {max_daylight%60:02d}m)")
+        print(f"   Average:      {avg_daylight:3d} minutes ({avg_daylight//60:2d}h {avg_daylight%60:02d}m)")
+        print(f"   Variation:    {max_daylight - min_daylight:3d} minutes")
+        
+        print(f"\n🌡️  TEMPERATURE RANGE:")
+        print(f"   Minimum: {min_temp:5.1f}°C ({min_temp*9/5+32:5.1f}°F)")
+        print(f"   Maximum: {max_temp:5.1f}°C ({max_temp*9/5+32:5.1f}°F)")
+        print(f"   Average: {avg_temp:5.1f}°C ({avg_temp*9/5+32:5.1f}°F)")
+        
+        # Sample data points
+        print(f"\n📅 SAMPLE DATA POINTS:")
+        print(f"   {'Day':>4} │ {'Daylight':>12} │ {'Temperature':>12} │ {'Baseline':>8}")
+        print(f"   ─────┼──────────────┼──────────────┼──────────")
+        for day in [1, 90, 180, 270, 365]:
+            daylight, temp, baseline = entries[day - 1]
+            hr, mn = divmod(daylight, 60)
+            print(f"   {day:4d} │ {hr:2d}h {mn:02d}m ({daylight:3d}m) │ "
+                  f"{temp/10:5.1f}°C ({temp/10*9/5+32:5.1f}°F) │ {baseline:3d}/100")
     
     print(f"\n💾 FLASH MEMORY IMPACT:")
-    print(f"   Table data:   {table_data_bytes:5d} bytes (365 entries × 6 bytes)")
-    print(f"   Metadata:     {metadata_bytes:5d} bytes")
-    print(f"   Total header: {total_code_bytes:5d} bytes (includes accessor functions)")
-    print(f"   ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━")
-    print(f"   TOTAL ADDED:  {table_data_bytes + metadata_bytes:5d} bytes to firmware")
+    print(f"   Table data:   {data_bytes:5d} bytes ({len(locations)} preset(s), compact)")
+    print(f"   Uncompressed: {uncompressed_bytes:5d} bytes (365 entries × 6 bytes per preset)")
     
     print(f"\n📄 OUTPUT:")
     print(f"   File: {output_path}")
     print(f"   Size: {total_code_bytes:,} bytes")
     
-    # Sample data points
-    print(f"\n📅 SAMPLE DATA POINTS:")
-    print(f"   {'Day':>4} │ {'Daylight':>12} │ {'Temperature':>12} │ {'Baseline':>8}")
-    print(f"   ─────┼──────────────┼──────────────┼──────────")
-    for day in [1, 90, 180, 270, 365]:
-        daylight, temp, baseline = entries[day - 1]
-        hr, mn = divmod(daylight, 60)
-        print(f"   {day:4d} │ {hr:2d}h {mn:02d}m ({daylight:3d}m) │ "
-              f"{temp/10:5.1f}°C ({temp/10*9/5+32:5.1f}°F) │ {baseline:3d}/100")
-    
     print("\n" + "=" * 70)
     print("✓ Homebase table ready for build")
     print("=" * 70)
@@ -541,6 +623,9 @@ Examples:
   
   # Tokyo
   python3 generate_homebase.py --lat 35.6762 --lon 139.6503 --tz UTC+9 --year 2026
+  
+  # Several presets, switchable at runtime with homebase_select_preset()
+  python3 generate_homebase.py --city anchorage --city portland --city ny --year 2026
         """
     )
     
@@ -550,8 +635,9 @@ Examples:
                         help='Longitude in degrees (-180 to 180)')
     parser.add_argument('--tz', type=str,
                         help='Timezone (AKST, PST, EST, HST, UTC+X, or minutes offset)')
-    parser.add_argument('--city', choices=list(CITY_PRESETS.keys()),
-                        help='Use preset coordinates for common cities (anchorage, portland, dallas, ny)')
+    parser.add_argument('--city', choices=list(CITY_PRESETS.keys()), action='append', default=[],
+                        help='Use preset coordinates for common cities (anchorage, portland, dallas, ny). '
+                             'Repeat to build several presets into the firmware; the first is selected at boot')
     parser.add_argument('--year', type=int, default=2026,
                         help='Year for generation (default: 2026, range: 2000-2099)')
     parser.add_argument('--output', type=Path,
@@ -562,19 +648,23 @@ Examples:
     
     args = parser.parse_args()
     
-    # Apply city preset if specified
-    if args.city:
-        preset = CITY_PRESETS[args.city]
-        if args.lat is None:
-            args.lat = preset['lat']
-        if args.lon is None:
-            args.lon = preset['lon']
-        if args.tz is None:
-            args.tz = preset['tz']
+    # Build the location list: --lat/--lon/--tz describe the first location, or
+    # override the first --city; every further --city adds a preset.
+    locations = [dict(CITY_PRESETS[city]) for city in args.city]
+    for preset in locations:
         print(f"Using preset: {preset['name']}")
+    if args.lat is not None and args.lon is not None and not args.city:
+        locations.insert(0, {'name': 'Homebase', 'lat': args.lat, 'lon': args.lon, 'tz': args.tz})
+    elif locations:
+        if args.lat is not None:
+            locations[0]['lat'] = args.lat
+        if args.lon is not None:
+            locations[0]['lon'] = args.lon
+    if locations and args.tz is not None:
+        locations[0]['tz'] = args.tz
     
     # Validate that we have lat/lon/tz (either from args or preset)
-    if args.lat is None or args.lon is None or args.tz is None:
+    if not locations or any(location['tz'] is None for location in locations):
         print("Error: Must provide either --city or all of --lat, --lon, and --tz", file=sys.stderr)
         return 1
     
@@ -587,23 +677,29 @@ Examples:
         print("Note: This limitation is due to Sensor Watch RTC hardware constraints.", file=sys.stderr)
         return 1
     
-    if not -90 <= args.lat <= 90:
-        print(f"Error: Latitude must be in range [-90, 90], got {args.lat}", file=sys.stderr)
-        return 1
-    
-    if not -180 <= args.lon <= 180:
-        print(f"Error: Longitude must be in range [-180, 180], got {args.lon}", file=sys.stderr)
-        return 1
+    for location in locations:
+        if not -90 <= location['lat'] <= 90:
+            print(f"Error: Latitude must be in range [-90, 90], got {location['lat']}", file=sys.stderr)
+            return 1
+        
+        if not -180 <= location['lon'] <= 180:
+            print(f"Error: Longitude must be in range [-180, 180], got {location['lon']}", file=sys.stderr)
+            return 1
+        
+        try:
+            location['tz_offset'] = parse_timezone(location['tz'])
+        except ValueError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            return 1
+        location['tz_string'] = location['tz']
     
+    # Generate table
     try:
-        tz_offset = parse_timezone(args.tz)
+        generate_homebase_table(locations, args.year, args.output, args.skip_api)
     except ValueError as e:
         print(f"Error: {e}", file=sys.stderr)
         return 1
     
-    # Generate table
-    generate_homebase_table(args.lat, args.lon, tz_offset, args.year, args.output, args.tz, args.skip_api)
-    
     return 0
 
 
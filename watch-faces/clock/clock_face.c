@@ -105,9 +105,16 @@ static void clock_check_battery_periodically(clock_state_t *state, watch_date_ti
     clock_indicate_low_available_power(state);
 }
 
+static void clock_update_background_wake(clock_state_t *state) {
+    // time zone offsets are multiples of 15 minutes, so waking every quarter hour always catches the local top of the hour.
+    if (state->time_signal_enabled) movement_set_background_wake_interval(state->watch_face_index, 15);
+    else movement_set_background_wake_never(state->watch_face_index);
+}
+
 static void clock_toggle_time_signal(clock_state_t *state) {
     state->time_signal_enabled = !state->time_signal_enabled;
     clock_indicate_time_signal(state);
+    clock_update_background_wake(state);
 }
 
 static void clock_display_all(watch_date_time_t date_time) {
@@ -207,14 +214,14 @@ static void clock_stop_tick_tock_animation(void) {
 }
 
 void clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
-
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(clock_state_t));
         clock_state_t *state = (clock_state_t *) *context_ptr;
         state->time_signal_enabled = false;
         state->watch_face_index = watch_face_index;
     }
+
+    clock_update_background_wake((clock_state_t *) *context_ptr);
 }
 
 void clock_face_activate(void *context) {
@@ -256,6 +263,7 @@ bool clock_face_loop(movement_event_t event, void *context) {
             clock_toggle_time_signal(state);
             break;
         case EVENT_BACKGROUND_TASK:
+            if (movement_get_local_date_time().unit.minute != 0) break;
             // uncomment this line to snap back to the clock face when the hour signal sounds:
             // movement_move_to_face(state->watch_face_index);
             movement_play_signal();
@@ -91,13 +91,14 @@ static const int32_t clock_mapping[6][7][2] = {
 };
 
 void wyoscan_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(wyoscan_state_t));
         memset(*context_ptr, 0, sizeof(wyoscan_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
     // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
+    // Nothing is drawn in low energy mode, so Movement doesn't need to wake up for us.
+    movement_set_low_energy_update_interval(watch_face_index, 0);
 }
 
 void wyoscan_face_activate(void *context) {
@@ -160,6 +160,14 @@ static void _alarm_resume_setting(alarm_state_t *state, uint8_t subsecond) {
     _advanced_alarm_face_draw(state, subsecond);
 }
 
+static void _alarm_update_background_wake(alarm_state_t *state) {
+    // only have our advise function polled while there's an alarm that could go off.
+    bool any_enabled = false;
+    for (uint8_t i = 0; i < ALARM_ALARMS; i++) any_enabled |= state->alarm[i].enabled;
+    if (any_enabled) movement_set_background_wake_advise(state->watch_face_index);
+    else movement_set_background_wake_never(state->watch_face_index);
+}
+
 static void _alarm_update_alarm_enabled(alarm_state_t *state) {
     // save indication for active alarms to movement settings
     bool active_alarms = false;
@@ -198,6 +206,7 @@ static void _alarm_update_alarm_enabled(alarm_state_t *state) {
         }
     }
     movement_set_alarm_enabled(active_alarms);
+    _alarm_update_background_wake(state);
 }
 
 static void _alarm_play_short_beep(uint8_t pitch_idx) {
@@ -235,8 +244,6 @@ static void _abort_quick_ticks(alarm_state_t *state) {
 }
 
 void advanced_alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
-    (void) watch_face_index;
-
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(alarm_state_t));
         alarm_state_t *state = (alarm_state_t *)*context_ptr;
@@ -248,6 +255,7 @@ void advanced_alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
             state->alarm[i].pitch = 1;
         }
         state->alarm_handled_minute = -1;
+        state->watch_face_index = watch_face_index;
         _wait_ticks = -1;
 
         if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
@@ -259,11 +267,14 @@ void advanced_alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
             _buzzer_segdata[2][1] = 10;
         }
     }
+    _alarm_update_background_wake((alarm_state_t *)*context_ptr);
 }
 
 void advanced_alarm_face_activate(void *context) {
-    (void) context;
+    alarm_state_t *state = (alarm_state_t *)context;
     watch_set_colon();
+    // alarms can be switched on at any time while we're on screen; resign works out whether we still need polling.
+    movement_set_background_wake_advise(state->watch_face_index);
 }
 
 void advanced_alarm_face_resign(void *context) {
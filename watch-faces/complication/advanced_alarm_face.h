@@ -79,6 +79,7 @@ typedef struct {
     uint8_t alarm_playing_idx : 4;
     uint8_t setting_state : 3;
     int8_t alarm_handled_minute;
+    uint8_t watch_face_index;
     bool alarm_quick_ticks : 1;
     bool is_setting : 1;
     alarm_setting_t alarm[ALARM_ALARMS];
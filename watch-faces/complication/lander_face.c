@@ -75,8 +75,8 @@
 #define FUEL_SCORE_GREAT 131
 #define FUEL_SCORE_FANTASTIC 125
 
-// Joey Castillo to oversee storage allocation row
-#define LANDER_STORAGE_ROW 2
+#define LANDER_STORAGE_REGION "lander"
+#define LANDER_STORAGE_SIZE 3
 #define STORAGE_KEY_NUMBER 110
 
 #define DIFFICULTY_LEVELS	3
@@ -128,13 +128,11 @@ static uint8_t assignProb ( uint8_t lowerProb, uint8_t upperProb, int16_t lowerS
 }
 
 static void write_to_lander_EEPROM(lander_state_t *state) {
-    uint8_t output_array [ 3 ];
+    uint8_t output_array [ LANDER_STORAGE_SIZE ];
     output_array [ 0 ] = STORAGE_KEY_NUMBER;
     output_array [ 1 ] = state->hero_counter;
     output_array [ 2 ] = state->legend_counter;
-    watch_storage_erase ( LANDER_STORAGE_ROW );
-    watch_storage_sync ( );
-    watch_storage_write ( LANDER_STORAGE_ROW, 0, output_array, 3 );
+    watch_storage_region_write ( state->storage, output_array );
 }
 		
 // ---------------------------
@@ -148,6 +146,8 @@ void lander_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         lander_state_t *state = (lander_state_t *)*context_ptr;
         state->led_enabled = false;
     }
+    lander_state_t *state = (lander_state_t *)*context_ptr;
+    state->storage = watch_storage_region_claim ( LANDER_STORAGE_REGION, LANDER_STORAGE_SIZE );
     // Emulator only: Seed random number generator
     #if __EMSCRIPTEN__
     srand(time(NULL));
@@ -161,12 +161,9 @@ void lander_face_activate(void *context) {
     state->led_active = false;
     state->reset_counter = 0;
     watch_clear_all_indicators ( );
-    uint32_t offset = 0;
-    uint32_t size = 3;
-    uint8_t stored_data [ size ];		
+    uint8_t stored_data [ LANDER_STORAGE_SIZE ];
     // See if the hero_counter was ever written to EEPROM storage
-    watch_storage_read (LANDER_STORAGE_ROW, offset, stored_data, size);
-    if (stored_data[0] == STORAGE_KEY_NUMBER )
+    if ( watch_storage_region_read ( state->storage, stored_data ) && stored_data[0] == STORAGE_KEY_NUMBER )
     {
         state->hero_counter = stored_data [1]; // There's real data in there.
         state->legend_counter = stored_data [2];
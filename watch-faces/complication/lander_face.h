@@ -134,6 +134,7 @@ typedef struct {
     uint8_t monster_type;      // Which monster is hungry?
     uint8_t uninjured;         // OK survivors
     uint8_t injured;           // Hurt survivors
+    const watch_storage_region_t *storage;  // Where the counters live
 } lander_state_t;
 
 void lander_face_setup(uint8_t watch_face_index, void ** context_ptr);
@@ -30,6 +30,7 @@ static void _minimal_phase_face_update_display(minimal_phase_state_t *state) {
     // Compute current phase score
     uint16_t phase_score = phase_compute(&state->phase,
                                          hour,
+                                         now.unit.minute,
                                          day_of_year,
                                          activity_level,
                                          temp_c10,
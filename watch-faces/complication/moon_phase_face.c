@@ -30,23 +30,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <math.h>
 #include "moon_phase_face.h"
 #include "watch_utility.h"
-
-#define LUNAR_DAYS 29.53058770576
-#define LUNAR_SECONDS (LUNAR_DAYS * (24 * 60 * 60))
-#define FIRST_MOON 947182440 // Saturday, 6 January 2000 18:14:00 in unix epoch time
-#define NUM_PHASES 8
-
-static const float phase_changes[] = {0, 1, 6.38264692644, 8.38264692644, 13.76529385288, 15.76529385288, 21.14794077932, 23.14794077932, 28.53058770576, 29.53058770576};
+#include "lunar.h"
 
 void moon_phase_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(moon_phase_state_t));
         memset(*context_ptr, 0, sizeof(moon_phase_state_t));
     }
+    // in low energy mode we only redraw at the top of the hour.
+    movement_set_low_energy_update_interval(watch_face_index, 60);
 }
 
 void moon_phase_face_activate(void *context) {
@@ -59,32 +53,26 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
     watch_date_time_t date_time = watch_rtc_get_date_time();
     uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset()) + offset;
     date_time = watch_utility_date_time_from_unix_time(now, movement_get_current_timezone_offset());
-    double currentfrac = fmod(now - FIRST_MOON, LUNAR_SECONDS) / LUNAR_SECONDS;
-    double currentday = currentfrac * LUNAR_DAYS;
-    uint8_t phase_index = 0;
-
-    for(phase_index = 0; phase_index <= NUM_PHASES; phase_index++) {
-        if (currentday > phase_changes[phase_index] && currentday <= phase_changes[phase_index + 1]) break;
-    }
+    lunar_phase_t moon;
+    lunar_compute(now, &moon);
 
     sprintf(buf, "%2d", date_time.unit.day);
     watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    switch (phase_index) {
-        case 0:
-        case 8:
+    switch (moon.name) {
+        case LUNAR_NEW:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "NE!J  ", " Neu  ");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "   ", "  ");
             break;
-        case 1:
+        case LUNAR_WAXING_CRESCENT:
             watch_display_text(WATCH_POSITION_BOTTOM, "CresNt");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAX", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
                 watch_set_pixel(2, 13);
                 watch_set_pixel(2, 15);
-                if (currentfrac > 0.125) watch_set_pixel(1, 13);
+                if (moon.fraction > 8192) watch_set_pixel(1, 13);          // past 1/8 of the cycle
             }
             break;
-        case 2:
+        case LUNAR_FIRST_QUARTER:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "1stQtr", " 1st q");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAX", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -94,7 +82,7 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
                 watch_set_pixel(1, 14);
             }
             break;
-        case 3:
+        case LUNAR_WAXING_GIBBOUS:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "GbboUs", " Gibb ");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAX", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -105,7 +93,7 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
                 watch_set_pixel(1, 15);
             }
             break;
-        case 4:
+        case LUNAR_FULL:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "FULL  ", " FULL ");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "   ", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -119,7 +107,7 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
                 watch_set_pixel(1, 13);
             }
             break;
-        case 5:
+        case LUNAR_WANING_GIBBOUS:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "GbboUs", " Gibb ");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAN", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -130,7 +118,7 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
                 watch_set_pixel(0, 13);
             }
             break;
-        case 6:
+        case LUNAR_LAST_QUARTER:
             watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "3rdQtr", " 3rd q");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAN", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -140,13 +128,13 @@ static void _update(moon_phase_state_t *state, uint32_t offset) {
                 watch_set_pixel(0, 13);
             }
             break;
-        case 7:
+        case LUNAR_WANING_CRESCENT:
             watch_display_text(WATCH_POSITION_BOTTOM, "CresNt");
             watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "WAN", "  ");
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
                 watch_set_pixel(0, 14);
                 watch_set_pixel(0, 13);
-                if (currentfrac < 0.875) watch_set_pixel(2, 14);
+                if (moon.fraction < 57344) watch_set_pixel(2, 14);         // before 7/8 of the cycle
             }
             break;
     }
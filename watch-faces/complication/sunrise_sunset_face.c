@@ -27,13 +27,12 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 #include "sunrise_sunset_face.h"
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_common_display.h"
 #include "filesystem.h"
-#include "sunriset.h"
+#include "solar.h"
 
 #if __EMSCRIPTEN__
 #include <emscripten.h>
@@ -63,9 +62,17 @@ static void _sunrise_sunset_set_expiration(sunrise_sunset_state_t *state, watch_
     state->rise_set_expires = watch_utility_date_time_from_unix_time(timestamp + 60, 0);
 }
 
+// minutes after midnight of `day` (possibly negative, or past midnight) as a date and time.
+static watch_date_time_t _sunrise_sunset_face_time_on_day(watch_date_time_t day, int16_t minutes) {
+    day.unit.hour = 0;
+    day.unit.minute = 0;
+    day.unit.second = 0;
+    uint32_t timestamp = watch_utility_date_time_to_unix_time(day, 0);
+    return watch_utility_date_time_from_unix_time(timestamp + (int32_t)minutes * 60, 0);
+}
+
 static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
     char buf[14];
-    double rise, set, minutes, seconds;
     bool show_next_match = false;
     movement_location_t movement_location;
     if (state->longLatToUse == 0 || _location_count <= 1)
@@ -82,33 +89,27 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
     }
 
     watch_date_time_t date_time = movement_get_local_date_time(); // the current local date / time
+    watch_date_time_t day = date_time; // the day we're computing rise and set for
     watch_date_time_t scratch_time; // scratchpad, contains different values at different times
-    scratch_time.reg = date_time.reg;
-
-    // Weird quirky unsigned things were happening when I tried to cast these directly to doubles below.
-    // it looks redundant, but extracting them to local int16's seemed to fix it.
-    int16_t lat_centi = (int16_t)movement_location.bit.latitude;
-    int16_t lon_centi = (int16_t)movement_location.bit.longitude;
 
-    double lat = (double)lat_centi / 100.0;
-    double lon = (double)lon_centi / 100.0;
-
-    // sunriset returns the rise/set times as signed decimal hours in UTC.
-    // this can mean hours below 0 or above 31, which won't fit into a watch_date_time_t struct.
-    // to deal with this, we set aside the offset in hours, and add it back before converting it to a watch_date_time_t.
-    double hours_from_utc = ((double)movement_get_current_timezone_offset()) / 3600.0;
+    // solar_compute returns the rise/set times in local minutes after midnight of `day`.
+    // this can mean minutes below 0 or past 1440, so they're carried into the right day before display.
+    int32_t utc_offset = movement_get_current_timezone_offset();
 
     // we loop twice because if it's after sunset today, we need to recalculate to display values for tomorrow.
     for(int i = 0; i < 2; i++) {
-        uint8_t result = sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &rise, &set);
+        solar_times_t times;
+        int8_t result = solar_compute(day.unit.year + WATCH_RTC_REFERENCE_YEAR, day.unit.month, day.unit.day,
+                                      movement_location.bit.latitude, movement_location.bit.longitude,
+                                      utc_offset, &times);
 
-        if (result != 0) {
+        if (result != SOLAR_RISES_AND_SETS) {
             watch_clear_colon();
             watch_clear_indicator(WATCH_INDICATOR_PM);
             watch_clear_indicator(WATCH_INDICATOR_24H);
-            if (result == 1) watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "SET", "SE");
+            if (result == SOLAR_ALWAYS_UP) watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "SET", "SE");
             else watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "RIS", "rI");
-            sprintf(buf, "%2d", scratch_time.unit.day);
+            sprintf(buf, "%2d", day.unit.day);
             watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
             watch_display_text(WATCH_POSITION_BOTTOM, "None  ");
             return;
@@ -117,28 +118,7 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
         watch_set_colon();
         if (movement_clock_mode_24h()) watch_set_indicator(WATCH_INDICATOR_24H);
 
-        rise += hours_from_utc;
-        set += hours_from_utc;
-
-        minutes = 60.0 * fmod(rise, 1);
-        seconds = 60.0 * fmod(minutes, 1);
-        scratch_time.unit.hour = floor(rise);
-        if (seconds < 30) scratch_time.unit.minute = floor(minutes);
-        else scratch_time.unit.minute = ceil(minutes);
-
-        // Handle hour overflow from timezone conversion
-        while (scratch_time.unit.hour >= 24) {
-            scratch_time.unit.hour -= 24;
-            // Increment day (this will be handled by the date arithmetic)
-            uint32_t timestamp = watch_utility_date_time_to_unix_time(scratch_time, 0);
-            timestamp += 86400;
-            scratch_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-        }
-
-        if (scratch_time.unit.minute == 60) {
-            scratch_time.unit.minute = 0;
-            scratch_time.unit.hour = (scratch_time.unit.hour + 1) % 24;
-        }
+        scratch_time = _sunrise_sunset_face_time_on_day(day, times.sunrise_min);
 
         if (date_time.reg < scratch_time.reg) _sunrise_sunset_set_expiration(state, scratch_time);
 
@@ -159,25 +139,7 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
             }
         }
 
-        minutes = 60.0 * fmod(set, 1);
-        seconds = 60.0 * fmod(minutes, 1);
-        scratch_time.unit.hour = floor(set);
-        if (seconds < 30) scratch_time.unit.minute = floor(minutes);
-        else scratch_time.unit.minute = ceil(minutes);
-
-        // Handle hour overflow from timezone conversion
-        while (scratch_time.unit.hour >= 24) {
-            scratch_time.unit.hour -= 24;
-            // Increment day (this will be handled by the date arithmetic)
-            uint32_t timestamp = watch_utility_date_time_to_unix_time(scratch_time, 0);
-            timestamp += 86400;
-            scratch_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-        }
-
-        if (scratch_time.unit.minute == 60) {
-            scratch_time.unit.minute = 0;
-            scratch_time.unit.hour = (scratch_time.unit.hour + 1) % 24;
-        }
+        scratch_time = _sunrise_sunset_face_time_on_day(day, times.sunset_min);
 
         if (date_time.reg < scratch_time.reg) _sunrise_sunset_set_expiration(state, scratch_time);
 
@@ -201,7 +163,7 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
         // it's after sunset. we need to display sunrise/sunset for tomorrow.
         uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, 0);
         timestamp += 86400;
-        scratch_time = watch_utility_date_time_from_unix_time(timestamp, 0);
+        day = watch_utility_date_time_from_unix_time(timestamp, 0);
     }
 }
 
@@ -19,12 +19,13 @@
 extern volatile movement_state_t movement_state;
 
 // Metric abbreviations (5 chars max to fit LCD)
-static const char* metric_abbrevs[5] = {
+static const char* metric_abbrevs[PLAYLIST_METRIC_COUNT] = {
     "SD",      // Sleep Debt
     "EM",      // Emotional
     "WK",      // Work
     "Enrgy",   // Energy
-    "Comft"    // Comfort
+    "Comft",   // Comfort
+    "JL"       // Jet Lag
 };
 
 static void _zone_display_face_update_display(zone_display_face_state_t *state) {
@@ -57,6 +58,9 @@ static void _zone_display_face_update_display(zone_display_face_state_t *state)
         case 4:  // Comfort
             value = metrics.comfort;
             break;
+        case 5:  // Jet Lag
+            value = metrics.jl;
+            break;
         default:
             metric_idx = 0;
             value = metrics.sd;
@@ -136,7 +136,8 @@ static void _rtccount_face_draw(movement_event_t event, rtccount_state_t* state)
 }
 
 void rtccount_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
+    // count every top of the minute
+    movement_set_background_wake_interval(watch_face_index, 1);
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(rtccount_state_t));
         memset(*context_ptr, 0, sizeof(rtccount_state_t));
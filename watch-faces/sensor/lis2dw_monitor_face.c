@@ -529,7 +529,8 @@ static bool _settings_loop(movement_event_t event, void *context)
 
 void lis2dw_monitor_face_setup(uint8_t watch_face_index, void **context_ptr)
 {
-    (void) watch_face_index;
+    /* This face never needs a background task */
+    movement_set_background_wake_never(watch_face_index);
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(lis2dw_monitor_state_t));
         memset(*context_ptr, 0, sizeof(lis2dw_monitor_state_t));
@@ -34,7 +34,7 @@ static void _temperature_logging_face_log_data(temperature_logging_state_t *logg
     size_t pos = logger_state->data_points % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
 
     logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = movement_get_temperature();
+    logger_state->data[pos].temperature_c100 = movement_get_temperature_c100();
     logger_state->data_points++;
 }
 
@@ -74,18 +74,20 @@ static void _temperature_logging_face_update_display(temperature_logging_state_t
         sprintf(buf, "%2d", logger_state->display_index);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
         if (in_fahrenheit) {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c * 1.8 + 32.0, "#F");
+            watch_display_fixed_with_best_effort((int32_t)logger_state->data[pos].temperature_c100 * 9 / 5 + 3200, "#F");
         } else {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c, "#C");
+            watch_display_fixed_with_best_effort(logger_state->data[pos].temperature_c100, "#C");
         }
     }
 }
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
-
     // if temperature is invalid, we don't have a temperature sensor which means we shouldn't be here.
-    if (movement_get_temperature() == 0xFFFFFFFF) skip = true;
+    if (movement_get_temperature_c100() == MOVEMENT_TEMPERATURE_NONE) skip = true;
+
+    // log once an hour, at the top of the (UTC) hour, without being polled every minute.
+    if (skip) movement_set_background_wake_never(watch_face_index);
+    else movement_set_background_wake_interval(watch_face_index, 60);
 
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(temperature_logging_state_t));
@@ -61,7 +61,7 @@
 
 typedef struct {
     watch_date_time_t timestamp;
-    float temperature_c;
+    int16_t temperature_c100;   // hundredths of a degree celsius
 } thermistor_logger_data_point_t;
 
 typedef struct {
@@ -163,6 +163,9 @@ static void _watch_disable_all_peripherals_except_slcd(void) {
 }
 
 void watch_enter_sleep_mode(void) {
+    // let queued flash writes finish while the flash controller's interrupt can still run them
+    watch_storage_sync();
+
     // disable all other peripherals
     _watch_disable_all_peripherals_except_slcd();
 
@@ -186,6 +189,7 @@ void watch_enter_sleep_mode(void) {
 }
 
 void watch_enter_backup_mode(void) {
+    watch_storage_sync();
     watch_rtc_disable_all_periodic_callbacks();
     _watch_disable_all_pins_except_rtc();
 
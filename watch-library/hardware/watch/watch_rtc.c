@@ -42,18 +42,9 @@ static const uint32_t RTC_COMP_GRACE_PERIOD = 4;
 
 static const int TB_BKUP_REG = 7;
 
-#define WATCH_RTC_N_COMP_CB 8
-
-typedef struct {
-    volatile uint32_t counter;
-    volatile watch_cb_t callback;
-    volatile bool enabled;
-} comp_cb_t;
-
 volatile uint32_t scheduled_comp_counter;
 
 watch_cb_t tick_callbacks[8];
-comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
 watch_cb_t alarm_callback;
 watch_cb_t btn_alarm_callback;
 watch_cb_t a2_callback;
@@ -73,11 +64,7 @@ void _watch_rtc_init(void) {
     rtc_enable();
     rtc_configure_callback(watch_rtc_callback);
 
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        comp_callbacks[index].counter = 0;
-        comp_callbacks[index].callback = NULL;
-        comp_callbacks[index].enabled = false;
-    }
+    _watch_rtc_comp_init();
 
     scheduled_comp_counter = 0;
 
@@ -218,28 +205,12 @@ void watch_rtc_schedule_next_comp(void) {
     // so if a callback counter has just passed but didn't fire, give it a chance to fire.
     rtc_counter_t lax_curr_counter = curr_counter - RTC_COMP_GRACE_PERIOD;
 
-    bool schedule_any = false;
     rtc_counter_t comp_counter;
-    rtc_counter_t min_diff = UINT_MAX;
-
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        if (comp_callbacks[index].enabled) {
-            rtc_counter_t diff = comp_callbacks[index].counter - lax_curr_counter;
-            if (diff <= min_diff) {
-                min_diff = diff;
-                comp_counter = comp_callbacks[index].counter;
-                schedule_any = true;
-            }
-        }
-    }
 
-    if (schedule_any) {
+    if (_watch_rtc_comp_next_counter(&comp_counter)) {
         // If we are changing the comp counter at the front of the line, don't schedule a comp interrupt for a counter that is too close to now
         if (comp_counter != scheduled_comp_counter) {
-            rtc_counter_t earliest_comp_counter = curr_counter + RTC_COMP_GRACE_PERIOD;
-            if ((earliest_comp_counter - lax_curr_counter) > (comp_counter - lax_curr_counter)) {
-                comp_counter = earliest_comp_counter;
-            }
+            comp_counter = _watch_rtc_comp_clamp(comp_counter, curr_counter, RTC_COMP_GRACE_PERIOD);
             scheduled_comp_counter = comp_counter;
             rtc_enable_compare_interrupt(comp_counter);
         }
@@ -249,46 +220,6 @@ void watch_rtc_schedule_next_comp(void) {
     }
 }
 
-void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-
-    watch_rtc_schedule_next_comp();
-}
-
-void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-}
-
-void watch_rtc_disable_comp_callback(uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].enabled = false;
-
-    watch_rtc_schedule_next_comp();
-}
-
-void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].enabled = false;
-}
-
 void watch_rtc_callback(uint16_t interrupt_cause) {
     // First read all relevant registers, to ensure no changes occurr during the callbacks
     rtc_counter_t curr_counter = watch_rtc_get_counter();
@@ -320,14 +251,8 @@ void watch_rtc_callback(uint16_t interrupt_cause) {
     }
 
     if ((interrupt_cause & interrupt_enabled) & RTC_MODE0_INTFLAG_CMP0) {
-        for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-            if (comp_callbacks[index].enabled &&
-                (curr_counter - comp_callbacks[index].counter) < (RTC_COMP_GRACE_PERIOD * 4)
-            ) {
-                comp_callbacks[index].enabled = false;
-                comp_callbacks[index].callback();
-            }
-        }
+        // everything due by now fires, including callbacks that were held back to share this wakeup.
+        _watch_rtc_comp_fire_due(curr_counter);
         watch_rtc_schedule_next_comp();
     }
 
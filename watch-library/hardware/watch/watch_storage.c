@@ -1,7 +1,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "watch.h"
 #include "watch_storage.h"
+#include "watch_private.h"
 
 #define RWWEE_ADDR_START NVMCTRL_RWW_EEPROM_ADDR
 #define RWWEE_ADDR_END (NVMCTRL_RWW_EEPROM_ADDR + NVMCTRL_PAGE_SIZE * NVMCTRL_RWWEE_PAGES)
@@ -84,6 +86,10 @@ bool watch_storage_erase(uint32_t row) {
 }
 
 bool watch_storage_sync(void) {
+    while (watch_storage_is_busy()) {
+        // the ready interrupt is working through the write queue
+    }
+
     while (!NVMCTRL->INTFLAG.bit.READY) {
         // wait for flash to become ready
     }
@@ -92,3 +98,51 @@ bool watch_storage_sync(void) {
 
     return true;
 }
+
+void _watch_storage_start_erase(uint32_t row) {
+    NVMCTRL->ADDR.reg = (RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE) / 2;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY;
+}
+
+void _watch_storage_start_page_buffer_clear(void) {
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_PBC | NVMCTRL_CTRLA_CMDEX_KEY;
+}
+
+void _watch_storage_fill_page_buffer(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    uint32_t nvm_address = (RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset) / 2;
+
+    // the page buffer takes 16-bit writes; an odd last byte is paired with 0xFF, which programs nothing.
+    for (uint32_t i = 0; i < size; i += 2) {
+        uint16_t data = buffer[i];
+        data |= (i + 1 < size) ? (buffer[i + 1] << 8) : 0xFF00;
+        NVM_MEMORY[nvm_address++] = data;
+    }
+}
+
+void _watch_storage_start_page_write(uint32_t row, uint32_t offset) {
+    NVMCTRL->ADDR.reg = (RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset) / 2;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEWP | NVMCTRL_CTRLA_CMDEX_KEY;
+}
+
+bool _watch_storage_take_error(void) {
+    bool failed = NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_PROGE | NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_NVME);
+
+    NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+
+    return failed;
+}
+
+void _watch_storage_enable_ready_interrupt(bool enable) {
+    if (enable) {
+        NVIC_EnableIRQ(NVMCTRL_IRQn);
+        // READY is a level, so this fires at once if the flash is idle.
+        NVMCTRL->INTENSET.reg = NVMCTRL_INTENSET_READY;
+    } else {
+        NVMCTRL->INTENCLR.reg = NVMCTRL_INTENCLR_READY;
+    }
+}
+
+void irq_handler_nvmctrl(void);
+void irq_handler_nvmctrl(void) {
+    _watch_storage_ready_handler();
+}
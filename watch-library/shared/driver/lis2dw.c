@@ -25,6 +25,22 @@
 #include "lis2dw.h"
 #include "watch.h"
 
+#ifdef I2C_SERCOM
+// Reads `count` samples starting at OUT_X_L in one transfer. The output registers are laid out
+// like lis2dw_reading_t (X, Y, Z, low byte first) and the SAM L22 is little-endian, so the bytes
+// land in place. With the FIFO on, the address wraps from OUT_Z_H back to OUT_X_L and each
+// further six bytes pop the next sample (AN5038), so a whole FIFO comes out in one burst.
+static bool _lis2dw_read_samples(lis2dw_reading_t *readings, uint8_t count) {
+    _Static_assert(sizeof(lis2dw_reading_t) == 6, "lis2dw_reading_t must match OUT_X_L..OUT_Z_H");
+    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80; // set high bit for consecutive reads
+
+    if (watch_i2c_send(LIS2DW_ADDRESS, &reg, 1) != 0) {
+        return false;
+    }
+    return watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)readings, count * sizeof(lis2dw_reading_t)) == 0;
+}
+#endif
+
 bool lis2dw_begin(void) {
 #ifdef I2C_SERCOM
     if (lis2dw_get_device_id() != LIS2DW_WHO_AM_I_VAL) {
@@ -71,18 +87,9 @@ bool lis2dw_have_new_data(void) {
 lis2dw_reading_t lis2dw_get_raw_reading(void) {
     lis2dw_reading_t retval = {0};
 #ifdef I2C_SERCOM
-    uint8_t buffer[6];
-    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80; // set high bit for consecutive reads
-
-    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
-    watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)&buffer, 6);
-
-    retval.x = buffer[0];
-    retval.x |= ((uint16_t)buffer[1]) << 8;
-    retval.y = buffer[2];
-    retval.y |= ((uint16_t)buffer[3]) << 8;
-    retval.z = buffer[4];
-    retval.z |= ((uint16_t)buffer[5]) << 8;
+    if (!_lis2dw_read_samples(&retval, 1)) {
+        retval = (lis2dw_reading_t){0};
+    }
 #endif
     
     return retval;
@@ -277,26 +284,37 @@ inline void lis2dw_disable_fifo(void) {
 #endif
 }
 
+void lis2dw_configure_fifo(lis2dw_fifo_mode_t mode, uint8_t threshold) {
+#ifdef I2C_SERCOM
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, (mode << 5) | (threshold & LIS2DW_FIFO_CTRL_FTH));
+#else
+    (void) mode;
+    (void) threshold;
+#endif
+}
+
+uint8_t lis2dw_get_fifo_configuration(void) {
+#ifdef I2C_SERCOM
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL);
+#else
+    return 0;
+#endif
+}
+
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout) {
-    // timeout is in terms of 1/RTC_CNT_HZ seconds (likely 128 timeouts is one second)
+    // The drain is a single transfer now, so there is no per-sample loop left to time out.
+    (void) timeout;
 #ifdef I2C_SERCOM
     uint8_t temp = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
     bool overrun = !!(temp & LIS2DW_FIFO_SAMPLE_OVERRUN);
+    uint8_t count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
 
-    fifo_data->count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
-
-    rtc_counter_t timeout_counter = watch_rtc_get_counter() + timeout;
-    for(int i = 0; i < fifo_data->count; i++) {
-        if (watch_rtc_get_counter() > timeout_counter) {
-            break;
-        }
-        fifo_data->readings[i] = lis2dw_get_raw_reading();
-    }
+    if (count > 32) count = 32;
+    fifo_data->count = (count && _lis2dw_read_samples(fifo_data->readings, count)) ? count : 0;
 
     return overrun;
 #else
-    (void) fifo_data;
-    (void) timeout;
+    fifo_data->count = 0;
     return false;
 #endif
 }
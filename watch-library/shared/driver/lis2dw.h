@@ -347,6 +347,23 @@ void lis2dw_enable_fifo(void);
 
 void lis2dw_disable_fifo(void);
 
+/** @brief Sets the FIFO mode and watermark. FIFO_THS in STATUS (and FTH on INT1 or INT2,
+  *        if routed there) goes high once the FIFO holds at least `threshold` samples.
+  * @param mode The FIFO mode, e.g. LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS to keep the newest 32 samples.
+  * @param threshold The watermark, 0-31 samples.
+  */
+void lis2dw_configure_fifo(lis2dw_fifo_mode_t mode, uint8_t threshold);
+
+/** @brief Gets the FIFO mode and watermark as FIFO_CTRL holds them.
+  * @return The mode in the top three bits (LIS2DW_FIFO_CTRL_MODE_*), the watermark in LIS2DW_FIFO_CTRL_FTH.
+  */
+uint8_t lis2dw_get_fifo_configuration(void);
+
+/** @brief Drains every sample in the FIFO in one burst I2C transfer.
+  * @param fifo_data Receives the samples, oldest first, and their count.
+  * @param timeout Unused since the drain became a single transfer; kept for existing callers.
+  * @return true if the FIFO overran (samples were lost) since it was last drained.
+  */
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout);
 
 void lis2dw_clear_fifo(void);
@@ -104,8 +104,8 @@ void thermistor_driver_disable(void) {
     HAL_GPIO_TS_ENABLE_off();
 }
 
-float thermistor_driver_get_temperature(void) {
-    if (!has_thermistor) return (float) 0xFFFFFFFF;
+int16_t thermistor_driver_get_temperature_c100(void) {
+    if (!has_thermistor) return THERMISTOR_DRIVER_NO_READING;
 
     // set the enable pin to the level that powers the thermistor circuit.
     HAL_GPIO_TS_ENABLE_write(THERMISTOR_ENABLE_VALUE);
@@ -114,5 +114,13 @@ float thermistor_driver_get_temperature(void) {
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     HAL_GPIO_TS_ENABLE_write(!THERMISTOR_ENABLE_VALUE);
 
-    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+    // The table in watch_utility is built for the THERMISTOR_* values above.
+    return watch_utility_thermistor_temperature_c100(value);
+}
+
+float thermistor_driver_get_temperature(void) {
+    int16_t temperature_c100 = thermistor_driver_get_temperature_c100();
+    if (temperature_c100 == THERMISTOR_DRIVER_NO_READING) return (float) 0xFFFFFFFF;
+
+    return temperature_c100 / 100.0f;
 }
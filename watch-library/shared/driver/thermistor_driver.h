@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include "pins.h"
 
 // TODO: Do these belong in movement_config.h? In settings we can set on the watch? In an EEPROM configuration area?
@@ -35,7 +36,11 @@
 #define THERMISTOR_NOMINAL_RESISTANCE (10000.0)
 #define THERMISTOR_SERIES_RESISTANCE (10000.0)
 
+// Returned by thermistor_driver_get_temperature_c100 when there is no thermistor.
+#define THERMISTOR_DRIVER_NO_READING INT16_MIN
+
 bool thermistor_driver_init(void);
 void thermistor_driver_enable(void);
 void thermistor_driver_disable(void);
+int16_t thermistor_driver_get_temperature_c100(void);
 float thermistor_driver_get_temperature(void);
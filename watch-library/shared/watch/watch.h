@@ -71,6 +71,8 @@ typedef void (*watch_cb_t)(void);
 #include "watch_spi.h"
 #include "watch_uart.h"
 #include "watch_storage.h"
+#include "watch_storage_region.h"
+#include "watch_storage_log.h"
 #include "watch_deepsleep.h"
 
 /** @brief Interrupt handler for the SYSTEM interrupt, which handles MCLK,
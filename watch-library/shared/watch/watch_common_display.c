@@ -281,42 +281,58 @@ void watch_display_text_with_fallback(watch_position_t location, const char *str
 }
 
 void watch_display_float_with_best_effort(float value, const char *units) {
+    if (value < -99.9) {
+        watch_clear_decimal_if_available();
+        watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Undflo", " Unflo");
+        return;
+    } else if (value > 199.99) {
+        watch_clear_decimal_if_available();
+        watch_display_text(WATCH_POSITION_BOTTOM, "Ovrflo");
+        return;
+    }
+
+    watch_display_fixed_with_best_effort((int32_t)round(value * 100.0), units);
+}
+
+void watch_display_fixed_with_best_effort(int32_t hundredths, const char *units) {
     char buf[8];
     char buf_fallback[8];
     const char *blank_units = "  ";
 
-    if (value < -99.9) {
+    if (hundredths < -9990) {
         watch_clear_decimal_if_available();
         watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Undflo", " Unflo");
         return;
-    } else if (value > 199.99) {
+    } else if (hundredths > 19999) {
         watch_clear_decimal_if_available();
         watch_display_text(WATCH_POSITION_BOTTOM, "Ovrflo");
         return;
     }
 
-    uint16_t value_times_100 = abs((int)round(value * 100.0));
+    unsigned value_times_100 = (unsigned)abs((int)hundredths);
+    // the fallbacks show one decimal place, rounded half away from zero as printf would.
+    unsigned tenths = (value_times_100 + 5) / 10;
     bool set_decimal = true;
 
-    if (value < 0 && value_times_100 != 0) {
+    if (hundredths < 0) {
         if (value_times_100 > 999) {
             // decimal point isn't in the right place for these numbers; use same format as classic.
             set_decimal = false;
-            snprintf(buf, sizeof(buf), "-%4.1f%s", -value, units ? units : blank_units);
+            snprintf(buf, sizeof(buf), "-%2u.%u%s", tenths / 10, tenths % 10, units ? units : blank_units);
             snprintf(buf_fallback, sizeof(buf_fallback), "%s", buf);
         } else {
-            snprintf(buf, sizeof(buf), "-%03d%s", value_times_100 % 1000u, units ? units : blank_units);
-            snprintf(buf_fallback, sizeof(buf_fallback), "-%3.1f%s", -value, units ? units : blank_units);
+            snprintf(buf, sizeof(buf), "-%03u%s", value_times_100 % 1000u, units ? units : blank_units);
+            snprintf(buf_fallback, sizeof(buf_fallback), "-%u.%u%s", tenths / 10, tenths % 10, units ? units : blank_units);
         }
     } else if (value_times_100 > 9999) {
         snprintf(buf, sizeof(buf), "%5u%s", value_times_100, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.1f%s", value, units ? units : blank_units);
+        snprintf(buf_fallback, sizeof(buf_fallback), "%2u.%u%s", tenths / 10, tenths % 10, units ? units : blank_units);
     } else if (value_times_100 > 999) {
         snprintf(buf, sizeof(buf), "%4u%s", value_times_100, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.1f%s", value, units ? units : blank_units);
+        snprintf(buf_fallback, sizeof(buf_fallback), "%2u.%u%s", tenths / 10, tenths % 10, units ? units : blank_units);
     } else {
         snprintf(buf, sizeof(buf), " %03u%s", value_times_100 % 1000u, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.2f%s", value, units ? units : blank_units);
+        snprintf(buf_fallback, sizeof(buf_fallback), "%u.%02u%s", value_times_100 / 100, value_times_100 % 100, units ? units : blank_units);
     }
 
     watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf_fallback);
@@ -0,0 +1,230 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Alessandro Genova
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Comp callback bookkeeping shared by the hardware and simulator RTC backends.
+// Enabled callbacks are kept in a queue sorted by counter, so the backends only ever look at the front of it,
+// both to program the next compare interrupt and to fire whatever is due when it goes off.
+
+#include <stddef.h>
+
+#include "watch_rtc.h"
+#include "watch_private.h"
+
+/* On hardware the compare interrupt edits the queue too, so mask interrupts while the main loop does.
+ * The simulator is single-threaded, so there is nothing to protect. */
+#ifndef __EMSCRIPTEN__
+#define RTC_COMP_ENTER_CRITICAL(p) do { (p) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define RTC_COMP_EXIT_CRITICAL(p)  __set_PRIMASK(p)
+#else
+#define RTC_COMP_ENTER_CRITICAL(p) do { (p) = 0; } while (0)
+#define RTC_COMP_EXIT_CRITICAL(p)  do { (void)(p); } while (0)
+#endif
+
+comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
+
+// Indices of the enabled comp callbacks, earliest counter first.
+static uint8_t comp_queue[WATCH_RTC_N_COMP_CB];
+static uint8_t comp_queue_len;
+
+// Bumped every time a timer slot is handed out, so a stale handle can't cancel whoever got the slot next.
+static uint8_t comp_timer_generation[WATCH_RTC_N_COMP_CB];
+
+// Counters wrap, so compare them by signed distance. Fine as long as nothing is scheduled more than ~194 days out.
+static inline bool _comp_before(rtc_counter_t a, rtc_counter_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void _comp_queue_remove(uint8_t index) {
+    for (uint8_t i = 0; i < comp_queue_len; i++) {
+        if (comp_queue[i] == index) {
+            for (uint8_t j = i + 1; j < comp_queue_len; j++) comp_queue[j - 1] = comp_queue[j];
+            comp_queue_len--;
+            return;
+        }
+    }
+}
+
+static void _comp_queue_insert(uint8_t index) {
+    rtc_counter_t counter = comp_callbacks[index].counter;
+    uint8_t pos = comp_queue_len;
+
+    // ties go after the existing entries, so callbacks due together fire in the order they were registered.
+    while (pos > 0 && _comp_before(counter, comp_callbacks[comp_queue[pos - 1]].counter)) {
+        comp_queue[pos] = comp_queue[pos - 1];
+        pos--;
+    }
+    comp_queue[pos] = index;
+    comp_queue_len++;
+}
+
+static void _comp_set(uint8_t index, watch_cb_t callback, rtc_counter_t counter) {
+    uint32_t primask;
+
+    RTC_COMP_ENTER_CRITICAL(primask);
+    if (comp_callbacks[index].enabled) _comp_queue_remove(index);
+    comp_callbacks[index].counter = counter;
+    comp_callbacks[index].callback = callback;
+    comp_callbacks[index].enabled = true;
+    _comp_queue_insert(index);
+    RTC_COMP_EXIT_CRITICAL(primask);
+}
+
+static void _comp_clear(uint8_t index) {
+    uint32_t primask;
+
+    RTC_COMP_ENTER_CRITICAL(primask);
+    if (comp_callbacks[index].enabled) {
+        comp_callbacks[index].enabled = false;
+        _comp_queue_remove(index);
+    }
+    RTC_COMP_EXIT_CRITICAL(primask);
+}
+
+void _watch_rtc_comp_init(void) {
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        comp_callbacks[index].counter = 0;
+        comp_callbacks[index].callback = NULL;
+        comp_callbacks[index].slack = 0;
+        comp_callbacks[index].enabled = false;
+        comp_timer_generation[index] = 0;
+    }
+    comp_queue_len = 0;
+}
+
+bool _watch_rtc_comp_next_counter(rtc_counter_t *counter) {
+    uint32_t primask;
+    bool schedule_any = false;
+
+    RTC_COMP_ENTER_CRITICAL(primask);
+    if (comp_queue_len) {
+        // The earliest callback has to fire by counter + slack. Anything due before then can ride along,
+        // and may pull the wakeup earlier if its own slack runs out first.
+        const comp_cb_t *head = &comp_callbacks[comp_queue[0]];
+        rtc_counter_t target = head->counter + head->slack;
+
+        for (uint8_t i = 1; i < comp_queue_len; i++) {
+            const comp_cb_t *cb = &comp_callbacks[comp_queue[i]];
+            if (_comp_before(target, cb->counter)) break;
+            if (_comp_before(cb->counter + cb->slack, target)) target = cb->counter + cb->slack;
+        }
+
+        *counter = target;
+        schedule_any = true;
+    }
+    RTC_COMP_EXIT_CRITICAL(primask);
+
+    return schedule_any;
+}
+
+void _watch_rtc_comp_fire_due(rtc_counter_t counter) {
+    // Called from the compare interrupt. Pop before calling back, since the callback may register itself again.
+    while (comp_queue_len && !_comp_before(counter, comp_callbacks[comp_queue[0]].counter)) {
+        uint8_t index = comp_queue[0];
+        _comp_queue_remove(index);
+        comp_callbacks[index].enabled = false;
+        if (comp_callbacks[index].callback != NULL) comp_callbacks[index].callback();
+    }
+}
+
+void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_FIXED_COMP_CB) {
+        return;
+    }
+
+    _comp_set(index, callback, counter);
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_FIXED_COMP_CB) {
+        return;
+    }
+
+    _comp_set(index, callback, counter);
+}
+
+void watch_rtc_disable_comp_callback(uint8_t index) {
+    if (index >= WATCH_RTC_N_FIXED_COMP_CB) {
+        return;
+    }
+
+    _comp_clear(index);
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
+    if (index >= WATCH_RTC_N_FIXED_COMP_CB) {
+        return;
+    }
+
+    _comp_clear(index);
+}
+
+void watch_rtc_set_comp_callback_slack(uint8_t index, uint16_t slack) {
+    if (index >= WATCH_RTC_N_FIXED_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].slack = slack;
+}
+
+watch_rtc_timer_t watch_rtc_add_timer_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint16_t slack) {
+    for (uint8_t index = WATCH_RTC_N_FIXED_COMP_CB; index < WATCH_RTC_N_COMP_CB; ++index) {
+        if (comp_callbacks[index].enabled) continue;
+
+        // generation 0 is never handed out, so a valid handle is never WATCH_RTC_TIMER_NONE.
+        if (++comp_timer_generation[index] == 0) comp_timer_generation[index] = 1;
+        comp_callbacks[index].slack = slack;
+        _comp_set(index, callback, counter);
+
+        return ((watch_rtc_timer_t)comp_timer_generation[index] << 8) | index;
+    }
+
+    return WATCH_RTC_TIMER_NONE;
+}
+
+watch_rtc_timer_t watch_rtc_add_timer(watch_cb_t callback, rtc_counter_t counter, uint16_t slack) {
+    watch_rtc_timer_t timer = watch_rtc_add_timer_no_schedule(callback, counter, slack);
+
+    if (timer != WATCH_RTC_TIMER_NONE) watch_rtc_schedule_next_comp();
+
+    return timer;
+}
+
+void watch_rtc_cancel_timer_no_schedule(watch_rtc_timer_t timer) {
+    uint8_t index = timer & 0xFF;
+
+    if (index < WATCH_RTC_N_FIXED_COMP_CB || index >= WATCH_RTC_N_COMP_CB) return;
+    if (comp_timer_generation[index] != (timer >> 8)) return;
+
+    _comp_clear(index);
+}
+
+void watch_rtc_cancel_timer(watch_rtc_timer_t timer) {
+    watch_rtc_cancel_timer_no_schedule(timer);
+    watch_rtc_schedule_next_comp();
+}
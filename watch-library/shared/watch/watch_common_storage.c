@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Queued flash writes, shared by the hardware and simulator storage backends.
+// The backends only issue single commands; this file decides which one comes next, each time the flash controller
+// reports that the last one is done.
+
+#include <stddef.h>
+
+#include "watch.h"
+#include "watch_storage.h"
+#include "watch_private.h"
+
+typedef enum {
+    STORAGE_STEP_IDLE = 0,      // no command issued for the job at the front of the queue yet
+    STORAGE_STEP_ERASE,         // row erase issued
+    STORAGE_STEP_CLEAR,         // page buffer clear issued
+    STORAGE_STEP_WRITE,         // page write issued
+} storage_step_t;
+
+typedef struct {
+    uint32_t row;
+    uint32_t offset;
+    const uint8_t *buffer;
+    uint32_t size;
+    bool erase_first;
+    watch_storage_cb_t callback;
+    void *context;
+} storage_job_t;
+
+static storage_job_t _jobs[WATCH_STORAGE_QUEUE_LENGTH];
+static volatile uint8_t _job_head;
+static volatile uint8_t _job_count;
+static volatile storage_step_t _step;
+static uint32_t _job_written;              // bytes of the front job already handed to a page write
+
+static void _finish_job(bool success) {
+    storage_job_t job = _jobs[_job_head];
+
+    _job_head = (_job_head + 1) % WATCH_STORAGE_QUEUE_LENGTH;
+    _job_count--;
+    _step = STORAGE_STEP_IDLE;
+    // after popping, so the callback can queue a follow-up job.
+    if (job.callback) job.callback(success, job.context);
+}
+
+// Issues the next command for the front job, finishing jobs that have nothing left to do.
+static void _issue_next_command(void) {
+    while (_job_count) {
+        storage_job_t *job = &_jobs[_job_head];
+
+        if (_step == STORAGE_STEP_IDLE) {
+            _job_written = 0;
+            if (job->erase_first) {
+                _step = STORAGE_STEP_ERASE;
+                _watch_storage_start_erase(job->row);
+                return;
+            }
+        }
+
+        if (_step == STORAGE_STEP_CLEAR) {
+            // the page buffer is clear: fill it and commit the page.
+            uint32_t chunk = job->size - _job_written;
+            if (chunk > NVMCTRL_PAGE_SIZE) chunk = NVMCTRL_PAGE_SIZE;
+            _watch_storage_fill_page_buffer(job->row, job->offset + _job_written, job->buffer + _job_written, chunk);
+            _watch_storage_start_page_write(job->row, job->offset + _job_written);
+            _job_written += chunk;
+            _step = STORAGE_STEP_WRITE;
+            return;
+        }
+
+        if (_job_written < job->size) {
+            _step = STORAGE_STEP_CLEAR;
+            _watch_storage_start_page_buffer_clear();
+            return;
+        }
+
+        _finish_job(true);
+    }
+
+    _watch_storage_enable_ready_interrupt(false);
+}
+
+void _watch_storage_ready_handler(void) {
+    if (_job_count && _step != STORAGE_STEP_IDLE && _watch_storage_take_error()) {
+        // give up on this job; the next one still gets its turn.
+        _finish_job(false);
+    }
+    _issue_next_command();
+}
+
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size,
+                               bool erase_first, watch_storage_cb_t callback, void *context) {
+    if (row >= NVMCTRL_RWWEE_PAGES / 4 || offset % NVMCTRL_PAGE_SIZE || offset + size > NVMCTRL_ROW_SIZE) return false;
+    if (size && buffer == NULL) return false;
+
+    // the ready interrupt is the only other thing that touches the queue, so hold it off while we do.
+    _watch_storage_enable_ready_interrupt(false);
+    bool queued = _job_count < WATCH_STORAGE_QUEUE_LENGTH;
+    if (queued) {
+        storage_job_t *job = &_jobs[(_job_head + _job_count) % WATCH_STORAGE_QUEUE_LENGTH];
+        job->row = row;
+        job->offset = offset;
+        job->buffer = buffer;
+        job->size = size;
+        job->erase_first = erase_first;
+        job->callback = callback;
+        job->context = context;
+        _job_count++;
+    }
+    // if the flash is idle the interrupt fires straight away and issues the first command.
+    if (_job_count) _watch_storage_enable_ready_interrupt(true);
+
+    return queued;
+}
+
+bool watch_storage_is_busy(void) {
+    return _job_count != 0;
+}
@@ -35,4 +35,45 @@ void _watch_enable_usb(void);
 /// Initializes the real-time clock peripheral. Implemented in watch_rtc.c
 void _watch_rtc_init(void);
 
+typedef struct {
+    volatile uint32_t counter;
+    volatile watch_cb_t callback;
+    volatile uint16_t slack;
+    volatile bool enabled;
+} comp_cb_t;
+
+/// Clears every comp callback and timer. Called by _watch_rtc_init. Implemented in watch_common_rtc.c
+void _watch_rtc_comp_init(void);
+
+/// Works out the counter the next comp interrupt should be set for, letting callbacks whose slack windows overlap
+/// share it. Returns false if no comp callback is enabled. Implemented in watch_common_rtc.c
+bool _watch_rtc_comp_next_counter(rtc_counter_t *counter);
+
+/// The counter to program the comp interrupt for, given the one the queue asked for: never sooner than now + grace,
+/// which also catches a queue head that is already overdue. The counter wraps, so this compares by signed distance;
+/// an unsigned one would put an overdue head ~36 hours out.
+static inline rtc_counter_t _watch_rtc_comp_clamp(rtc_counter_t counter, rtc_counter_t now, rtc_counter_t grace) {
+    if ((int32_t)(counter - now) < (int32_t)grace) return now + grace;
+    return counter;
+}
+
+/// Disables and calls every comp callback due at or before the given counter. Called from the comp interrupt.
+/// Implemented in watch_common_rtc.c
+void _watch_rtc_comp_fire_due(rtc_counter_t counter);
+
+/// The flash controller side of watch_storage_write_async. Each _start function issues a command and returns without
+/// waiting; the backend calls _watch_storage_ready_handler from its ready interrupt once the command is done.
+/// Implemented in watch_storage.c
+void _watch_storage_start_erase(uint32_t row);
+void _watch_storage_start_page_buffer_clear(void);
+void _watch_storage_fill_page_buffer(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size);
+void _watch_storage_start_page_write(uint32_t row, uint32_t offset);
+/// Returns true, and clears the error, if the last command failed.
+bool _watch_storage_take_error(void);
+void _watch_storage_enable_ready_interrupt(bool enable);
+
+/// Advances the queued write at the front of the queue. Called from the flash ready interrupt.
+/// Implemented in watch_common_storage.c
+void _watch_storage_ready_handler(void);
+
 #endif
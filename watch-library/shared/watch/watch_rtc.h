@@ -50,6 +50,15 @@ extern watch_cb_t comp_callback;
 typedef rtc_counter_t watch_counter_t;
 typedef uint32_t unix_timestamp_t;
 
+/// Comp callback slots with a fixed index, for use by Movement (see movement_timeout_index_t).
+#define WATCH_RTC_N_FIXED_COMP_CB 8
+/// Total comp callback slots; the ones past the fixed range are handed out by watch_rtc_add_timer.
+#define WATCH_RTC_N_COMP_CB 16
+
+/// Handle to a one-shot timer from watch_rtc_add_timer.
+typedef uint16_t watch_rtc_timer_t;
+#define WATCH_RTC_TIMER_NONE 0
+
 /** @brief Called by main.c to check if the RTC is enabled.
   * You may call this function, but outside of app_init, it should always return true.
   */
@@ -104,11 +113,12 @@ uint32_t watch_rtc_get_ticks_per_minute(void);
   * @param callback The function you wish to have called when the target counter is reached. If this value is NULL, the comp
   *                 interrupt will still be enabled, but no callback function will be called.
   * @param counter The time that you wish to match. The date is currently ignored.
-  * @param index We can have up to 8 active callbacks at a time. This parameter specifies which of the 8 callbacks should be set.
+  * @param index There are WATCH_RTC_N_FIXED_COMP_CB callbacks with a fixed index. This parameter specifies which one should be set.
   * @details The hardware RTC provides us with single interrupt that fires when the RTC counter matches a target counter COMP0.
-  *          With a little bit of logic, we can provide multiple active compare callbacks. Every time a comp callback is 
-  *          registered/disabled/fired we iterate over all the active comp callbacks and set the hardware COMP0 counter
-  *          to the next occurring one.
+  *          With a little bit of logic, we can provide multiple active compare callbacks. Enabled comp callbacks are kept
+  *          sorted by counter, and every time one is registered/disabled/fired the hardware COMP0 counter is set to the
+  *          front of the queue. Callbacks with some slack (see watch_rtc_set_comp_callback_slack) may be held back to
+  *          share a wakeup with one due shortly after them.
   *          With this very simple API, movement can implement one-shot timers to turn off the led and determine button longpresses
   *          as well as the inactivity timeouts for resigning and sleeping, as well as emulating the top of the minute alarm.
   */
@@ -140,6 +150,33 @@ void watch_rtc_disable_comp_callback(uint8_t index);
   */
 void watch_rtc_disable_comp_callback_no_schedule(uint8_t index);
 
+/** @brief Allows the specified comp callback to fire up to `slack` ticks late.
+  * @details If another comp callback is due within that window, both fire on a single wakeup instead of two.
+  *          The slack stays in effect for every later registration of the same index. Defaults to 0.
+  */
+void watch_rtc_set_comp_callback_slack(uint8_t index, uint16_t slack);
+
+/** @brief Registers a one-shot callback without claiming a fixed index.
+  * @param callback The function to call when the counter is reached. Like every comp callback, it runs in interrupt context.
+  * @param counter The counter value to fire at.
+  * @param slack How many ticks late the callback may fire, so it can share a wakeup with another one.
+  * @return A handle for watch_rtc_cancel_timer, or WATCH_RTC_TIMER_NONE if all timer slots are in use.
+  *         The slot is released as soon as the timer fires or is cancelled.
+  */
+watch_rtc_timer_t watch_rtc_add_timer(watch_cb_t callback, rtc_counter_t counter, uint16_t slack);
+
+/** @brief Just like watch_rtc_add_timer but doesn't schedule the next comp interrupt; call watch_rtc_schedule_next_comp after.
+  */
+watch_rtc_timer_t watch_rtc_add_timer_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint16_t slack);
+
+/** @brief Cancels a timer from watch_rtc_add_timer. Does nothing if it has already fired.
+  */
+void watch_rtc_cancel_timer(watch_rtc_timer_t timer);
+
+/** @brief Just like watch_rtc_cancel_timer but doesn't schedule the next comp interrupt; call watch_rtc_schedule_next_comp after.
+  */
+void watch_rtc_cancel_timer_no_schedule(watch_rtc_timer_t timer);
+
 /** @brief Determines the first comp callback that should fire and schedule it with the RTC
   *
   * You would never need to call this manually, unless you used the 'no_schedule' functions above.
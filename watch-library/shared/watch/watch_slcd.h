@@ -195,6 +195,15 @@ void watch_display_text_with_fallback(watch_position_t location, const char *str
  */
 void watch_display_float_with_best_effort(float value, const char *units);
 
+/**
+ * @brief Displays a fixed-point number as best we can on whatever LCD is available.
+ * @details Same layout as watch_display_float_with_best_effort, for callers that keep their values in
+ *          hundredths and would rather not pull in float formatting.
+ * @param hundredths The number to display, times 100 (-9990 to 19999).
+ * @param units A 1-2 character string to display in the seconds position. Second character may be truncated.
+ */
+void watch_display_fixed_with_best_effort(int32_t hundredths, const char *units);
+
 /** @brief Turns the colon segment on.
   */
 void watch_set_colon(void);
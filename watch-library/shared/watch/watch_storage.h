@@ -86,7 +86,38 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
   */
 bool watch_storage_erase(uint32_t row);
 
-/** @brief Waits for any pending writes to complete.
+/** @brief Waits for any pending writes to complete, including everything queued with
+  *        watch_storage_write_async. Don't call this (or any of the blocking functions above,
+  *        which call it) from a watch_storage_cb_t.
   */
 bool watch_storage_sync(void);
+
+/** @brief Called when a queued write finishes. Runs in interrupt context on hardware.
+  * @param success false if the flash controller reported an error.
+  * @param context Whatever was passed to watch_storage_write_async.
+  */
+typedef void (*watch_storage_cb_t)(bool success, void *context);
+
+#define WATCH_STORAGE_QUEUE_LENGTH 4
+
+/** @brief Queues an erase and/or write of part of one row, and returns at once.
+  * @details The flash controller's ready interrupt steps the job through erase, page buffer
+  *          clear, page fill and page write, one page at a time, so the CPU can go back to sleep
+  *          while the flash is busy instead of spinning in watch_storage_sync. Jobs run in the
+  *          order they were queued.
+  * @param row The row to write.
+  * @param offset The offset from the beginning of the row. Must be a multiple of 64.
+  * @param buffer The bytes to write. Must stay valid until the callback runs.
+  * @param size The number of bytes; 0 with erase_first just erases the row.
+  * @param erase_first Erase the row before writing. Otherwise it should already be erased.
+  * @param callback Called when the job is done, or NULL.
+  * @param context Passed to the callback.
+  * @return false if the range is invalid or the queue is full.
+  */
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size,
+                               bool erase_first, watch_storage_cb_t callback, void *context);
+
+/** @brief Returns true while jobs queued with watch_storage_write_async are unfinished.
+  */
+bool watch_storage_is_busy(void);
 /// @}
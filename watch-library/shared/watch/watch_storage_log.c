@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "watch.h"
+#include "watch_storage_log.h"
+
+// Record header, little-endian: tag (2), CRC (2), sequence (4).
+#define TAG_OFFSET 0
+#define CRC_OFFSET 2
+#define SEQUENCE_OFFSET 4
+
+static uint8_t _slot_buffer[NVMCTRL_ROW_SIZE];
+
+static uint16_t _crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    // CRC-16/CCITT-FALSE, a bit at a time: it only runs at boot and once per append or read.
+    while (length--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Covers everything in the record but the CRC itself.
+static uint16_t _record_crc(const uint8_t *record, uint16_t record_size) {
+    uint16_t crc = _crc16(0xffff, record + TAG_OFFSET, 2);
+    return _crc16(crc, record + SEQUENCE_OFFSET, 4 + record_size);
+}
+
+static bool _is_erased(const uint8_t *bytes, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) if (bytes[i] != 0xff) return false;
+    return true;
+}
+
+static uint32_t _slot_row(const watch_storage_log_t *log, uint16_t slot) {
+    return log->region->row + slot / log->slots_per_row;
+}
+
+static uint32_t _slot_offset(const watch_storage_log_t *log, uint16_t slot) {
+    return (uint32_t)(slot % log->slots_per_row) * log->slot_size;
+}
+
+// Reads a slot into _slot_buffer and returns its sequence number, or 0 if it doesn't hold a
+// complete record of this log.
+static uint32_t _read_slot(const watch_storage_log_t *log, uint16_t slot) {
+    const uint8_t *b = _slot_buffer;
+
+    if (!watch_storage_read(_slot_row(log, slot), _slot_offset(log, slot), _slot_buffer, WATCH_STORAGE_LOG_HEADER_SIZE + log->record_size)) return 0;
+    if ((b[TAG_OFFSET] | (b[TAG_OFFSET + 1] << 8)) != log->region->tag) return 0;
+    if ((b[CRC_OFFSET] | (b[CRC_OFFSET + 1] << 8)) != _record_crc(b, log->record_size)) return 0;
+
+    return (uint32_t)b[SEQUENCE_OFFSET] | ((uint32_t)b[SEQUENCE_OFFSET + 1] << 8) |
+           ((uint32_t)b[SEQUENCE_OFFSET + 2] << 16) | ((uint32_t)b[SEQUENCE_OFFSET + 3] << 24);
+}
+
+bool watch_storage_log_open(watch_storage_log_t *log, const char *name, uint16_t record_size, uint8_t rows) {
+    uint16_t slot_size = (WATCH_STORAGE_LOG_HEADER_SIZE + record_size + NVMCTRL_PAGE_SIZE - 1) / NVMCTRL_PAGE_SIZE * NVMCTRL_PAGE_SIZE;
+
+    // an append still in flight would land on the log after we've reset it.
+    watch_storage_sync();
+    memset(log, 0, sizeof(*log));
+    if (record_size == 0 || slot_size > NVMCTRL_ROW_SIZE || rows < 2) return false;
+
+    log->region = watch_storage_region_claim_rows(name, rows);
+    if (log->region == NULL) return false;
+
+    log->record_size = record_size;
+    log->slot_size = slot_size;
+    log->slots_per_row = NVMCTRL_ROW_SIZE / slot_size;
+    log->slot_count = log->slots_per_row * rows;
+
+    for (uint16_t slot = 0; slot < log->slot_count; slot++) {
+        uint32_t sequence = _read_slot(log, slot);
+        if (sequence > log->sequence) {
+            log->sequence = sequence;
+            log->newest = slot;
+        }
+    }
+    log->head = log->sequence ? (log->newest + 1) % log->slot_count : 0;
+
+    return true;
+}
+
+// Finds the slot for the next record and composes it in _slot_buffer. `erase` comes back true if
+// the slot's row has to be erased first.
+static bool _prepare_append(const watch_storage_log_t *log, const void *buffer, uint16_t *slot_out, bool *erase) {
+    // Slots past the newest record are normally still erased. One that isn't was left half
+    // written, so move on to the next row; a row start that isn't erased is the oldest row in
+    // the ring, and gets erased. Neither can be the newest record's row, since the ring has at
+    // least two rows and the head is never more than one row ahead of the newest record.
+    uint16_t slot = log->head;
+    *erase = false;
+    while (true) {
+        uint32_t row = _slot_row(log, slot);
+        uint32_t offset = _slot_offset(log, slot);
+
+        if (!watch_storage_read(row, offset, _slot_buffer, log->slot_size)) return false;
+        if (_is_erased(_slot_buffer, log->slot_size)) break;
+        if (offset) {
+            slot = (uint16_t)((slot / log->slots_per_row + 1) % log->region->rows * log->slots_per_row);
+            continue;
+        }
+        if (log->sequence && row == _slot_row(log, log->newest)) return false;
+        *erase = true;
+        break;
+    }
+
+    uint32_t sequence = log->sequence + 1;
+    memset(_slot_buffer, 0xff, log->slot_size);
+    _slot_buffer[TAG_OFFSET] = log->region->tag & 0xff;
+    _slot_buffer[TAG_OFFSET + 1] = log->region->tag >> 8;
+    for (uint8_t i = 0; i < 4; i++) _slot_buffer[SEQUENCE_OFFSET + i] = (sequence >> (8 * i)) & 0xff;
+    memcpy(_slot_buffer + WATCH_STORAGE_LOG_HEADER_SIZE, buffer, log->record_size);
+    uint16_t crc = _record_crc(_slot_buffer, log->record_size);
+    _slot_buffer[CRC_OFFSET] = crc & 0xff;
+    _slot_buffer[CRC_OFFSET + 1] = crc >> 8;
+
+    *slot_out = slot;
+    return true;
+}
+
+static void _commit_append(watch_storage_log_t *log, uint16_t slot) {
+    log->sequence++;
+    log->newest = slot;
+    log->head = (slot + 1) % log->slot_count;
+}
+
+bool watch_storage_log_append(watch_storage_log_t *log, const void *buffer) {
+    uint16_t slot;
+    bool erase;
+
+    if (log->region == NULL) return false;
+    // let a queued append land first, or we'd both pick the same slot.
+    if (!watch_storage_sync() || log->pending) return false;
+    if (!_prepare_append(log, buffer, &slot, &erase)) return false;
+
+    uint32_t row = _slot_row(log, slot);
+    uint32_t offset = _slot_offset(log, slot);
+    if (erase && !watch_storage_erase(row)) return false;
+    // a page at a time, header first: a record cut short fails its CRC and is ignored.
+    for (uint16_t page = 0; page < log->slot_size; page += NVMCTRL_PAGE_SIZE) {
+        if (_is_erased(_slot_buffer + page, NVMCTRL_PAGE_SIZE)) continue;
+        if (!watch_storage_write(row, offset + page, _slot_buffer + page, NVMCTRL_PAGE_SIZE)) return false;
+    }
+    if (!watch_storage_sync()) return false;
+
+    _commit_append(log, slot);
+    return true;
+}
+
+static void _append_done(bool success, void *context) {
+    watch_storage_log_t *log = (watch_storage_log_t *)context;
+    watch_storage_cb_t callback = log->pending_callback;
+    void *callback_context = log->pending_context;
+
+    if (success) _commit_append(log, log->pending_slot);
+    log->pending = false;
+    if (callback) callback(success, callback_context);
+}
+
+bool watch_storage_log_append_async(watch_storage_log_t *log, const void *buffer,
+                                    watch_storage_cb_t callback, void *context) {
+    uint16_t slot;
+    bool erase;
+
+    if (log->region == NULL) return false;
+    // the slot after one still in flight isn't known until it lands.
+    if (log->pending && (!watch_storage_sync() || log->pending)) return false;
+    if (!_prepare_append(log, buffer, &slot, &erase)) return false;
+
+    // _slot_buffer is scratch for every other call, so the queued write gets its own copy.
+    memcpy(log->pending_buffer, _slot_buffer, log->slot_size);
+    log->pending = true;
+    log->pending_slot = slot;
+    log->pending_callback = callback;
+    log->pending_context = context;
+    if (!watch_storage_write_async(_slot_row(log, slot), _slot_offset(log, slot), log->pending_buffer, log->slot_size,
+                                   erase, _append_done, log)) {
+        log->pending = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool watch_storage_log_read(const watch_storage_log_t *log, uint16_t age, void *buffer) {
+    if (log->region == NULL || log->sequence == 0 || age >= log->sequence) return false;
+
+    // Records go down in slot order, so the one we want is usually `age` slots back; a skipped
+    // half-written slot or row puts it further back.
+    uint32_t wanted = log->sequence - age;
+    for (uint16_t back = age; back < log->slot_count; back++) {
+        uint32_t sequence = _read_slot(log, (log->newest + log->slot_count - back) % log->slot_count);
+        if (sequence == wanted) {
+            memcpy(buffer, _slot_buffer + WATCH_STORAGE_LOG_HEADER_SIZE, log->record_size);
+            return true;
+        }
+        if (sequence && sequence < wanted) break;
+    }
+
+    return false;
+}
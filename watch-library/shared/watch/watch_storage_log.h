@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_storage_log.h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_storage_region.h"
+
+/** @addtogroup storage_log Flash Storage Logs
+  * @brief An append-only log of fixed-size records over a ring of storage rows.
+  * @details Use this instead of a watch_storage_region record for state that is saved often: a
+  *          record is rewritten in place with an erase every time, while a log only erases a row
+  *          when the ring comes back around to it, and spreads that wear over all of its rows.
+  *
+  *          Each record takes a whole number of 64 byte pages and starts with an eight byte
+  *          header: the region's tag, a CRC-16 over the tag, sequence number and payload, and a
+  *          32-bit sequence number. Opening a log scans every slot and picks the valid record with
+  *          the highest sequence number, so a write cut short by a reset or a flat battery just
+  *          leaves the previous record as the newest one. The row holding the newest record is
+  *          never erased, since appends move on to the next row before erasing anything.
+  *
+  *          Snapshots (read back only the newest record) and histories (read back by age) work
+  *          the same way; a log of N rows holds at least N - 1 rows' worth of past records.
+  */
+/// @{
+
+#define WATCH_STORAGE_LOG_HEADER_SIZE 8
+
+typedef struct {
+    const watch_storage_region_t *region;
+    uint16_t record_size;       // payload bytes
+    uint16_t slot_size;         // header and payload, rounded up to whole pages
+    uint8_t slots_per_row;
+    uint16_t slot_count;
+    uint32_t sequence;          // sequence number of the newest record; 0 if the log is empty
+    uint16_t newest;            // slot of the newest record
+    uint16_t head;              // slot the next append goes to
+    // the append queued by watch_storage_log_append_async, until the flash ready interrupt lands it
+    volatile bool pending;
+    uint16_t pending_slot;
+    watch_storage_cb_t pending_callback;
+    void *pending_context;
+    uint8_t pending_buffer[NVMCTRL_ROW_SIZE];
+} watch_storage_log_t;
+
+/** @brief Claims a ring of rows for a log (or finds it again) and recovers its newest record.
+  * @param log The log to set up.
+  * @param name A string that names the log. It must outlive the log (use a literal).
+  * @param record_size The payload size in bytes. Header and payload must fit in one row.
+  * @param rows The number of rows in the ring, at least 2.
+  * @return false if the rows couldn't be claimed or the record size doesn't fit.
+  */
+bool watch_storage_log_open(watch_storage_log_t *log, const char *name, uint16_t record_size, uint8_t rows);
+
+/** @brief Appends a record, erasing the next row first if the ring has come around to it.
+  * @param log An open log.
+  * @param buffer log->record_size bytes to store.
+  */
+bool watch_storage_log_append(watch_storage_log_t *log, const void *buffer);
+
+/** @brief Like watch_storage_log_append, but queues the erase and write with
+  *        watch_storage_write_async and returns at once.
+  * @details The log doesn't count the record until it has been written: reads in the meantime
+  *          still see the previous newest record. Each log holds one queued append of its own,
+  *          so appends to different logs queue up behind each other (up to
+  *          WATCH_STORAGE_QUEUE_LENGTH writes in all). A second append to the same log waits for
+  *          the first to land, as the blocking functions do; so don't call this from a callback.
+  * @param log An open log. It must stay valid until the callback runs.
+  * @param buffer log->record_size bytes to store. Copied, so it needn't outlive the call.
+  * @param callback Called from the flash ready interrupt once the record is down, or NULL.
+  * @param context Passed to the callback.
+  * @return false if the write couldn't be queued (the queue is full, or no slot could be
+  *         prepared). Nothing is written then; call again to retry.
+  */
+bool watch_storage_log_append_async(watch_storage_log_t *log, const void *buffer,
+                                    watch_storage_cb_t callback, void *context);
+
+/** @brief Reads a record back.
+  * @param log An open log.
+  * @param age 0 for the newest record, 1 for the one before it, and so on.
+  * @param buffer A buffer of at least log->record_size bytes.
+  * @return false, leaving the buffer untouched, if there is no such record (never written, or
+  *         already overwritten).
+  */
+bool watch_storage_log_read(const watch_storage_log_t *log, uint16_t age, void *buffer);
+/// @}
@@ -0,0 +1,269 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_storage_region.h"
+
+// Shared rows are handed out in 4 byte slots, which keeps every header word-aligned for reads.
+#define SLOT_SIZE 4
+#define SLOTS_PER_ROW (NVMCTRL_ROW_SIZE / SLOT_SIZE)
+#define ALL_SLOTS UINT64_MAX
+
+_Static_assert(SLOTS_PER_ROW == 64, "slot bitmap assumes 256 byte rows");
+_Static_assert(WATCH_STORAGE_REGION_FIRST_ROW > 0, "storage regions would leave no rows for the filesystem");
+_Static_assert(WATCH_STORAGE_REGION_ROWS * NVMCTRL_ROW_SIZE <= UINT16_MAX, "region sizes are 16 bits");
+
+static watch_storage_region_t _claims[WATCH_STORAGE_REGION_MAX_CLAIMS];
+static uint8_t _claim_count;
+// bit n set: bytes 4n to 4n+3 of that row belong to a claim.
+static uint64_t _used_slots[WATCH_STORAGE_REGION_ROWS];
+static uint8_t _row_buffer[NVMCTRL_ROW_SIZE];
+
+static uint16_t _tag_for_name(const char *name) {
+    // FNV-1a folded to 16 bits. 0xffff is what an erased header reads as, so it's never a tag.
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    uint16_t tag = (uint16_t)(hash ^ (hash >> 16));
+    return tag == 0xffff ? 0xfffe : tag;
+}
+
+static uint64_t _slot_mask(uint8_t first, uint8_t count) {
+    return (count >= SLOTS_PER_ROW ? ALL_SLOTS : ((1ULL << count) - 1)) << first;
+}
+
+static void _header_set(uint8_t *header, uint16_t tag, uint16_t size) {
+    header[0] = tag & 0xff;
+    header[1] = tag >> 8;
+    header[2] = size & 0xff;
+    header[3] = size >> 8;
+}
+
+static bool _header_matches(const uint8_t *header, uint16_t tag, uint16_t size) {
+    uint8_t expected[WATCH_STORAGE_REGION_HEADER_SIZE];
+    _header_set(expected, tag, size);
+    return memcmp(header, expected, sizeof(expected)) == 0;
+}
+
+static bool _is_erased(const uint8_t *bytes, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) if (bytes[i] != 0xff) return false;
+    return true;
+}
+
+static bool _read_row(uint8_t index) {
+    return watch_storage_read(WATCH_STORAGE_REGION_FIRST_ROW + index, 0, _row_buffer, NVMCTRL_ROW_SIZE);
+}
+
+// Erases a row and programs it from _row_buffer. watch_storage_write only programs the page its
+// offset falls in, so go a page at a time; pages that are still erased can be skipped.
+static bool _write_row(uint32_t row) {
+    if (!watch_storage_erase(row)) return false;
+    for (uint16_t page = 0; page < NVMCTRL_ROW_SIZE; page += NVMCTRL_PAGE_SIZE) {
+        if (_is_erased(_row_buffer + page, NVMCTRL_PAGE_SIZE)) continue;
+        if (!watch_storage_write(row, page, _row_buffer + page, NVMCTRL_PAGE_SIZE)) return false;
+    }
+    return watch_storage_sync();
+}
+
+// Each claim makes up to three passes: where its header already is, then erased space, then
+// any unclaimed space (which may still hold a record from an older layout that nobody claims now).
+#define PASS_EXISTING 0
+#define PASS_ERASED 1
+#define PASS_ANY 2
+
+static bool _claim_shared(watch_storage_region_t *claim) {
+    uint8_t slots = (WATCH_STORAGE_REGION_HEADER_SIZE + claim->size + SLOT_SIZE - 1) / SLOT_SIZE;
+
+    for (uint8_t pass = PASS_EXISTING; pass <= PASS_ANY; pass++) {
+        for (uint8_t i = 0; i < WATCH_STORAGE_REGION_SHARED_ROWS; i++) {
+            if (_used_slots[i] == ALL_SLOTS || !_read_row(i)) continue;
+            for (uint8_t slot = 0; slot + slots <= SLOTS_PER_ROW; slot++) {
+                uint64_t mask = _slot_mask(slot, slots);
+                const uint8_t *at = _row_buffer + slot * SLOT_SIZE;
+
+                if (_used_slots[i] & mask) continue;
+                if (pass == PASS_EXISTING && !_header_matches(at, claim->tag, claim->size)) continue;
+                if (pass == PASS_ERASED && !_is_erased(at, slots * SLOT_SIZE)) continue;
+
+                _used_slots[i] |= mask;
+                claim->row = WATCH_STORAGE_REGION_FIRST_ROW + i;
+                claim->offset = slot * SLOT_SIZE;
+                claim->rows = 0;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// A raw claim can only be recognised by the tag its owner starts each row with.
+static bool _row_is_claims(const watch_storage_region_t *claim) {
+    if (WATCH_STORAGE_REGION_IS_RAW(claim)) return _row_buffer[0] == (claim->tag & 0xff) && _row_buffer[1] == (claim->tag >> 8);
+    return _header_matches(_row_buffer, claim->tag, claim->size);
+}
+
+static bool _claim_rows(watch_storage_region_t *claim) {
+    uint8_t rows = claim->rows;
+
+    for (uint8_t pass = PASS_EXISTING; pass <= PASS_ANY; pass++) {
+        // top down, and never into the shared rows at the bottom.
+        for (int8_t first = WATCH_STORAGE_REGION_ROWS - rows; first >= WATCH_STORAGE_REGION_SHARED_ROWS; first--) {
+            bool fits = true;
+            for (uint8_t i = first; i < first + rows && fits; i++) {
+                if (_used_slots[i]) fits = false;
+                else if (pass == PASS_EXISTING && i == first) fits = _read_row(i) && _row_is_claims(claim);
+                else if (pass == PASS_ERASED) fits = _read_row(i) && _is_erased(_row_buffer, NVMCTRL_ROW_SIZE);
+            }
+            if (!fits) continue;
+
+            for (uint8_t i = first; i < first + rows; i++) _used_slots[i] = ALL_SLOTS;
+            claim->row = WATCH_STORAGE_REGION_FIRST_ROW + first;
+            claim->offset = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void watch_storage_region_init(void) {
+    memset(_claims, 0, sizeof(_claims));
+    memset(_used_slots, 0, sizeof(_used_slots));
+    _claim_count = 0;
+}
+
+// size 0 with rows set is a raw claim; otherwise rows is worked out from the size.
+static const watch_storage_region_t *_claim(const char *name, uint16_t size, uint8_t rows) {
+    uint16_t tag = _tag_for_name(name);
+
+    for (uint8_t i = 0; i < _claim_count; i++) {
+        watch_storage_region_t *claim = &_claims[i];
+        if (strcmp(claim->name, name) == 0) {
+            if (claim->size == size && (size || claim->rows == rows)) return claim;
+            printf("storage: %s claimed again with a different size\r\n", name);
+            return NULL;
+        }
+        if (claim->tag == tag) {
+            printf("storage: %s and %s hash to the same tag; rename one\r\n", claim->name, name);
+            return NULL;
+        }
+    }
+
+    if (size) rows = (WATCH_STORAGE_REGION_HEADER_SIZE + size <= NVMCTRL_ROW_SIZE) ? 0 :
+                     (WATCH_STORAGE_REGION_HEADER_SIZE + size + NVMCTRL_ROW_SIZE - 1) / NVMCTRL_ROW_SIZE;
+    if (_claim_count >= WATCH_STORAGE_REGION_MAX_CLAIMS || (size == 0 && rows == 0) ||
+        WATCH_STORAGE_REGION_HEADER_SIZE + (uint32_t)size > WATCH_STORAGE_REGION_ROWS * NVMCTRL_ROW_SIZE ||
+        rows > WATCH_STORAGE_REGION_ROWS - WATCH_STORAGE_REGION_SHARED_ROWS) {
+        printf("storage: can't claim %s (%u bytes, %u rows)\r\n", name, size, rows);
+        return NULL;
+    }
+
+    watch_storage_region_t *claim = &_claims[_claim_count];
+    claim->name = name;
+    claim->tag = tag;
+    claim->size = size;
+    claim->rows = rows;
+
+    if (!(rows ? _claim_rows(claim) : _claim_shared(claim))) {
+        printf("storage: no room for %s (%u bytes, %u rows)\r\n", name, size, rows);
+        return NULL;
+    }
+
+    _claim_count++;
+    return claim;
+}
+
+const watch_storage_region_t *watch_storage_region_claim(const char *name, uint16_t size) {
+    if (size == 0) return NULL;
+    return _claim(name, size, 0);
+}
+
+const watch_storage_region_t *watch_storage_region_claim_rows(const char *name, uint8_t rows) {
+    return _claim(name, 0, rows);
+}
+
+bool watch_storage_region_read(const watch_storage_region_t *region, void *buffer) {
+    uint8_t header[WATCH_STORAGE_REGION_HEADER_SIZE];
+
+    if (region == NULL || WATCH_STORAGE_REGION_IS_RAW(region)) return false;
+    if (!watch_storage_read(region->row, region->offset, header, sizeof(header))) return false;
+    if (!_header_matches(header, region->tag, region->size)) return false;
+
+    // the payload runs on from the header, across rows if the record has rows of its own.
+    uint8_t *out = (uint8_t *)buffer;
+    uint32_t row = region->row;
+    uint32_t offset = region->offset + WATCH_STORAGE_REGION_HEADER_SIZE;
+    uint16_t remaining = region->size;
+    while (remaining) {
+        uint16_t chunk = NVMCTRL_ROW_SIZE - offset;
+        if (chunk > remaining) chunk = remaining;
+        if (!watch_storage_read(row, offset, out, chunk)) return false;
+        out += chunk;
+        remaining -= chunk;
+        row++;
+        offset = 0;
+    }
+
+    return true;
+}
+
+bool watch_storage_region_write(const watch_storage_region_t *region, const void *buffer) {
+    if (region == NULL || WATCH_STORAGE_REGION_IS_RAW(region)) return false;
+
+    const uint8_t *in = (const uint8_t *)buffer;
+    uint8_t rows = region->rows ? region->rows : 1;
+    uint32_t offset = region->offset;
+    uint16_t remaining = region->size;
+
+    for (uint8_t i = 0; i < rows; i++) {
+        uint32_t row = region->row + i;
+
+        // a shared row is rewritten whole, carrying its neighbours' records across the erase.
+        if (region->rows == 0) {
+            if (!watch_storage_read(row, 0, _row_buffer, NVMCTRL_ROW_SIZE)) return false;
+        } else {
+            memset(_row_buffer, 0xff, NVMCTRL_ROW_SIZE);
+        }
+        if (i == 0) {
+            _header_set(_row_buffer + offset, region->tag, region->size);
+            offset += WATCH_STORAGE_REGION_HEADER_SIZE;
+        }
+
+        uint16_t chunk = NVMCTRL_ROW_SIZE - offset;
+        if (chunk > remaining) chunk = remaining;
+        memcpy(_row_buffer + offset, in, chunk);
+        in += chunk;
+        remaining -= chunk;
+        offset = 0;
+
+        if (!_write_row(row)) return false;
+    }
+
+    return true;
+}
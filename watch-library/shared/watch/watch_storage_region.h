@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Diego Perez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_storage_region.h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_storage.h"
+
+/** @addtogroup storage_region Flash Storage Regions
+  * @brief Named records in the top rows of the storage area, for faces and libraries that keep a
+  *        few bytes of state outside the filesystem.
+  * @details The filesystem owns rows 0 to WATCH_STORAGE_REGION_FIRST_ROW - 1. The remaining
+  *          WATCH_STORAGE_REGION_ROWS rows are handed out by name, the way
+  *          movement_claim_backup_register hands out BKUP registers: claim once at setup, then
+  *          read and write through the returned region. Nobody else should touch these rows with
+  *          watch_storage_write or watch_storage_erase.
+  *
+  *          Small records share the bottom WATCH_STORAGE_REGION_SHARED_ROWS rows, which records
+  *          with rows of their own never take, so a face's record still fits however many logs
+  *          were claimed before it. Each one is stored behind a four byte header holding a
+  *          hash of its name and its size, so a read after a firmware update that changed the
+  *          layout comes back empty instead of returning someone else's bytes. Claiming looks
+  *          for the record's header first, so a record keeps its place (and its data) when
+  *          faces are added or reordered. A record too large to share a row gets whole rows of
+  *          its own, allocated from the top down.
+  *
+  *          Two claims can never overlap: a claim that doesn't fit, or whose name collides with
+  *          a different name already claimed, returns NULL. Claiming the same name again returns
+  *          the same region, so it's fine to claim from code that runs more than once.
+  */
+/// @{
+
+#define WATCH_STORAGE_REGION_ROWS 11
+#define WATCH_STORAGE_REGION_SHARED_ROWS 1
+#define WATCH_STORAGE_REGION_FIRST_ROW (NVMCTRL_RWWEE_PAGES / 4 - WATCH_STORAGE_REGION_ROWS)
+#define WATCH_STORAGE_REGION_MAX_CLAIMS 12
+#define WATCH_STORAGE_REGION_HEADER_SIZE 4
+
+typedef struct {
+    const char *name;
+    uint16_t tag;       // hash of name, stored in the record header
+    uint16_t size;      // payload bytes
+    uint8_t row;        // row holding the header
+    uint8_t offset;     // header offset within that row; 0 for records with rows of their own
+    uint8_t rows;       // rows owned outright, or 0 for a record sharing a row
+} watch_storage_region_t;
+
+/// A region from watch_storage_region_claim_rows has no record of its own: size is 0.
+#define WATCH_STORAGE_REGION_IS_RAW(region) ((region)->size == 0)
+
+/** @brief Forgets all claims. Movement calls this once at boot, before any face is set up.
+  */
+void watch_storage_region_init(void);
+
+/** @brief Claims a named record of `size` bytes.
+  * @param name A string that names the record. It must outlive the claim (use a literal).
+  * @param size The payload size in bytes, at most WATCH_STORAGE_REGION_ROWS rows less the header.
+  * @return The region, or NULL if it didn't fit or clashed with an earlier claim.
+  */
+const watch_storage_region_t *watch_storage_region_claim(const char *name, uint16_t size);
+
+/** @brief Claims whole rows for a caller that lays them out itself, such as watch_storage_log.
+  * @details The caller reads and writes the rows directly, and must begin each row it writes with
+  *          the region's tag (two bytes, little-endian) so that a later boot finds the same rows
+  *          again. watch_storage_region_read and watch_storage_region_write refuse these regions.
+  * @param name A string that names the rows. It must outlive the claim (use a literal).
+  * @param rows How many rows, at most WATCH_STORAGE_REGION_ROWS - WATCH_STORAGE_REGION_SHARED_ROWS.
+  * @return The region, or NULL if it didn't fit or clashed with an earlier claim.
+  */
+const watch_storage_region_t *watch_storage_region_claim_rows(const char *name, uint8_t rows);
+
+/** @brief Reads a record.
+  * @param region A region returned by watch_storage_region_claim; NULL is allowed and fails.
+  * @param buffer A buffer of at least region->size bytes.
+  * @return false if the record was never written (or was written by a different layout), in
+  *         which case the buffer is left untouched.
+  */
+bool watch_storage_region_read(const watch_storage_region_t *region, void *buffer);
+
+/** @brief Writes a record, erasing whatever it replaces. Other records in a shared row are kept.
+  * @param region A region returned by watch_storage_region_claim; NULL is allowed and fails.
+  * @param buffer region->size bytes to store.
+  */
+bool watch_storage_region_write(const watch_storage_region_t *region, const void *buffer);
+/// @}
@@ -320,6 +320,33 @@ float watch_utility_thermistor_temperature(uint16_t value, bool highside, float
     return reading;
 }
 
+// watch_utility_thermistor_temperature() for the thermistor_driver.h divider at ADC codes 0, 1024, ...
+// 65536, in hundredths of a degree. The ends are clamped where the curve runs off to infinity.
+static const int16_t thermistor_c100[65] = {
+    -5500, -5479, -4430, -3757, -3247, -2829, -2470, -2152,
+    -1866, -1603, -1359, -1129,  -912,  -705,  -507,  -316,
+     -131,    49,   224,   396,   564,   731,   895,  1057,
+     1218,  1379,  1538,  1698,  1858,  2018,  2179,  2341,
+     2505,  2671,  2838,  3009,  3182,  3359,  3539,  3724,
+     3914,  4110,  4312,  4521,  4738,  4964,  5201,  5450,
+     5712,  5990,  6286,  6604,  6947,  7322,  7733,  8191,
+     8708,  9303, 10002, 10852, 11929, 13392, 15000, 15000,
+    15000
+};
+
+int16_t watch_utility_thermistor_temperature_c100(uint16_t value) {
+    uint8_t segment = value >> 10;
+    int32_t low = thermistor_c100[segment];
+    int32_t high = thermistor_c100[segment + 1];
+    // The table only ever rises, so the product is non-negative and the shift is a plain divide.
+    return (int16_t)(low + (((high - low) * (value & 0x3ff)) >> 10));
+}
+
+int16_t watch_utility_lis2dw_temperature_c100(uint16_t raw) {
+    int16_t sixteenths = (int16_t)raw >> 4;
+    return 2500 + (sixteenths * 25 + (sixteenths < 0 ? -2 : 2)) / 4;
+}
+
 uint32_t watch_utility_offset_timestamp(uint32_t now, int8_t hours, int8_t minutes, int8_t seconds) {
     uint32_t new = now;
     new += hours * 60 * 60;
@@ -170,6 +170,24 @@ uint32_t watch_utility_unix_time_convert_zone(uint32_t timestamp, uint32_t origi
   */
 float watch_utility_thermistor_temperature(uint16_t value, bool highside, float b_coefficient, float nominal_temperature, float nominal_resistance, float series_resistance);
 
+/** @brief Returns a temperature in hundredths of a degree Celsius for the Sensor Watch thermistor.
+  * @param value The raw analog reading from the thermistor pin (0-65535)
+  * @return The temperature in hundredths of a degree, clamped to -5500 to 15000.
+  * @details An integer counterpart to watch_utility_thermistor_temperature for the divider described
+  *          in thermistor_driver.h (10k NTC with B = 3380 on the high side, 10k series resistor),
+  *          from a 65-entry table with linear interpolation. Agrees with the float version within
+  *          0.05 °C from -20 to 60 °C and within 0.65 °C out to 125 °C, without pulling log() and
+  *          soft-float division into the build.
+  */
+int16_t watch_utility_thermistor_temperature_c100(uint16_t value);
+
+/** @brief Returns a temperature in hundredths of a degree Celsius for the LIS2DW12's die sensor.
+  * @param raw OUT_T_L and OUT_T_H as lis2dw_get_temperature() reads them.
+  * @return The temperature in hundredths of a degree, rounded to the nearest.
+  * @details The reading is 12 bits, left-justified, two's complement, at 1/16 °C per LSB from 25 °C.
+  */
+int16_t watch_utility_lis2dw_temperature_c100(uint16_t raw);
+
 /** @brief Offset a timestamp by a given amount
  * @param now Timestamp to offset from
  * @param hours Number of hours to offset
@@ -24,6 +24,7 @@
 #include <limits.h>
 
 #include "watch_rtc.h"
+#include "watch_private.h"
 #include "watch_main_loop.h"
 #include "watch_utility.h"
 
@@ -39,17 +40,8 @@ static uint32_t counter_interval;
 static uint32_t counter;
 static uint32_t reference_timestamp;
 
-#define WATCH_RTC_N_COMP_CB 8
-
-typedef struct {
-    volatile uint32_t counter;
-    volatile watch_cb_t callback;
-    volatile bool enabled;
-} comp_cb_t;
-
 static double time_offset = 0;
 watch_cb_t tick_callbacks[8];
-comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
 
 static uint32_t scheduled_comp_counter;
 
@@ -74,11 +66,7 @@ void _watch_rtc_init(void) {
         tick_callbacks[index] = NULL;
     }
 
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        comp_callbacks[index].counter = 0;
-        comp_callbacks[index].callback = NULL;
-        comp_callbacks[index].enabled = false;
-    }
+    _watch_rtc_comp_init();
 
     scheduled_comp_counter = 0;
     counter = 0;
@@ -219,12 +207,7 @@ static void _watch_process_periodic_callbacks(void) {
 static void _watch_process_comp_callbacks(void) {
     // In hardware the interrupt fires one tick after the matching counter
     if (counter == (scheduled_comp_counter + 1)) {
-        for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-            if (comp_callbacks[index].enabled && scheduled_comp_counter == comp_callbacks[index].counter) {
-                comp_callbacks[index].enabled = false;
-                comp_callbacks[index].callback();
-            }
-        }
+        _watch_rtc_comp_fire_due(scheduled_comp_counter);
 
         watch_rtc_schedule_next_comp();
     }
@@ -261,46 +244,6 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 }
 
-void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-
-    watch_rtc_schedule_next_comp();
-}
-
-void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-}
-
-void watch_rtc_disable_comp_callback(uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].enabled = false;
-
-    watch_rtc_schedule_next_comp();
-}
-
-void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
-    if (index >= WATCH_RTC_N_COMP_CB) {
-        return;
-    }
-
-    comp_callbacks[index].enabled = false;
-}
-
 void watch_rtc_schedule_next_comp(void) {
     rtc_counter_t curr_counter = watch_rtc_get_counter();
     // If there is already a pending comp interrupt for this very tick, let it fire
@@ -312,23 +255,11 @@ void watch_rtc_schedule_next_comp(void) {
     // The soonest we can schedule is the next tick
     curr_counter +=1;
 
-    bool schedule_any = false;
     rtc_counter_t comp_counter;
-    rtc_counter_t min_diff = UINT_MAX;
-
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        // rtc_counter_t diff = 
-        if (comp_callbacks[index].enabled) {
-            rtc_counter_t diff = comp_callbacks[index].counter - curr_counter;
-            if (diff <= min_diff) {
-                min_diff = diff;
-                comp_counter = comp_callbacks[index].counter;
-                schedule_any = true;
-            }
-        }
-    }
 
-    if (schedule_any) {
+    if (_watch_rtc_comp_next_counter(&comp_counter)) {
+        // anything already overdue fires on the next tick.
+        comp_counter = _watch_rtc_comp_clamp(comp_counter, curr_counter, 0);
         scheduled_comp_counter = comp_counter;
     } else {
         scheduled_comp_counter = curr_counter - 2;
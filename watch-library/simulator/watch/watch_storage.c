@@ -1,10 +1,18 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <emscripten.h>
+#include "watch.h"
 #include "watch_storage.h"
+#include "watch_private.h"
 
 uint8_t storage[NVMCTRL_ROW_SIZE * NVMCTRL_RWWEE_PAGES];
 
+// flash controller state for the write queue; see below
+static uint8_t _page_buffer[NVMCTRL_PAGE_SIZE];
+static bool _ready_interrupt_enabled;
+static bool _ready_interrupt_pending;
+
 bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
     // printf("read row %ld offset %ld size %ld\n", row, offset, size);
     memcpy(buffer, storage + row * NVMCTRL_ROW_SIZE + offset, size);
@@ -27,6 +35,56 @@ bool watch_storage_erase(uint32_t row) {
 }
 
 bool watch_storage_sync(void) {
-    // nothing to do here!
+    // simulated commands finish instantly, so the write queue can be run to the end right here.
+    while (watch_storage_is_busy() && _ready_interrupt_enabled) _watch_storage_ready_handler();
+
     return true;
 }
+
+// The flash controller, for the write queue in watch_common_storage.c. Each command takes effect
+// at once; the ready interrupt is delivered from the browser's event loop, like the real one
+// would arrive a few milliseconds later.
+
+static void _deliver_ready_interrupt(void *arg) {
+    (void) arg;
+    _ready_interrupt_pending = false;
+    if (_ready_interrupt_enabled) _watch_storage_ready_handler();
+}
+
+static void _schedule_ready_interrupt(void) {
+    if (_ready_interrupt_pending || !_ready_interrupt_enabled) return;
+    _ready_interrupt_pending = true;
+    emscripten_async_call(_deliver_ready_interrupt, NULL, 0);
+}
+
+void _watch_storage_start_erase(uint32_t row) {
+    watch_storage_erase(row);
+    _schedule_ready_interrupt();
+}
+
+void _watch_storage_start_page_buffer_clear(void) {
+    memset(_page_buffer, 0xff, NVMCTRL_PAGE_SIZE);
+    _schedule_ready_interrupt();
+}
+
+void _watch_storage_fill_page_buffer(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    (void) row;
+    memcpy(_page_buffer + offset % NVMCTRL_PAGE_SIZE, buffer, size);
+}
+
+void _watch_storage_start_page_write(uint32_t row, uint32_t offset) {
+    uint8_t *page = storage + row * NVMCTRL_ROW_SIZE + offset - offset % NVMCTRL_PAGE_SIZE;
+
+    // programming can only clear bits
+    for (uint32_t i = 0; i < NVMCTRL_PAGE_SIZE; i++) page[i] &= _page_buffer[i];
+    _schedule_ready_interrupt();
+}
+
+bool _watch_storage_take_error(void) {
+    return false;
+}
+
+void _watch_storage_enable_ready_interrupt(bool enable) {
+    _ready_interrupt_enabled = enable;
+    _schedule_ready_interrupt();
+}